@@ -92,12 +92,12 @@ void display_7seg_mode(int mode);
 /**
  * @brief Hàm chính cập nhật TẤT CẢ LED 7 đoạn theo mode hiện tại
  *
- * @param Không có tham số (đọc từ biến toàn cục)
+ * @param view: Bản chụp của FSM (traffic_snapshot), không đọc biến toàn cục
  *
  * Logic hoạt động:
  *
  * ┌─────────────────────────────────────────────────────────────┐
- * │ if (current_mode == MODE_1_NORMAL)                          │
+ * │ if (view->mode == MODE_1_NORMAL)                            │
  * │    ├─ Hiển thị TRÁI: counter_road1 (thời gian đường 1)     │
  * │    ├─ Hiển thị PHẢI: counter_road2 (thời gian đường 2)     │
  * │    └─ Hiển thị MODE: 1                                      │
@@ -109,8 +109,8 @@ void display_7seg_mode(int mode);
  * └─────────────────────────────────────────────────────────────┘
  *
  * Cơ chế:
- * - Được gọi trong traffic_run() mỗi 10ms
- * - Tự động chọn dữ liệu hiển thị dựa trên current_mode
+ * - Được gọi bởi stage Display ngay sau task FSM (cùng tick)
+ * - Tự động chọn dữ liệu hiển thị dựa trên view->mode
  * - Đảm bảo thông tin hiển thị luôn đồng bộ với trạng thái hệ thống
  *
  * Ví dụ hiển thị:
@@ -129,7 +129,7 @@ void display_7seg_mode(int mode);
  * - Hàm này CHỈ CẬP NHẬT hiển thị, không thay đổi giá trị counter
  * - Việc giảm counter được thực hiện trong fsm_normal_mode()
  */
-void update_7seg_display(void);
+void update_7seg_display(const traffic_view_t *view);
 
 #endif /* INC_7SEGMENT_DISPLAY_H_ */
 
@@ -151,7 +151,9 @@ void update_7seg_display(void);
  *    // Trong timer interrupt mỗi 10ms:
  *    void HAL_TIM_PeriodElapsedCallback(TIM_HandleTypeDef *htim) {
  *        if(htim->Instance == TIM2) {
- *            traffic_run();  // Đã bao gồm update_7seg_display()
+ *            traffic_run();
+ *            traffic_snapshot(&view);
+ *            update_7seg_display(&view);
  *        }
  *    }
  *    ```
@@ -33,13 +33,15 @@
  */
 
 /* ==================== TASK TIMING CONSTANTS (in milliseconds) ==================== */
-#define TASK_BUTTON_PERIOD_MS       10      // Quét nút nhấn mỗi 10ms
+#define TASK_BUTTON_PERIOD_MS       BUTTON_SCAN_MS  // Quét nút nhấn mỗi 5ms (làn nhanh) / 10ms
 #define TASK_FSM_PERIOD_MS          10      // FSM đèn giao thông mỗi 10ms
-#define TASK_DISPLAY_PERIOD_MS      50      // Cập nhật hiển thị mỗi 50ms
+#define TASK_DISPLAY_PERIOD_MS      50      // Cập nhật hiển thị mỗi 50ms (SCH_PIPELINE = 0)
 
 /* ==================== TASK TIMING IN TICKS ==================== */
 // Assuming TIMER_TICK_MS = 10ms
-#define TASK_BUTTON_PERIOD          (TASK_BUTTON_PERIOD_MS / TIMER_TICK_MS)   // = 1 tick
+// (Button_Scan chạy ở làn nhanh SysTick 1ms → dùng thẳng TASK_BUTTON_PERIOD_MS;
+//  SCH_FAST_LANE = 0 → chạy ở làn tick với TASK_BUTTON_PERIOD)
+#define TASK_BUTTON_PERIOD          (TASK_BUTTON_PERIOD_MS / TIMER_TICK_MS)   // = 1 tick (SCH_FAST_LANE = 0)
 #define TASK_FSM_PERIOD             (TASK_FSM_PERIOD_MS / TIMER_TICK_MS)      // = 1 tick
 #define TASK_DISPLAY_PERIOD         (TASK_DISPLAY_PERIOD_MS / TIMER_TICK_MS)  // = 5 ticks
 
@@ -48,21 +50,39 @@
 
 /**
  * @brief Task quét nút nhấn - BẮT BUỘC
- * @note  Chạy mỗi 10ms để phát hiện nhấn chính xác
- * @usage SCH_Add_Task(Task_Button_Scan, 0, TASK_BUTTON_PERIOD);
+ * @note  Chạy mỗi 5ms ở làn nhanh (SysTick 1ms) → nút được nhận sau 15ms
+ *        (SCH_FAST_LANE = 0: mỗi tick 10ms ở làn tick → sau 30ms)
+ * @usage SCH_Add_Lane_Task(SCH_LANE_FAST, Task_Button_Scan, 0, TASK_BUTTON_PERIOD_MS);
+ *        SCH_Add_Task(Task_Button_Scan, 0, TASK_BUTTON_PERIOD);   // SCH_FAST_LANE = 0
  */
 void Task_Button_Scan(void);
 
+/**
+ * Bản chụp trạng thái FSM, ghi sau mỗi lần Task_Traffic_FSM chạy
+ * (OUT của task FSM, IN của stage Display)
+ */
+extern traffic_view_t traffic_view;
+
 /**
  * @brief Task điều khiển FSM đèn giao thông - BẮT BUỘC
- * @note  Chạy mỗi 10ms để cập nhật trạng thái
+ * @note  Chạy mỗi 10ms để cập nhật trạng thái, rồi chụp traffic_view
  * @usage SCH_Add_Task(Task_Traffic_FSM, 0, TASK_FSM_PERIOD);
  */
 void Task_Traffic_FSM(void);
 
 /**
- * @brief Task cập nhật hiển thị LED và 7-segment - BẮT BUỘC
- * @note  Có thể chạy chậm hơn (50ms) để tiết kiệm CPU
+ * @brief Stage cập nhật hiển thị LED và 7-segment - BẮT BUỘC
+ * @param IN: Bản chụp của FSM (const traffic_view_t *), OUT: không dùng
+ * @note  Chạy ngay sau FSM trong cùng tick (SCH_PIPELINE), chỉ vẽ
+ *        khi bản chụp khác lần vẽ trước
+ * @usage SCH_Set_Task_Output(fsm_id, &traffic_view);
+ *        SCH_Add_Stage(Stage_Update_Display, fsm_id, 0);
+ */
+void Stage_Update_Display(const void *IN, void *OUT);
+
+/**
+ * @brief Task cập nhật hiển thị khi không có pipeline (SCH_PIPELINE = 0)
+ * @note  Vẽ traffic_view mỗi 50ms
  * @usage SCH_Add_Task(Task_Update_Display, 0, TASK_DISPLAY_PERIOD);
  */
 void Task_Update_Display(void);
@@ -8,11 +8,26 @@
 #define INC_BUTTON_H_
 
 #include "main.h"
+#include "scheduler.h"  // SCH_FAST_LANE, TIMER_TICK_MS
 
 // Định nghĩa trạng thái nút (Pull-up mode: nút active-low)
 #define NORMAL_STATE  SET    // Nút không nhấn (GPIO = 1)
 #define PRESSED_STATE RESET  // Nút được nhấn (GPIO = 0)
 
+// Chu kỳ gọi getKeyInput() (ms) - task Button_Scan chạy ở làn nhanh 1ms
+// của scheduler (SCH_LANE_FAST). Chống dội = 3 lần đọc giống nhau
+// = 15ms, nên không đặt dưới ~3ms (nút dội 5-10ms)
+// Không có làn nhanh (SCH_FAST_LANE = 0): quét mỗi tick 10ms (chống dội 30ms)
+#if SCH_FAST_LANE
+#define BUTTON_SCAN_MS          5
+#else
+#define BUTTON_SCAN_MS          TIMER_TICK_MS
+#endif
+
+// Nhấn giữ và thời gian bỏ qua nút lúc khởi động, tính theo số lần quét
+#define BUTTON_LONG_PRESS_COUNT (1000 / BUTTON_SCAN_MS)     // 1 giây
+#define BUTTON_STARTUP_COUNT    (100 / BUTTON_SCAN_MS)      // 100ms
+
 // Biến cờ cho 3 nút [0]=Button1, [1]=Button2, [2]=Button3
 extern int button_flag[3];        // Cờ nhấn thường
 extern int button_long_pressed[3]; // Cờ nhấn giữ (>500ms)
@@ -27,12 +42,12 @@ int isButton1LongPressed(void);
 int isButton2LongPressed(void);
 int isButton3LongPressed(void);
 
-// Hàm xử lý nút - GỌI TRONG TIMER INTERRUPT MỖI 1ms
+// Hàm xử lý nút - GỌI MỖI BUTTON_SCAN_MS
 void getKeyInput(void);
 
 /*
  * CÁCH DÙNG:
- * 1. Gọi getKeyInput() trong Timer Interrupt mỗi 1ms
+ * 1. Gọi getKeyInput() mỗi BUTTON_SCAN_MS (task Button_Scan)
  * 2. Trong main loop:
  *    if (isButton1Pressed()) { ... }      // Nhấn thường
  *    if (isButton1LongPressed()) { ... }  // Nhấn giữ
@@ -24,12 +24,19 @@
 void traffic_init(void);
 
 /**
- * @brief Hàm chính của FSM - gọi trong timer interrupt (mỗi 10ms)
- * @details Xử lý logic theo mode hiện tại và cập nhật hiển thị
+ * @brief Hàm chính của FSM - task Traffic_FSM (mỗi 10ms)
+ * @details Xử lý logic theo mode hiện tại (không cập nhật hiển thị)
  * @note Tần suất: 100Hz (100 lần/giây)
  */
 void traffic_run(void);
 
+/**
+ * @brief Chụp trạng thái FSM cho phần hiển thị
+ * @param view: Bản chụp được ghi (mode, trạng thái, bộ đếm, cờ nhấp nháy)
+ * @note Gọi ngay sau traffic_run()
+ */
+void traffic_snapshot(traffic_view_t *view);
+
 /**
  * @brief Cập nhật trạng thái button (edge detection)
  * @details Đọc trạng thái nút nhấn và phát hiện sự kiện "vừa nhấn"
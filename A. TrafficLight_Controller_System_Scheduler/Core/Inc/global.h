@@ -91,4 +91,21 @@ extern int flagYellow[2];  // Trạng thái đèn vàng của 2 đường
 extern enum BUTTON_STATE prevState[3];  // Trạng thái trước đó của 3 nút
 extern enum BUTTON_STATE currState[3];  // Trạng thái hiện tại của 3 nút
 
+/* ==================================================================
+ * BẢN CHỤP TRẠNG THÁI (FSM → HIỂN THỊ)
+ * ================================================================== */
+
+// Những gì phần hiển thị cần, chụp lại sau mỗi bước FSM (traffic_snapshot)
+// → hàm hiển thị chỉ đọc bản chụp, không đọc các biến toàn cục ở trên
+typedef struct {
+    enum MODE mode;               // Chế độ đang hoạt động
+    enum TRAFFIC_STATE state;     // Trạng thái đèn (MODE_1_NORMAL)
+    int counter_road1;            // Đếm ngược đường 1 (MODE_1_NORMAL)
+    int counter_road2;            // Đếm ngược đường 2 (MODE_1_NORMAL)
+    int temp_duration;            // Giá trị đang chỉnh (MODE 2/3/4)
+    int flagRed[2];               // Cờ nhấp nháy (MODE 2/3/4)
+    int flagGreen[2];
+    int flagYellow[2];
+} traffic_view_t;
+
 #endif /* INC_GLOBAL_H_ */
@@ -55,8 +55,9 @@ void displayLED_GREEN(int IS_ON, int index);
 void handle_led_blinking(int led_type);
 
 /**
- * @brief Cập nhật hiển thị LED theo mode hiện tại
+ * @brief Cập nhật hiển thị LED theo bản chụp của FSM
+ * @param view: Bản chụp (traffic_snapshot)
  */
-void update_led_display(void);
+void update_led_display(const traffic_view_t *view);
 
 #endif /* INC_LED_DISPLAY_H_ */
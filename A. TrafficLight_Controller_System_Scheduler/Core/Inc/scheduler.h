@@ -9,10 +9,455 @@
 #include "main.h"
 
 /* ==================== CONFIGURATION ==================== */
-#define SCH_MAX_TASKS           40
+#ifndef SCH_MAX_TASKS
+#define SCH_MAX_TASKS           40      // Slot table size (< 65535)
+#endif
 #define NO_TASK_ID              0
 #define TIMER_TICK_MS           10      // 10ms timer tick
 
+/* ==================== BACKEND SELECTION ==================== */
+/*
+ * All backends share the slot table (SCH_tasks_G[], or the arrays of
+ * SCH_COMPACT) and the handles returned by SCH_Add_Task (a slot never
+ * moves while its task exists).
+ * SCH_BACKEND_SORTED_ARRAY: run queue SCH_order_G[] kept sorted by Delay.
+ *   Add/Delete are O(n) (insertion shift), Update is O(1).
+ * SCH_BACKEND_TIMING_WHEEL: hierarchical timing wheel (scheduler_wheel.c).
+ *   Add/Delete/expire are O(1), Update is O(1).
+ * With SCH_ADMISSION = 1, every backend's Add and Reschedule also pay the
+ * admission check, O(hyperperiod x tasks).
+ * SCH_BACKEND_CYCLIC: cyclic executive (scheduler_cyclic.c). The schedule
+ *   over one hyperperiod (LCM of the periods) is precomputed into a frame
+ *   table; each tick runs the list of its frame. Update is O(1), a tick is
+ *   O(tasks in the frame), Add/Delete/Reschedule rebuild the table.
+ */
+#define SCH_BACKEND_SORTED_ARRAY    0
+#define SCH_BACKEND_TIMING_WHEEL    1
+#define SCH_BACKEND_CYCLIC          2
+
+#ifndef SCH_BACKEND
+#define SCH_BACKEND             SCH_BACKEND_SORTED_ARRAY
+#endif
+
+/* Timing wheel geometry: SCH_WHEEL_LEVELS levels of 2^SCH_WHEEL_BITS slots.
+ * Default 4 x 64 covers 2^24 ticks (~46 hours at 10ms) without re-cascading. */
+#define SCH_WHEEL_BITS          6
+#define SCH_WHEEL_LEVELS        4
+
+/* Cyclic executive frame table: hyperperiod of at most SCH_CYCLIC_MAX_FRAMES
+ * ticks and SCH_CYCLIC_MAX_ENTRIES task releases per hyperperiod.
+ * App (periods 1, 1, 5): 5 frames, 11 entries. One-shot tasks, periods
+ * above SCH_CYCLIC_MAX_FRAMES and tasks that would overflow the table
+ * (a 1 s task next to the 10 ms ones: 221 entries) stay outside it on a
+ * side list; a tick only walks that list once its earliest due tick is
+ * reached, so idle ticks cost O(1) whatever the task count. */
+#ifndef SCH_CYCLIC_MAX_FRAMES
+#define SCH_CYCLIC_MAX_FRAMES   100
+#endif
+#ifndef SCH_CYCLIC_MAX_ENTRIES
+#define SCH_CYCLIC_MAX_ENTRIES  200
+#endif
+
+/* ==================== TASK STORAGE ==================== */
+/*
+ * SCH_COMPACT = 0: one sTask per slot in SCH_tasks_G[] (20 bytes with
+ *   padding), plus the MARKING[] byte of the sorted backend.
+ * SCH_COMPACT = 1: the slot table is split into arrays. The fields that
+ *   SCH_Update and the dispatcher touch on every tick (Delay, RunMe) sit
+ *   in two dense arrays, the function pointer, Period and handle
+ *   generation in separate cold arrays. Delay and Period use the
+ *   smallest type that holds SCH_MAX_PERIOD, and the sorted backend keeps
+ *   the delay of the queue head instead of MARKING[].
+ *   RAM per slot on target: 21 -> 11 bytes with SCH_MAX_PERIOD <= 65535
+ *   (9 bytes <= 255); 40 slots: 840 -> 464 bytes including the fixed
+ *   part (head delay, SCH_Get_Task copy). Host/ "make layout" compares
+ *   the run time of both layouts.
+ *   A DELAY or PERIOD above SCH_MAX_PERIOD is rejected
+ *   (ERROR_SCH_PERIOD_TOO_LONG). The wheel and cyclic backends, and
+ *   SCH_TIMEBASE_ABSOLUTE, keep an absolute tick in Delay, so only
+ *   Period is narrowed there.
+ */
+#ifndef SCH_COMPACT
+#define SCH_COMPACT             1
+#endif
+
+// Longest DELAY / PERIOD in ticks when SCH_COMPACT = 1 (65535 = 10.9 min)
+#ifndef SCH_MAX_PERIOD
+#define SCH_MAX_PERIOD          65535uL
+#endif
+
+/* ==================== TIMEBASE (SORTED ARRAY) ==================== */
+/*
+ * What Delay holds in the sorted-array backend:
+ *   SCH_TIMEBASE_RELATIVE: ticks left, counted down. SCH_Update only
+ *     decrements the head; when the head is due, SCH_Dispatch_Tasks walks
+ *     the whole queue to take elapsed_time off every Delay (MARKING /
+ *     head delay picks the tasks due together) - O(n) per dispatch.
+ *   SCH_TIMEBASE_ABSOLUTE: the tick at which the task is due, against
+ *     the tick count. Nothing is counted down: SCH_Update compares the head
+ *     with the tick, SCH_Dispatch_Tasks pops due tasks off the head and
+ *     never looks at the rest. No elapsed_time, no MARKING. Comparisons
+ *     use signed differences, so the 32-bit tick may wrap (any due tick
+ *     must stay within 2^31 ticks of now). Delay is 32-bit even with
+ *     SCH_COMPACT (+2 bytes per slot at SCH_MAX_PERIOD <= 65535).
+ * The wheel and cyclic backends always use absolute ticks.
+ * Default: ABSOLUTE with SCH_PRIORITY (the class latency bound needs it,
+ * see PRIORITY CLASSES), RELATIVE otherwise.
+ */
+#define SCH_TIMEBASE_RELATIVE       0
+#define SCH_TIMEBASE_ABSOLUTE       1
+
+#ifndef SCH_TIMEBASE
+#define SCH_TIMEBASE            (SCH_PRIORITY ? SCH_TIMEBASE_ABSOLUTE : SCH_TIMEBASE_RELATIVE)
+#endif
+
+/* ==================== TICKLESS IDLE ==================== */
+/*
+ * SCH_TICKLESS = 1: SCH_Go_To_Sleep() stretches the TIM2 period up to the
+ *   next deadline and sleeps through the idle ticks - one wake-up per
+ *   deadline instead of one per tick. The skipped ticks are credited to
+ *   the scheduler on wake-up (elapsed_time / wheel tick count).
+ * SCH_TICKLESS = 0: SCH_Go_To_Sleep() sleeps until the next tick.
+ * SCH_HOST_SIM: build without hardware; SCH_Go_To_Sleep() advances a
+ *   simulated clock instead, counting wake-ups and idle ticks the same way.
+ */
+#ifndef SCH_TICKLESS
+#define SCH_TICKLESS            1
+#endif
+
+// Longest single sleep in ticks. TIM2 is 16-bit, so (Period + 1) * ticks
+// must fit in 65536 counts (6553 ticks with the default 10 counts/tick).
+#ifndef SCH_TICKLESS_MAX_TICKS
+#define SCH_TICKLESS_MAX_TICKS  6000
+#endif
+
+/* ==================== PROFILER ==================== */
+/*
+ * SCH_PROFILE = 1: every task call made by SCH_Dispatch_Tasks() is timed.
+ *   Target: Cortex-M3 DWT cycle counter (CPU cycles, 8 per us at 8 MHz).
+ *   Host (SCH_HOST_SIM): monotonic clock, in nanoseconds.
+ */
+#ifndef SCH_PROFILE
+#define SCH_PROFILE             1
+#endif
+
+/* ==================== CPU UTILIZATION ==================== */
+/*
+ * SCH_UTIL = 1: the time spent in tasks is summed per tick and per second
+ * (same clock as the profiler). SCH_Get_Utilization() reports it against
+ * the wall time of the ticks (TIMER_TICK_MS each, so sleeping counts as
+ * idle even though the cycle counter stops) over the last 1 s, 10 s and
+ * 60 s, plus the busiest single tick. The dispatcher's own time between
+ * tasks counts as idle. RAM: 60 seconds of history, 480 bytes.
+ */
+#ifndef SCH_UTIL
+#define SCH_UTIL                1
+#endif
+
+/* ==================== OVERRUN HANDLING ==================== */
+/*
+ * What SCH_Dispatch_Tasks() does with a periodic task that starts one or
+ * more whole periods late (missed releases):
+ *   SCH_CATCHUP_COALESCE: run once for all of them (default)
+ *   SCH_CATCHUP_REPLAY:   run once per missed release, back-to-back
+ *   SCH_CATCHUP_SKIP:     drop the late run, wait for the next release
+ * Late starts, missed periods and RunMe saturation are counted per task
+ * whatever the policy (SCH_Get_Task_Misses).
+ */
+#define SCH_CATCHUP_COALESCE        0
+#define SCH_CATCHUP_REPLAY          1
+#define SCH_CATCHUP_SKIP            2
+
+#ifndef SCH_CATCHUP_POLICY
+#define SCH_CATCHUP_POLICY      SCH_CATCHUP_COALESCE
+#endif
+
+/*
+ * Where a periodic task's next release is counted from:
+ *   SCH_REARM_FROM_RELEASE: its nominal release tick + Period, so a late
+ *                           dispatch never shifts the task's phase and a
+ *                           1 s task stays locked to wall time (default)
+ *   SCH_REARM_FROM_RUN:     the tick it actually ran + Period (the old
+ *                           behaviour: every late start is added for good)
+ * When the next nominal release is already past, the first one after the
+ * current tick is used (the skipped ones are Missed_Periods). The slip of
+ * each task's release grid is reported as Phase_Error. The cyclic backend
+ * always rearms from the release (its frame table depends on it).
+ */
+#define SCH_REARM_FROM_RUN          0
+#define SCH_REARM_FROM_RELEASE      1
+
+#ifndef SCH_REARM
+#define SCH_REARM               SCH_REARM_FROM_RELEASE
+#endif
+
+// SCH_Report_Status() clears Error_code_G after this many ticks without
+// a new error (6000 x 10ms = 1 minute)
+#ifndef SCH_ERROR_HOLD_TICKS
+#define SCH_ERROR_HOLD_TICKS    6000
+#endif
+
+/* ==================== PRIORITY CLASSES ==================== */
+/*
+ * SCH_PRIORITY = 1: every task has a class (SCH_Set_Task_Class, default
+ * SCH_CLASS_NORMAL). When several tasks are ready, SCH_Dispatch_Tasks()
+ * runs the highest class first (same class: the usual order) and looks
+ * for new releases again before each task, so a critical task released
+ * while another task runs only waits for that one task (its WCET), not
+ * for the rest of the ready list. Release-to-start latency is measured
+ * per class (SCH_Get_Class_Latency).
+ * The bound needs releases to be visible in the middle of a dispatch:
+ *   timing wheel, SCH_TIMEBASE_ABSOLUTE: yes - the sorted backend
+ *     therefore defaults to SCH_TIMEBASE_ABSOLUTE when SCH_PRIORITY = 1
+ *   cyclic executive: frames are filled in class order; a release seen
+ *     in the next frame waits for the current frame to finish
+ *   SCH_TIMEBASE_RELATIVE (only if set explicitly): tasks ready together
+ *     run by class; a release during a dispatch pass is seen at the next
+ *     pass, so the bound does not hold
+ * Fast lane tasks run before every class. RAM: 1 byte per slot + 20
+ * bytes per class.
+ */
+#ifndef SCH_PRIORITY
+#define SCH_PRIORITY            1
+#endif
+
+/* ==================== OVERLOAD SHEDDING ==================== */
+/*
+ * SCH_SHED = 1 (default when SCH_PRIORITY and SCH_UTIL are on): when the
+ * time spent in tasks stays above SCH_SHED_HIGH_PCT % of a tick for
+ * SCH_SHED_TRIGGER_TICKS ticks in a row, non-critical work is shed one
+ * level at a time:
+ *   SCH_SHED_STRETCH: BACKGROUND tasks only run every SCH_SHED_FACTOR-th
+ *                     release (Display 5 → 10 ticks)
+ *   SCH_SHED_PAUSE:   BACKGROUND tasks are paused, NORMAL tasks stretched
+ * After SCH_SHED_RECOVER_TICKS ticks in a row below SCH_SHED_LOW_PCT %
+ * (sleeping ticks count) the level drops by one, and the old periods
+ * come back on the next release. CRITICAL tasks and event tasks always
+ * keep their cadence. Pipeline stages classed below their task are shed
+ * the same way, per run of the task. A shed release is dropped before the task runs:
+ * the release grid is kept and the drop is not a deadline miss.
+ * SCH_Get_Shed_Stats() reports the level and the releases shed.
+ */
+#ifndef SCH_SHED
+#define SCH_SHED                (SCH_PRIORITY && SCH_UTIL)
+#endif
+
+#ifndef SCH_SHED_HIGH_PCT
+#define SCH_SHED_HIGH_PCT       80
+#endif
+
+#ifndef SCH_SHED_LOW_PCT
+#define SCH_SHED_LOW_PCT        50
+#endif
+
+#ifndef SCH_SHED_TRIGGER_TICKS
+#define SCH_SHED_TRIGGER_TICKS  3
+#endif
+
+#ifndef SCH_SHED_RECOVER_TICKS
+#define SCH_SHED_RECOVER_TICKS  100     // 1 s
+#endif
+
+// Period multiplier of a stretched task
+#ifndef SCH_SHED_FACTOR
+#define SCH_SHED_FACTOR         2
+#endif
+
+#if SCH_SHED && !(SCH_PRIORITY && SCH_UTIL)
+#error "SCH_SHED needs SCH_PRIORITY = 1 and SCH_UTIL = 1"
+#endif
+#if SCH_SHED && (SCH_SHED_FACTOR < 2 || SCH_SHED_FACTOR > 255)
+#error "SCH_SHED_FACTOR must be 2..255"
+#endif
+
+/* ==================== LOAD LEVELLING ==================== */
+/*
+ * SCH_STAGGER = 1: SCH_Add_Task_Staggered() picks the first release of a
+ * periodic task so that it lands on the least loaded ticks, instead of
+ * every task with the same period running in the same tick.
+ * Load of a tick = sum of the costs of the tasks due in it, over the next
+ * SCH_STAGGER_WINDOW ticks. Cost of a task = mean run time measured by the
+ * profiler if it has run (SCH_PROFILE = 1), else the declared cost, else
+ * SCH_STAGGER_DEFAULT_COST. Units are those of the profiler (CPU cycles on
+ * target, ns on host).
+ */
+#ifndef SCH_STAGGER
+#define SCH_STAGGER             0
+#endif
+
+// Ticks covered by the load profile; a multiple of every period in use
+// gives an exact profile (60 = 1, 2, 3, 4, 5, 6, 10, 12, 15, 20, 30, 60)
+#ifndef SCH_STAGGER_WINDOW
+#define SCH_STAGGER_WINDOW      60
+#endif
+
+// Cost of a task with no measured or declared cost
+#ifndef SCH_STAGGER_DEFAULT_COST
+#define SCH_STAGGER_DEFAULT_COST    1
+#endif
+
+/* ==================== ADMISSION CONTROL ==================== */
+/*
+ * Opt-in (default 0). SCH_ADMISSION = 1: SCH_Add_Task() (and every add
+ * built on it) first
+ * checks that the tick lane stays schedulable with a new periodic task,
+ * and rejects it with ERROR_SCH_NOT_SCHEDULABLE otherwise:
+ *   1. Utilization: sum of WCET / Period <= SCH_ADMIT_UTIL_PCT % of the CPU
+ *   2. Worst tick: the tasks released in the same tick, for every tick of
+ *      the hyperperiod (LCM of the periods, from their real release
+ *      ticks), fit in SCH_ADMIT_TICK_PCT % of one tick. A hyperperiod
+ *      above SCH_ADMIT_MAX_HYPER ticks is not walked: all tasks are then
+ *      counted in the same tick.
+ * WCET of a task = its declared cost (SCH_Add_Task_Wcet,
+ * SCH_Set_Task_Cost), else SCH_ADMIT_DEFAULT_WCET_US. With
+ * SCH_ADMIT_PROFILED = 1 (and SCH_PROFILE) the profiled Max_Cycles is
+ * taken when larger; it is wall-clock time including preempting ISRs, so
+ * one interrupt burst raises the WCET for good and later adds /
+ * reschedules may be rejected. Event tasks may run in any tick: their WCET
+ * is added to every tick and left out of the utilization. One-shot tasks
+ * are always accepted and not counted (transient work), nor are fast lane
+ * tasks and ISRs - keep the percentages below 100 for them.
+ * SCH_Reschedule_Task() to a non-zero PERIOD runs the same check with the
+ * task's entry replaced (so a one-shot cannot be made periodic behind the
+ * check's back); on failure the task is left unchanged.
+ * SCH_Init_Static() keeps every row of the table (it is fixed at compile
+ * time) but sets ERROR_SCH_NOT_SCHEDULABLE if the table fails the check.
+ * Cost: O(hyperperiod x tasks) per add / reschedule, at most
+ * SCH_ADMIT_MAX_HYPER x n (tens of ms at 8 MHz, also when a task
+ * reschedules itself inside the dispatcher), with 8 bytes of stack per
+ * task - size the stack for it. The O(1) add / reschedule of the
+ * backends only holds with SCH_ADMISSION = 0.
+ */
+#ifndef SCH_ADMISSION
+#define SCH_ADMISSION           0
+#endif
+
+#ifndef SCH_ADMIT_UTIL_PCT
+#define SCH_ADMIT_UTIL_PCT      70
+#endif
+
+#ifndef SCH_ADMIT_TICK_PCT
+#define SCH_ADMIT_TICK_PCT      80
+#endif
+
+#ifndef SCH_ADMIT_MAX_HYPER
+#define SCH_ADMIT_MAX_HYPER     600     // 6 s
+#endif
+
+// Also charge the profiled Max_Cycles as WCET (see above)
+#ifndef SCH_ADMIT_PROFILED
+#define SCH_ADMIT_PROFILED      0
+#endif
+
+// WCET of a task with no declared run time
+#ifndef SCH_ADMIT_DEFAULT_WCET_US
+#define SCH_ADMIT_DEFAULT_WCET_US   500
+#endif
+
+/* ==================== EVENT TASKS ==================== */
+/*
+ * Tasks added with SCH_Add_Event_Task() run when signalled (SCH_Signal /
+ * SCH_Signal_From_ISR) instead of every period, on the next tick.
+ * Signals that arrive before the task runs are merged into one run.
+ * With a TIMEOUT the task also runs after TIMEOUT ticks without a signal.
+ * Without one it stays queued but is only looked at every
+ * SCH_EVENT_PARK_TICKS ticks (and skipped), so an idle event task
+ * costs no dispatch work and does not stop the MCU from sleeping.
+ */
+#ifndef SCH_EVENT_PARK_TICKS
+#define SCH_EVENT_PARK_TICKS    60000   // 10 minutes
+#endif
+
+/* ==================== ISR COMMAND RING ==================== */
+/*
+ * Interrupt handlers must not call SCH_Add_Task / SCH_Delete_Task (they
+ * change the queue that SCH_Dispatch_Tasks and SCH_Update work on).
+ * They post to a single-producer/single-consumer ring instead
+ * (SCH_Add_Task_From_ISR / SCH_Delete_Task_From_ISR), drained at the start
+ * of every SCH_Dispatch_Tasks(). Posting is wait-free and never disables
+ * interrupts. Single producer: all ISRs that post must share one NVIC
+ * preemption priority, so that they cannot interrupt each other.
+ */
+// Number of commands the ring holds (power of 2)
+#ifndef SCH_CMD_RING_SIZE
+#define SCH_CMD_RING_SIZE       8
+#endif
+
+/* ==================== FAST LANE ==================== */
+/*
+ * SCH_FAST_LANE = 1: a second, small lane clocked by SysTick (1 ms,
+ * SCH_Fast_Update() in SysTick_Handler) for work that needs a finer grid
+ * than TIMER_TICK_MS, such as input sampling. Tasks go in with
+ * SCH_Add_Lane_Task(SCH_LANE_FAST, ...), DELAY and PERIOD in ms (at most
+ * 65535), and their handles work with SCH_Delete_Task and
+ * SCH_Reschedule_Task like any other. The lane has its own table of
+ * SCH_FAST_MAX_TASKS entries, counted down in the ISR; its released tasks
+ * run at the start of every SCH_Dispatch_Tasks(), before the tick lane.
+ * Releases that pile up while dispatch is busy are merged into one run.
+ * Fast tasks are not profiled, and not in the utilization or deadline
+ * statistics. While any fast task exists, SCH_Go_To_Sleep() keeps SysTick
+ * running and does not stretch TIM2. RAM: 10 bytes per entry.
+ */
+#ifndef SCH_FAST_LANE
+#define SCH_FAST_LANE           1
+#endif
+
+#ifndef SCH_FAST_MAX_TASKS
+#define SCH_FAST_MAX_TASKS      4
+#endif
+
+/* ==================== TASK PIPELINES ==================== */
+/*
+ * SCH_PIPELINE = 1: a tick lane task can be followed by stages
+ * (SCH_Add_Stage). A stage has no period of its own: every time its
+ * predecessor (the task, or an earlier stage) runs, the stage runs right
+ * after it in the same dispatch, whatever the backend or queue order.
+ * Stages of one task run by depth (all stages right after the task,
+ * then the stages after those, ...), so each one sees the work of its
+ * predecessor from the same tick.
+ * Data is handed down as a snapshot: a stage is called with IN = OUT of
+ * its predecessor (the task's OUT is set with SCH_Set_Task_Output) and
+ * fills its own OUT for the stages after it.
+ * Stages are timed as part of their task (its profile and WCET cover the
+ * whole chain). With SCH_PRIORITY a stage handle also takes
+ * SCH_Set_Task_Class(): a stage classed below its task is shed on its own
+ * like a task of that class (and the stages after it skip that run), so
+ * a BACKGROUND display stage behind a CRITICAL FSM can still be shed.
+ * Stages default to SCH_CLASS_CRITICAL: they run whenever the task does.
+ * Deleting a stage also deletes the stages after it; stages of a deleted
+ * task are dropped. The lane has its own table of SCH_PIPE_MAX_STAGES
+ * entries. RAM: 16 bytes per stage (20 with SCH_PRIORITY) + 8 bytes per
+ * task output.
+ */
+#ifndef SCH_PIPELINE
+#define SCH_PIPELINE            1
+#endif
+
+// Stages of all pipelines together (at most 32)
+#ifndef SCH_PIPE_MAX_STAGES
+#define SCH_PIPE_MAX_STAGES     4
+#endif
+
+/* ==================== TRACE RECORDER ==================== */
+/*
+ * SCH_TRACE = 1: SCH_Update, SCH_Dispatch_Tasks, every task run, ISRs
+ * marked with SCH_TRACE_ISR_ENTER/EXIT and every change of Error_code_G
+ * append an 8-byte record to the RAM ring SCH_trace_G (oldest records are
+ * overwritten). Each record costs a cycle counter read and two stores
+ * with interrupts masked.
+ * Dump SCH_trace_G from the debugger (gdb: dump binary value trace.bin
+ * SCH_trace_G) and convert it with Host/sch_trace (Chrome trace JSON,
+ * open in chrome://tracing or ui.perfetto.dev).
+ */
+#ifndef SCH_TRACE
+#define SCH_TRACE               1
+#endif
+
+// Records in the ring (power of 2); 64 x 8 bytes = 512 bytes of RAM
+#ifndef SCH_TRACE_SIZE
+#define SCH_TRACE_SIZE          64
+#endif
+
 /* ==================== ERROR CODES ==================== */
 #define ERROR_SCH_TOO_MANY_TASKS                    1
 #define ERROR_SCH_CANNOT_DELETE_TASK                2
@@ -21,26 +466,276 @@
 #define ERROR_SCH_ONE_OR_MORE_SLAVES_DID_NOT_START  5
 #define ERROR_SCH_LOST_SLAVE                        6
 #define ERROR_SCH_CAN_BUS_ERROR                     7
+#define ERROR_SCH_MISSED_DEADLINE                   8   // A task started >= 1 period late
+#define ERROR_SCH_RUNME_SATURATED                   9   // RunMe reached 255, releases lost
+#define ERROR_SCH_CMD_RING_FULL                     10  // ISR command dropped
+#define ERROR_SCH_FRAME_TABLE_FULL                  11  // Unused (cyclic: tasks that do not fit stay off the table)
+#define ERROR_SCH_PERIOD_TOO_LONG                   12  // DELAY / PERIOD above SCH_MAX_PERIOD (SCH_COMPACT)
+#define ERROR_SCH_NOT_SCHEDULABLE                   13  // Task rejected by admission control (SCH_ADMISSION)
+#define ERROR_SCH_BAD_PREDECESSOR                   14  // SCH_Add_Stage: predecessor is not a live task or stage
 
 /* ==================== RETURN CODES ==================== */
 #define RETURN_ERROR            0
 #define RETURN_NORMAL           1
 
+/* ==================== TASK HANDLES ==================== */
+/*
+ * A handle is (generation << 16) | slot. The slot never moves while the
+ * task exists, and the generation is bumped every time a slot is reused,
+ * so a handle to a deleted task is rejected instead of hitting whatever
+ * task now lives in that slot. Handle 0 is never issued.
+ */
+typedef uint32_t SCH_Handle_t;
+
+#define SCH_INVALID_HANDLE      ((SCH_Handle_t)NO_TASK_ID)
+#define SCH_HANDLE_SLOT(h)      ((uint32_t)(h) & 0xFFFFu)
+#define SCH_HANDLE_GEN(h)       ((uint32_t)(h) >> 16)
+
+// Fast lane handles (SCH_FAST_LANE) have bit 15 of the slot part set
+#define SCH_FAST_HANDLE_BIT     0x8000u
+#define SCH_FAST_HANDLE(h)      (((uint32_t)(h) & SCH_FAST_HANDLE_BIT) != 0)
+
+// Pipeline stage handles (SCH_PIPELINE) have bit 14 of the slot part set
+#define SCH_STAGE_HANDLE_BIT    0x4000u
+#define SCH_STAGE_HANDLE(h)     (((uint32_t)(h) & (SCH_FAST_HANDLE_BIT | SCH_STAGE_HANDLE_BIT)) \
+                                 == SCH_STAGE_HANDLE_BIT)
+
+// Lanes of SCH_Add_Lane_Task()
+#define SCH_LANE_TICK           0   // TIM2 lane, DELAY / PERIOD in ticks
+#define SCH_LANE_FAST           1   // SysTick lane, DELAY / PERIOD in ms
+
+// Slot / queue index type (1 byte when SCH_MAX_TASKS allows it)
+#if SCH_MAX_TASKS < 255
+typedef uint8_t sch_index_t;
+#define SCH_NO_SLOT             0xFFu
+#else
+typedef uint16_t sch_index_t;
+#define SCH_NO_SLOT             0xFFFFu
+#endif
+
+// Delay / Period types of the compact slot table (SCH_COMPACT = 1).
+// A free slot keeps the next free slot in its Delay, so sch_delay_t
+// must also hold SCH_NO_SLOT.
+#if SCH_COMPACT
+#if SCH_MAX_PERIOD <= 0xFFu
+typedef uint8_t sch_period_t;
+#elif SCH_MAX_PERIOD <= 0xFFFFu
+typedef uint16_t sch_period_t;
+#else
+typedef uint32_t sch_period_t;
+#endif
+
+#if SCH_BACKEND != SCH_BACKEND_SORTED_ARRAY || SCH_TIMEBASE == SCH_TIMEBASE_ABSOLUTE
+typedef uint32_t sch_delay_t;           // Absolute tick
+#elif SCH_MAX_PERIOD <= 0xFFu && SCH_MAX_TASKS < 255
+typedef uint8_t sch_delay_t;
+#elif SCH_MAX_PERIOD <= 0xFFFFu
+typedef uint16_t sch_delay_t;
+#else
+typedef uint32_t sch_delay_t;
+#endif
+
+#if SCH_EVENT_PARK_TICKS > SCH_MAX_PERIOD
+#error "SCH_EVENT_PARK_TICKS must not exceed SCH_MAX_PERIOD"
+#endif
+#endif
+
 /* ==================== TASK STRUCTURE ==================== */
 typedef struct {
     void (*pTask)(void);        // Pointer to the task function
     uint32_t Delay;             // Delay (ticks) until function will run
     uint32_t Period;            // Interval (ticks) between runs
     uint8_t RunMe;              // Flag: incremented when task is due
-    uint32_t TaskID;            // Task identifier
+    uint32_t TaskID;            // Task handle (SCH_Handle_t)
 } sTask;
 
+/* ==================== IDLE STATISTICS ==================== */
+typedef struct {
+    uint32_t Wakeups;           // Times SCH_Go_To_Sleep() woke up
+    uint32_t Idle_Ticks;        // Ticks spent asleep
+    uint32_t Longest_Sleep;     // Longest single sleep (ticks)
+} SCH_Idle_Stats_t;
+
+/* ==================== CPU UTILIZATION ==================== */
+// Loads are in 0.01 % (10000 = 100 %); idle = 10000 - load
+typedef struct {
+    uint16_t Load_1s;           // Time in tasks over the last second
+    uint16_t Load_10s;          // ... last 10 seconds
+    uint16_t Load_60s;          // ... last 60 seconds
+    uint16_t Peak_Tick;         // Busiest tick of the last 60 s, share of one tick
+    uint32_t Peak_Tick_Cycles;  // Time in tasks in that tick (profiler units)
+    uint32_t Seconds;           // Seconds of history (windows are shorter until 60)
+} SCH_Utilization_t;
+
+/* ==================== ADMISSION CONTROL ==================== */
+// Load of the tick lane as seen by the admission check (SCH_Get_Admission)
+typedef struct {
+    uint32_t Utilization;       // Sum of WCET / Period, 0.01 % of the CPU
+    uint32_t Worst_Tick;        // Heaviest tick (profiler units)
+    uint32_t Tick_Budget;       // SCH_ADMIT_TICK_PCT % of one tick (same units)
+    uint32_t Hyperperiod;       // Ticks walked, 0 = above SCH_ADMIT_MAX_HYPER
+} SCH_Admission_t;
+
+/* ==================== STATIC TASK TABLE ==================== */
+// One row of a start-up table (see scheduler_table.h)
+typedef struct {
+    void (*pTask)(void);
+    uint32_t Delay;
+    uint32_t Period;
+} SCH_Task_Config_t;
+
+// Built by SCH_TASK_TABLE(): everything is const and stays in flash
+typedef struct {
+    const SCH_Task_Config_t *Tasks;     // Rows, row i → slot i
+    const sch_index_t *Order;           // Rows sorted by Delay (compile time)
+    const uint8_t *Marking;             // MARKING for that order (compile time)
+    uint8_t Count;                      // Number of rows
+} SCH_Task_Table_t;
+
+/* ==================== TASK PROFILE ==================== */
+typedef struct {
+    uint32_t Count;             // Number of timed runs
+    uint32_t Min_Cycles;        // Shortest run
+    uint32_t Max_Cycles;        // Longest run (observed WCET)
+    uint32_t Mean_Cycles;       // Total_Cycles / Count (filled on read)
+    uint64_t Total_Cycles;      // Sum of all runs
+} SCH_Task_Profile_t;
+
+/* ==================== PRIORITY CLASSES ==================== */
+// Task classes (SCH_Set_Task_Class), lower value runs first
+#define SCH_CLASS_CRITICAL      0   // Safety-relevant (e.g. traffic FSM)
+#define SCH_CLASS_NORMAL        1   // Default for every new task
+#define SCH_CLASS_BACKGROUND    2   // Display refresh, logging, telemetry
+#define SCH_CLASSES             3
+
+// Release-to-start latency of one class (profiler units)
+typedef struct {
+    uint32_t Count;             // Releases measured
+    uint32_t Max_Cycles;        // Worst latency
+    uint32_t Mean_Cycles;       // Total_Cycles / Count (filled on read)
+    uint64_t Total_Cycles;      // Sum of all latencies
+    uint32_t Blocking_Cycles;   // Longest run of a live lower-class task
+                                // (its profiled WCET, 0 without SCH_PROFILE)
+} SCH_Class_Latency_t;
+
+/* ==================== OVERLOAD SHEDDING ==================== */
+// Shed levels (SCH_Shed_Stats_t.Level)
+#define SCH_SHED_NONE           0   // Every task at its own period
+#define SCH_SHED_STRETCH        1   // BACKGROUND stretched
+#define SCH_SHED_PAUSE          2   // BACKGROUND paused, NORMAL stretched
+
+typedef struct {
+    uint8_t Level;              // Current level
+    uint8_t Max_Level;          // Highest level since SCH_Init
+    uint32_t Escalations;       // Times the level went up
+    uint32_t Overload_Ticks;    // Ticks above SCH_SHED_HIGH_PCT
+    uint32_t Shed_Releases;     // Releases dropped by shedding
+} SCH_Shed_Stats_t;
+
+/* ==================== TASK DEADLINE MISSES ==================== */
+typedef struct {
+    uint32_t Late_Starts;       // Runs that started after their due tick
+    uint32_t Missed_Periods;    // Whole periods lost to late starts
+    uint32_t Saturations;       // Times RunMe was already 255 when due again
+    uint32_t Max_Lateness;      // Worst start delay (ticks)
+    uint32_t Phase_Error;       // Ticks the release grid has slipped since
+                                // Add / Reschedule (0 with SCH_REARM_FROM_RELEASE)
+} SCH_Task_Misses_t;
+
+/* ==================== TRACE RECORDS ==================== */
+// SCH_Trace_Record_t.Event
+#define SCH_TRACE_TICK              1   // SCH_Update: Data = tick (low 16 bits)
+#define SCH_TRACE_DISPATCH_BEGIN    2   // SCH_Dispatch_Tasks entered
+#define SCH_TRACE_DISPATCH_END      3   // SCH_Dispatch_Tasks returns
+#define SCH_TRACE_TASK_BEGIN        4   // Data = slot, Value = RunMe
+#define SCH_TRACE_TASK_END          5   // Data = slot
+#define SCH_TRACE_ISR_BEGIN         6   // Data = IRQ number
+#define SCH_TRACE_ISR_END           7   // Data = IRQ number
+#define SCH_TRACE_ERROR             8   // Value = new Error_code_G (0 = cleared)
+#define SCH_TRACE_SHED              9   // Value = new shed level
+
+typedef struct {
+    uint32_t Time;              // SCH_Cycles_Now(): CPU cycles (target), ns (host)
+    uint16_t Data;
+    uint8_t Event;              // SCH_TRACE_xxx
+    uint8_t Value;
+} SCH_Trace_Record_t;
+
+// Layout of the dump (little endian, 16-byte header + records)
+#define SCH_TRACE_MAGIC         0x54484353uL    // "SCHT"
+
+typedef struct {
+    uint32_t Magic;             // SCH_TRACE_MAGIC
+    uint32_t Clock_Hz;          // Time units per second
+    uint32_t Count;             // Records written since SCH_Init (wraps)
+    uint16_t Size;              // SCH_TRACE_SIZE
+    uint16_t Tick_Ms;           // TIMER_TICK_MS
+    SCH_Trace_Record_t Records[SCH_TRACE_SIZE]; // Record n at [n % Size]
+} SCH_Trace_Buffer_t;
+
+/* ==================== TASK PIPELINES ==================== */
+#if SCH_PIPELINE
+/**
+ * @brief Pipeline stage: IN = snapshot of the predecessor (0 if it has
+ *        none), OUT = this stage's own snapshot (as given to SCH_Add_Stage)
+ */
+typedef void (*SCH_Stage_t)(const void *IN, void *OUT);
+#endif
+
+/* ==================== SCHEDULER INSTANCES ==================== */
+/*
+ * All state of a scheduler (slot table, run queue / wheel / frame table,
+ * ISR command ring, fast lane, stages, statistics) lives in one
+ * SCH_Instance_t, and every SCH_xxx() function has an SCH_xxx_In()
+ * variant that takes the instance as its first argument. Instances are
+ * independent: one per intersection or per rate group on the MCU, or
+ * thousands in one host process (Host/sch_fleet).
+ * SCH_xxx() is SCH_xxx_In(&SCH_default, ...) - existing code is unchanged.
+ *
+ * Rules:
+ *   - An instance must start zeroed (static storage, or = { 0 }) before
+ *     its first SCH_Init_In(); SCH_Init_In() of a used instance keeps its
+ *     handle generations, as SCH_Init() always did.
+ *   - Each instance needs its own clock: call SCH_Update_In() from the
+ *     timer ISR of its rate (and SCH_Fast_Update_In() from SysTick for
+ *     its fast lane). Handles are only valid on the instance that issued
+ *     them.
+ *   - Shared by all instances: the cycle counter and the trace ring
+ *     SCH_trace_G (records do not say which instance wrote them), both
+ *     started by the first SCH_Init_In() only - later ones leave them
+ *     running - and SCH_Error_Hook().
+ *   - SCH_Go_To_Sleep_In() sleeps until the next deadline of that one
+ *     instance and, with SCH_TICKLESS = 1, stretches TIM2: only use it
+ *     on the instance clocked by TIM2 when it is the only one, otherwise
+ *     build with SCH_TICKLESS = 0 (sleep one tick at a time).
+ */
+#include "scheduler_instance.h"
+
+// Instance behind the SCH_xxx() API (scheduler_default.c)
+extern SCH_Instance_t SCH_default;
+
 /* ==================== GLOBAL VARIABLES ==================== */
-extern sTask SCH_tasks_G[SCH_MAX_TASKS];
-extern uint8_t Error_code_G;
-extern uint8_t MARKING[SCH_MAX_TASKS];
-extern uint32_t task_count;
-extern uint32_t elapsed_time;
+// Former globals, now fields of SCH_default
+#if SCH_COMPACT
+// Slot table as arrays, indexed by handle slot (see SCH_COMPACT)
+#define SCH_delay_G             (SCH_default.task_delay)    // Hot: Delay
+#define SCH_runme_G             (SCH_default.task_runme)    // Hot: RunMe
+#define SCH_task_fn_G           (SCH_default.task_fn)       // Cold: pTask
+#define SCH_period_G            (SCH_default.task_period)   // Cold: Period
+#define SCH_task_gen_G          (SCH_default.task_gen)      // Cold: handle generation
+#else
+#define SCH_tasks_G             (SCH_default.tasks)         // Slot table, indexed by handle slot
+#endif
+#define Error_code_G            (SCH_default.error_code)
+#if SCH_TRACE
+extern SCH_Trace_Buffer_t SCH_trace_G;      // Trace ring (dump from debugger)
+#endif
+#if SCH_BACKEND == SCH_BACKEND_SORTED_ARRAY
+#define SCH_order_G             (SCH_default.order)         // Slots sorted by Delay
+#if SCH_TIMEBASE == SCH_TIMEBASE_RELATIVE && !SCH_COMPACT
+#define MARKING                 (SCH_default.marking)
+#endif
+#endif
 
 /* ==================== FUNCTION PROTOTYPES ==================== */
 
@@ -50,10 +745,19 @@ extern uint32_t elapsed_time;
  */
 void SCH_Init(void);
 
+/**
+ * @brief Initialize the scheduler already populated with a const task table
+ * Replaces SCH_Init() + one SCH_Add_Task() per row: the queue order and
+ * MARKING were computed at compile time and are only copied - O(rows).
+ * @param TABLE: Table declared with SCH_TASK_TABLE (scheduler_table.h)
+ */
+void SCH_Init_Static(const SCH_Task_Table_t *TABLE);
+
 /**
  * @brief Update function - called from timer ISR every TIMER_TICK_MS
  * Time Complexity: O(1) - only updates first task!
  * This is the key optimization for fast ISR execution
+ * (Timing wheel: only counts the tick, the wheel is advanced in Dispatch)
  */
 void SCH_Update(void);
 
@@ -61,6 +765,7 @@ void SCH_Update(void);
  * @brief Dispatch tasks that are ready to run
  * Should be called in the main loop
  * Time Complexity: O(n²) worst case (trade-off for O(1) Update)
+ * (Timing wheel: O(1) per tick + O(1) per expired task)
  */
 void SCH_Dispatch_Tasks(void);
 
@@ -69,29 +774,145 @@ void SCH_Dispatch_Tasks(void);
  * @param pFunction: Pointer to task function
  * @param DELAY: Initial delay in ticks (TIMER_TICK_MS units)
  * @param PERIOD: Period for repetitive tasks (0 for one-shot)
- * @return Task index in array, or SCH_MAX_TASKS if failed
+ * @return Task handle, or SCH_INVALID_HANDLE if failed
  *
  * Example: SCH_Add_Task(Task_LED1, 0, 50); // Run every 500ms
  */
-uint32_t SCH_Add_Task(void (*pFunction)(), uint32_t DELAY, uint32_t PERIOD);
+SCH_Handle_t SCH_Add_Task(void (*pFunction)(), uint32_t DELAY, uint32_t PERIOD);
+
+/**
+ * @brief Add a task to one of the two lanes - same API for both
+ * @param LANE: SCH_LANE_TICK (same as SCH_Add_Task) or SCH_LANE_FAST
+ *        (SCH_FAST_LANE, DELAY and PERIOD in ms, at most 65535)
+ * @return Task handle, or SCH_INVALID_HANDLE if failed
+ *
+ * Example: SCH_Add_Lane_Task(SCH_LANE_FAST, Task_Button_Scan, 0, 5); // Every 5ms
+ */
+SCH_Handle_t SCH_Add_Lane_Task(uint8_t LANE, void (*pFunction)(), uint32_t DELAY, uint32_t PERIOD);
+
+/**
+ * @brief Fast lane clock - call from SysTick_Handler every 1 ms
+ * Time Complexity: O(SCH_FAST_MAX_TASKS), nothing when SCH_FAST_LANE = 0
+ */
+void SCH_Fast_Update(void);
+
+#if SCH_PIPELINE
+/**
+ * @brief Run STAGE right after PREDECESSOR, in the same dispatch, every
+ *        time PREDECESSOR runs
+ * @param PREDECESSOR: Tick lane task handle or stage handle
+ * @param OUT: Snapshot filled by STAGE, passed as IN to its own stages (may be 0)
+ * @return Stage handle (works with SCH_Delete_Task), or SCH_INVALID_HANDLE
+ *         (ERROR_SCH_BAD_PREDECESSOR / ERROR_SCH_TOO_MANY_TASKS)
+ * Example: SCH_Add_Stage(Stage_Update_Display, fsm_id, 0);
+ */
+SCH_Handle_t SCH_Add_Stage(SCH_Stage_t STAGE, SCH_Handle_t PREDECESSOR, void *OUT);
+
+/**
+ * @brief Snapshot a tick lane task fills on every run, passed as IN to
+ *        the stages right after it (0 = none)
+ * @return RETURN_NORMAL, or RETURN_ERROR if the handle is stale/invalid
+ *         or the table is full
+ */
+uint8_t SCH_Set_Task_Output(const SCH_Handle_t TASK_HANDLE, void *OUT);
+#endif
 
 /**
  * @brief Delete a task from the scheduler
- * @param TASK_INDEX: Index of task to delete
- * @return RETURN_NORMAL or RETURN_ERROR
+ * @param TASK_HANDLE: Handle returned by SCH_Add_Task
+ * @return RETURN_NORMAL, or RETURN_ERROR if the handle is stale/invalid
+ * Time Complexity: O(1) in both backends
+ * (Sorted array: the queue entry is dropped lazily when it reaches the head)
+ */
+uint8_t SCH_Delete_Task(const SCH_Handle_t TASK_HANDLE);
+
+/**
+ * @brief Change the delay and period of an existing task
+ * @param TASK_HANDLE: Handle returned by SCH_Add_Task
+ * @param DELAY: New delay in ticks (ms for a fast lane task), counted from now
+ * @param PERIOD: New period (0 for one-shot)
+ * @return RETURN_NORMAL, or RETURN_ERROR if the handle is stale/invalid
+ * Time Complexity: O(1) timing wheel, O(n) sorted array
+ */
+uint8_t SCH_Reschedule_Task(const SCH_Handle_t TASK_HANDLE, uint32_t DELAY, uint32_t PERIOD);
+
+/**
+ * @brief Look up a task by handle - O(1)
+ * @return Pointer to the task, or 0 if the handle is stale/invalid
+ * (SCH_COMPACT = 1: a copy of the fields, overwritten by the next call)
+ */
+const sTask *SCH_Get_Task(const SCH_Handle_t TASK_HANDLE);
+
+/**
+ * @brief Schedule a task from an interrupt handler - O(1), wait-free
+ * The task is added when SCH_Dispatch_Tasks() next drains the ring;
+ * DELAY counts from then.
+ * @param HANDLE_OUT: Optional (0). Set to SCH_INVALID_HANDLE now, then
+ *        to the new handle when the command is drained.
+ * @return RETURN_NORMAL, or RETURN_ERROR if the ring is full
+ */
+uint8_t SCH_Add_Task_From_ISR(void (*pFunction)(void), uint32_t DELAY, uint32_t PERIOD,
+                              SCH_Handle_t *HANDLE_OUT);
+
+/**
+ * @brief Delete a task from an interrupt handler - O(1), wait-free
+ * The task is deleted when SCH_Dispatch_Tasks() next drains the ring.
+ * @return RETURN_NORMAL, or RETURN_ERROR if the ring is full
+ */
+uint8_t SCH_Delete_Task_From_ISR(const SCH_Handle_t TASK_HANDLE);
+
+/**
+ * @brief Add an event-triggered task, run by SCH_Signal() instead of a period
+ * @param TIMEOUT: Also run after TIMEOUT ticks without a signal (0 = never)
+ * @return Task handle, or SCH_INVALID_HANDLE if failed
+ * Example: SCH_Add_Event_Task(Task_Traffic_FSM, 100); // Button edge or 1s
+ */
+SCH_Handle_t SCH_Add_Event_Task(void (*pFunction)(void), uint32_t TIMEOUT);
+
+/**
+ * @brief Wake an event task: it runs on the next tick - call from tasks
+ * Several signals before the task runs give one run; a signal sent while
+ * the task runs gives one more run. Restarts the timeout.
+ * @return RETURN_NORMAL, or RETURN_ERROR if the handle is stale or the
+ *         task is not an event task
  */
-uint8_t SCH_Delete_Task(const uint32_t TASK_INDEX);
+uint8_t SCH_Signal(const SCH_Handle_t TASK_HANDLE);
 
 /**
- * @brief Report system status (optional)
+ * @brief SCH_Signal() from an interrupt handler - O(1), wait-free
+ * Delivered when SCH_Dispatch_Tasks() next drains the ISR command ring;
+ * repeated signals before that take one ring entry.
+ * @return RETURN_NORMAL, or RETURN_ERROR if the ring is full
+ */
+uint8_t SCH_Signal_From_ISR(const SCH_Handle_t TASK_HANDLE);
+
+/**
+ * @brief Report system status - called at the end of SCH_Dispatch_Tasks()
+ * Passes every new Error_code_G to SCH_Error_Hook() and clears it once
+ * no error has been raised for SCH_ERROR_HOLD_TICKS.
  */
 void SCH_Report_Status(void);
 
 /**
- * @brief Put system to sleep (optional - for power saving)
+ * @brief Called by SCH_Report_Status() when Error_code_G changes (0 = cleared)
+ * Weak, does nothing by default: override to show the code on LEDs / UART.
+ */
+void SCH_Error_Hook(uint8_t ERROR_CODE);
+
+/**
+ * @brief Sleep until the next task is due - call after SCH_Dispatch_Tasks()
+ * Returns at once if a task is already due.
+ * SCH_TICKLESS = 1: TIM2 is reprogrammed to fire at the next deadline
+ * (at most SCH_TICKLESS_MAX_TICKS ahead), SysTick is suspended while asleep.
+ * Any other interrupt wakes the MCU early; the ticks slept so far are kept.
  */
 void SCH_Go_To_Sleep(void);
 
+/**
+ * @brief Copy the idle statistics collected by SCH_Go_To_Sleep()
+ */
+void SCH_Get_Idle_Stats(SCH_Idle_Stats_t *STATS);
+
 /* ==================== HELPER FUNCTIONS ==================== */
 
 /**
@@ -99,4 +920,216 @@ void SCH_Go_To_Sleep(void);
  */
 uint32_t SCH_Get_Current_Size(void);
 
+/**
+ * @brief Ticks since SCH_Init() (wraps after 2^32 ticks, compare by difference)
+ */
+uint32_t SCH_Get_Tick(void);
+
+/**
+ * @brief Copy the execution-time profile of a task (SCH_PROFILE = 1)
+ * @param TASK_HANDLE: Handle returned by SCH_Add_Task
+ * @param PROFILE: Filled with min/max/mean/total cycles and run count
+ * @return RETURN_NORMAL, or RETURN_ERROR if the handle is stale/invalid
+ * The profile starts empty when the task is added.
+ */
+uint8_t SCH_Get_Task_Profile(const SCH_Handle_t TASK_HANDLE, SCH_Task_Profile_t *PROFILE);
+
+/**
+ * @brief Clear the profiles of all tasks (e.g. after start-up)
+ */
+void SCH_Reset_Task_Profiles(void);
+
+/**
+ * @brief Copy the late-start / missed-period / RunMe saturation counters
+ *        and the phase error of the task's release grid
+ * @param TASK_HANDLE: Handle returned by SCH_Add_Task
+ * @return RETURN_NORMAL, or RETURN_ERROR if the handle is stale/invalid
+ */
+uint8_t SCH_Get_Task_Misses(const SCH_Handle_t TASK_HANDLE, SCH_Task_Misses_t *MISSES);
+
+#if SCH_PRIORITY
+/**
+ * @brief Set the priority class of a task (SCH_CLASS_xxx); for a stage
+ *        handle, the class it is shed by (see TASK PIPELINES)
+ * @return RETURN_NORMAL, or RETURN_ERROR if the handle or class is invalid
+ * Example: SCH_Set_Task_Class(fsm_id, SCH_CLASS_CRITICAL);
+ */
+uint8_t SCH_Set_Task_Class(const SCH_Handle_t TASK_HANDLE, uint8_t CLASS);
+
+/**
+ * @brief Copy the measured dispatch latency of a class (release tick to
+ *        task start) and the blocking a lower class can cause
+ * @return RETURN_NORMAL, or RETURN_ERROR if CLASS is invalid
+ */
+uint8_t SCH_Get_Class_Latency(uint8_t CLASS, SCH_Class_Latency_t *LATENCY);
+#endif
+
+#if SCH_SHED
+/**
+ * @brief Copy the overload shedding level and counters
+ */
+void SCH_Get_Shed_Stats(SCH_Shed_Stats_t *STATS);
+#endif
+
+#if SCH_UTIL
+/**
+ * @brief CPU time spent in tasks over the last 1 s / 10 s / 60 s and the
+ *        busiest tick (completed seconds only)
+ * Example: 10000 - u.Load_60s = headroom left for new features
+ */
+void SCH_Get_Utilization(SCH_Utilization_t *UTIL);
+#endif
+
+#if SCH_ADMISSION
+/**
+ * @brief SCH_Add_Task with a declared WCET (profiler units) for the
+ *        admission check; kept as the task's cost (SCH_Set_Task_Cost)
+ * @return Task handle, or SCH_INVALID_HANDLE if failed or not schedulable
+ * Example: SCH_Add_Task_Wcet(Task_Telemetry, 0, 100, 12000);
+ */
+SCH_Handle_t SCH_Add_Task_Wcet(void (*pFunction)(void), uint32_t DELAY, uint32_t PERIOD, uint32_t WCET);
+
+/**
+ * @brief Run the admission check on the current task set
+ * @param ADMISSION: Optional (0), filled with the loads that were checked
+ * @return RETURN_NORMAL if both bounds hold, else RETURN_ERROR
+ */
+uint8_t SCH_Get_Admission(SCH_Admission_t *ADMISSION);
+#endif
+
+#if SCH_STAGGER || SCH_ADMISSION
+/**
+ * @brief Declare the run time of a task (profiler units), 0 = unknown
+ * Used for load levelling until the profiler has measured the task, and
+ * as its WCET by the admission check.
+ */
+uint8_t SCH_Set_Task_Cost(const SCH_Handle_t TASK_HANDLE, uint32_t COST);
+#endif
+
+#if SCH_STAGGER
+/**
+ * @brief Add a periodic task, delayed so that it runs on the least loaded ticks
+ * @param PERIOD: Period in ticks (> 0); the first run is 1..PERIOD ticks away
+ * @param COST: Declared run time (profiler units), 0 = unknown
+ * @return Task handle, or SCH_INVALID_HANDLE if failed
+ * Example: SCH_Add_Task_Staggered(Task_Log, 5, 0); // Not on the display tick
+ */
+SCH_Handle_t SCH_Add_Task_Staggered(void (*pFunction)(void), uint32_t PERIOD, uint32_t COST);
+
+/**
+ * @brief Per-tick load over the next SCH_STAGGER_WINDOW ticks
+ * @param LOAD: Optional (0). LOAD[i] = load of tick (now + 1 + i), i < LEN
+ * @return Load of the busiest tick in the window
+ */
+uint32_t SCH_Get_Load_Profile(uint32_t *LOAD, uint32_t LEN);
+#endif
+
+#if SCH_TRACE
+/**
+ * @brief Append one record to the trace ring - safe in ISRs
+ * Also for application markers (Event >= 16).
+ */
+void SCH_Trace_Event(uint8_t EVENT, uint16_t DATA, uint8_t VALUE);
+
+/**
+ * @brief Copy the trace, oldest record first
+ * @return Number of records copied (at most MAX and SCH_TRACE_SIZE)
+ */
+uint32_t SCH_Trace_Read(SCH_Trace_Record_t *RECORDS, uint32_t MAX);
+
+// First / last statement of an interrupt handler, ID = its IRQn
+#define SCH_TRACE_ISR_ENTER(ID) SCH_Trace_Event(SCH_TRACE_ISR_BEGIN, (uint16_t)(ID), 0)
+#define SCH_TRACE_ISR_EXIT(ID)  SCH_Trace_Event(SCH_TRACE_ISR_END, (uint16_t)(ID), 0)
+#else
+#define SCH_TRACE_ISR_ENTER(ID) ((void)0)
+#define SCH_TRACE_ISR_EXIT(ID)  ((void)0)
+#endif
+
+#if SCH_BACKEND == SCH_BACKEND_CYCLIC
+/**
+ * @brief Number of frames of the cyclic schedule (LCM of the table periods)
+ */
+uint32_t SCH_Get_Hyperperiod(void);
+
+/**
+ * @brief Tasks released in frame FRAME (tick mod hyperperiod), in run order
+ * @param HANDLES: Optional (0), receives up to MAX handles
+ * @return Number of tasks in the frame
+ * Example: worst tick = max over frames of SCH_Get_Frame_Tasks(f, 0, 0)
+ */
+uint32_t SCH_Get_Frame_Tasks(uint32_t FRAME, SCH_Handle_t *HANDLES, uint32_t MAX);
+#endif
+
+/* ==================== INSTANCE API ==================== */
+/*
+ * Same as the SCH_xxx() function of the same name, on instance SCH
+ * (see SCHEDULER INSTANCES). Example - two intersections, one TIM2:
+ *
+ *   static SCH_Instance_t north, south;
+ *
+ *   SCH_Init_In(&north);
+ *   SCH_Init_In(&south);
+ *   SCH_Add_Task_In(&north, Task_North_FSM, 0, 1);
+ *   SCH_Add_Task_In(&south, Task_South_FSM, 0, 1);
+ *
+ *   // TIM2 callback                   // main loop
+ *   SCH_Update_In(&north);             SCH_Dispatch_Tasks_In(&north);
+ *   SCH_Update_In(&south);             SCH_Dispatch_Tasks_In(&south);
+ */
+void SCH_Init_In(SCH_Instance_t *SCH);
+void SCH_Init_Static_In(SCH_Instance_t *SCH, const SCH_Task_Table_t *TABLE);
+void SCH_Update_In(SCH_Instance_t *SCH);
+void SCH_Dispatch_Tasks_In(SCH_Instance_t *SCH);
+SCH_Handle_t SCH_Add_Task_In(SCH_Instance_t *SCH, void (*pFunction)(), uint32_t DELAY, uint32_t PERIOD);
+SCH_Handle_t SCH_Add_Lane_Task_In(SCH_Instance_t *SCH, uint8_t LANE, void (*pFunction)(),
+                                  uint32_t DELAY, uint32_t PERIOD);
+void SCH_Fast_Update_In(SCH_Instance_t *SCH);
+#if SCH_PIPELINE
+SCH_Handle_t SCH_Add_Stage_In(SCH_Instance_t *SCH, SCH_Stage_t STAGE, SCH_Handle_t PREDECESSOR, void *OUT);
+uint8_t SCH_Set_Task_Output_In(SCH_Instance_t *SCH, const SCH_Handle_t TASK_HANDLE, void *OUT);
+#endif
+uint8_t SCH_Delete_Task_In(SCH_Instance_t *SCH, const SCH_Handle_t TASK_HANDLE);
+uint8_t SCH_Reschedule_Task_In(SCH_Instance_t *SCH, const SCH_Handle_t TASK_HANDLE, uint32_t DELAY, uint32_t PERIOD);
+const sTask *SCH_Get_Task_In(SCH_Instance_t *SCH, const SCH_Handle_t TASK_HANDLE);
+uint8_t SCH_Add_Task_From_ISR_In(SCH_Instance_t *SCH, void (*pFunction)(void), uint32_t DELAY,
+                                 uint32_t PERIOD, SCH_Handle_t *HANDLE_OUT);
+uint8_t SCH_Delete_Task_From_ISR_In(SCH_Instance_t *SCH, const SCH_Handle_t TASK_HANDLE);
+SCH_Handle_t SCH_Add_Event_Task_In(SCH_Instance_t *SCH, void (*pFunction)(void), uint32_t TIMEOUT);
+uint8_t SCH_Signal_In(SCH_Instance_t *SCH, const SCH_Handle_t TASK_HANDLE);
+uint8_t SCH_Signal_From_ISR_In(SCH_Instance_t *SCH, const SCH_Handle_t TASK_HANDLE);
+void SCH_Report_Status_In(SCH_Instance_t *SCH);
+void SCH_Go_To_Sleep_In(SCH_Instance_t *SCH);
+void SCH_Get_Idle_Stats_In(SCH_Instance_t *SCH, SCH_Idle_Stats_t *STATS);
+uint32_t SCH_Get_Current_Size_In(SCH_Instance_t *SCH);
+uint32_t SCH_Get_Tick_In(SCH_Instance_t *SCH);
+uint8_t SCH_Get_Task_Profile_In(SCH_Instance_t *SCH, const SCH_Handle_t TASK_HANDLE, SCH_Task_Profile_t *PROFILE);
+void SCH_Reset_Task_Profiles_In(SCH_Instance_t *SCH);
+uint8_t SCH_Get_Task_Misses_In(SCH_Instance_t *SCH, const SCH_Handle_t TASK_HANDLE, SCH_Task_Misses_t *MISSES);
+#if SCH_PRIORITY
+uint8_t SCH_Set_Task_Class_In(SCH_Instance_t *SCH, const SCH_Handle_t TASK_HANDLE, uint8_t CLASS);
+uint8_t SCH_Get_Class_Latency_In(SCH_Instance_t *SCH, uint8_t CLASS, SCH_Class_Latency_t *LATENCY);
+#endif
+#if SCH_SHED
+void SCH_Get_Shed_Stats_In(SCH_Instance_t *SCH, SCH_Shed_Stats_t *STATS);
+#endif
+#if SCH_UTIL
+void SCH_Get_Utilization_In(SCH_Instance_t *SCH, SCH_Utilization_t *UTIL);
+#endif
+#if SCH_ADMISSION
+SCH_Handle_t SCH_Add_Task_Wcet_In(SCH_Instance_t *SCH, void (*pFunction)(void), uint32_t DELAY,
+                                  uint32_t PERIOD, uint32_t WCET);
+uint8_t SCH_Get_Admission_In(SCH_Instance_t *SCH, SCH_Admission_t *ADMISSION);
+#endif
+#if SCH_STAGGER || SCH_ADMISSION
+uint8_t SCH_Set_Task_Cost_In(SCH_Instance_t *SCH, const SCH_Handle_t TASK_HANDLE, uint32_t COST);
+#endif
+#if SCH_STAGGER
+SCH_Handle_t SCH_Add_Task_Staggered_In(SCH_Instance_t *SCH, void (*pFunction)(void), uint32_t PERIOD, uint32_t COST);
+uint32_t SCH_Get_Load_Profile_In(SCH_Instance_t *SCH, uint32_t *LOAD, uint32_t LEN);
+#endif
+#if SCH_BACKEND == SCH_BACKEND_CYCLIC
+uint32_t SCH_Get_Hyperperiod_In(SCH_Instance_t *SCH);
+uint32_t SCH_Get_Frame_Tasks_In(SCH_Instance_t *SCH, uint32_t FRAME, SCH_Handle_t *HANDLES, uint32_t MAX);
+#endif
+
 #endif /* INC_SCHEDULER_H_ */
@@ -0,0 +1,213 @@
+/*
+ * scheduler_instance.h
+ * State of one scheduler instance (SCH_Instance_t).
+ *
+ * Included by scheduler.h, not on its own. The layout is public only so
+ * that instances can be allocated statically (or in an array on the
+ * host); the fields are private to the scheduler sources - use the API.
+ *
+ * Every field is a former file-scope variable of the scheduler sources,
+ * under the same name (the _G tables lost their prefix / suffix). Which
+ * fields exist depends on the same configuration switches as before.
+ */
+#ifndef INC_SCHEDULER_INSTANCE_H_
+#define INC_SCHEDULER_INSTANCE_H_
+
+/* ==================== PRIVATE TYPES ==================== */
+
+// CPU utilization history (SCH_UTIL): seconds kept, the longest window
+#define SCH_UTIL_HISTORY        60u
+
+// ISR command ring entry (scheduler_cmd.c)
+typedef struct {
+    uint8_t Kind;
+    void (*pTask)(void);
+    uint32_t Delay;
+    uint32_t Period;
+    SCH_Handle_t Handle;
+    SCH_Handle_t *Result;       // Where the new handle goes (may be 0)
+} sch_cmd_t;
+
+#if SCH_FAST_LANE
+// Fast lane entry (scheduler_fast.c); free entry: pTask = 0
+typedef struct {
+    void (*volatile pTask)(void);
+    volatile uint16_t Delay;    // ms to the next release (0 = one-shot already released)
+    uint16_t Period;            // ms, 0 = one-shot
+    volatile uint8_t Released;  // Releases (written by the ISR only)
+    uint8_t Done;               // Releases handled (written by Dispatch only)
+    uint16_t Gen;               // Handle generation
+} sch_fast_t;
+#endif
+
+#if SCH_PIPELINE
+// Pipeline stage (scheduler_pipe.c); free entry: pStage = 0
+typedef struct {
+    SCH_Stage_t pStage;
+    void *Out;                  // Snapshot the stage fills (IN of the next stage)
+    SCH_Handle_t Head;          // Handle of the task heading the chain
+    uint16_t Gen;               // Stage handle generation
+    uint8_t Pred;               // Entry of the previous stage, 0xFF = the task
+    uint8_t Depth;              // 1 = right after the task
+#if SCH_PRIORITY
+    uint8_t Class;              // Shed on its own only if below the task's class
+    uint8_t Shed_Count;         // Stretch counter (SCH_Shed_Drop)
+#endif
+} sch_stage_t;
+
+// OUT of a task heading a pipeline (SCH_Set_Task_Output); free: Head = 0
+typedef struct {
+    SCH_Handle_t Head;
+    void *Out;
+} sch_pipe_out_t;
+#endif
+
+#if SCH_BACKEND == SCH_BACKEND_TIMING_WHEEL
+// Wheel lists: SCH_WHEEL_LEVELS levels of slots, then the ready list(s)
+// (one per class with SCH_PRIORITY)
+#if SCH_PRIORITY
+#define SCH_WHEEL_READY_LISTS   SCH_CLASSES
+#else
+#define SCH_WHEEL_READY_LISTS   1u
+#endif
+#define SCH_WHEEL_LISTS         (SCH_WHEEL_LEVELS * (1u << SCH_WHEEL_BITS) + SCH_WHEEL_READY_LISTS)
+
+#if SCH_WHEEL_LISTS < 0xFFFF
+typedef uint16_t sch_wheel_list_t;
+#else
+typedef uint32_t sch_wheel_list_t;
+#endif
+#endif
+
+#if SCH_BACKEND == SCH_BACKEND_CYCLIC
+#if SCH_CYCLIC_MAX_ENTRIES < 0xFFFF
+typedef uint16_t sch_cyclic_entry_t;
+#else
+typedef uint32_t sch_cyclic_entry_t;
+#endif
+#endif
+
+/* ==================== INSTANCE ==================== */
+
+typedef struct {
+    /* ---- Slot table (scheduler.c), indexed by handle slot ---- */
+#if SCH_COMPACT
+    sch_delay_t task_delay[SCH_MAX_TASKS];      // Hot: Delay
+    uint8_t task_runme[SCH_MAX_TASKS];          // Hot: RunMe
+    void (*task_fn[SCH_MAX_TASKS])(void);       // Cold: pTask
+    sch_period_t task_period[SCH_MAX_TASKS];    // Cold: Period
+    uint16_t task_gen[SCH_MAX_TASKS];           // Cold: handle generation
+    sTask task_view;                            // Copy returned by SCH_Get_Task
+#else
+    sTask tasks[SCH_MAX_TASKS];
+#endif
+    uint8_t error_code;                 // Error_code_G of the instance (0 = none)
+    uint32_t task_count;                // Live tasks
+    volatile uint32_t tick_now;         // Ticks since SCH_Init (+ ticks slept)
+    sch_index_t free_head;              // Free list of returned slots
+    uint32_t fresh_slot;                // First slot never handed out
+
+    /* ---- Per-task release state and statistics ---- */
+    uint32_t task_due[SCH_MAX_TASKS];       // Tick the next run is due
+    uint32_t task_release[SCH_MAX_TASKS];   // Nominal release of the current run
+    uint8_t task_replay[SCH_MAX_TASKS];     // SCH_CATCHUP_REPLAY runs left
+    uint8_t task_event[SCH_MAX_TASKS];      // Polled / event task
+    uint8_t task_signal[SCH_MAX_TASKS];     // Signalled, not run yet
+    SCH_Task_Misses_t task_misses[SCH_MAX_TASKS];
+#if SCH_STAGGER || SCH_ADMISSION
+    uint32_t task_cost[SCH_MAX_TASKS];      // Declared run time (0 = unknown)
+#endif
+#if SCH_ADMISSION
+    uint32_t admit_wcet;                // Task being added: declared WCET
+    uint8_t admit_any_tick;             // ... is an event task
+    uint8_t admit_table;                // SCH_Init_Static is copying rows
+#endif
+#if SCH_STAGGER
+    uint32_t stagger_load[SCH_STAGGER_WINDOW];
+#endif
+#if SCH_PRIORITY
+    uint8_t task_class[SCH_MAX_TASKS];
+    SCH_Class_Latency_t class_latency[SCH_CLASSES];
+    volatile uint32_t tick_cycles;      // Cycle counter at the last SCH_Update
+#endif
+#if SCH_SHED
+    uint8_t task_shed_count[SCH_MAX_TASKS];
+    SCH_Shed_Stats_t shed_stats;
+    uint32_t shed_hot_ticks;
+    uint32_t shed_calm_ticks;
+#endif
+    uint8_t last_error_code;            // SCH_Report_Status
+    uint32_t error_tick;
+#if SCH_PROFILE
+    SCH_Task_Profile_t task_profile[SCH_MAX_TASKS];
+#endif
+#if SCH_UTIL
+    uint32_t util_busy[SCH_UTIL_HISTORY];   // Completed seconds
+    uint32_t util_peak[SCH_UTIL_HISTORY];
+    uint32_t util_head;
+    uint32_t util_seconds;
+    uint32_t util_second;                   // Second / tick being counted
+    uint32_t util_second_busy;
+    uint32_t util_second_peak;
+    uint32_t util_tick;
+    uint32_t util_tick_busy;
+#endif
+
+    /* ---- Backend ---- */
+#if SCH_BACKEND == SCH_BACKEND_SORTED_ARRAY
+    sch_index_t order[SCH_MAX_TASKS];   // SCH_order_G: slots sorted by Delay
+#if SCH_TIMEBASE == SCH_TIMEBASE_RELATIVE
+#if SCH_COMPACT
+    uint32_t mark_delay;
+#else
+    uint8_t marking[SCH_MAX_TASKS];     // MARKING
+#endif
+    uint32_t elapsed_time;
+#endif
+    uint32_t queue_len;
+    sch_index_t running_slot;
+#elif SCH_BACKEND == SCH_BACKEND_TIMING_WHEEL
+    sch_index_t wheel_head[SCH_WHEEL_LISTS];
+    sch_index_t wheel_next[SCH_MAX_TASKS];
+    sch_index_t wheel_prev[SCH_MAX_TASKS];
+    sch_wheel_list_t wheel_list[SCH_MAX_TASKS];
+    uint32_t wheel_next_tick;
+    uint32_t done_ticks;
+#elif SCH_BACKEND == SCH_BACKEND_CYCLIC
+    sch_cyclic_entry_t frame_start[SCH_CYCLIC_MAX_FRAMES + 1];
+    sch_index_t frame_task[SCH_CYCLIC_MAX_ENTRIES];
+    uint8_t in_table[SCH_MAX_TASKS];
+    uint8_t on_side[SCH_MAX_TASKS];
+    sch_index_t side_next[SCH_MAX_TASKS];
+    sch_index_t side_prev[SCH_MAX_TASKS];
+    sch_index_t side_head;
+    sch_index_t side_cursor;
+    uint32_t side_due;
+    uint32_t hyperperiod;
+    uint32_t frame;
+    uint8_t table_dirty;
+    uint8_t in_tick;
+    uint32_t done_ticks;
+#endif
+
+    /* ---- ISR command ring (scheduler_cmd.c) ---- */
+    sch_cmd_t cmd_ring[SCH_CMD_RING_SIZE];
+    volatile uint32_t cmd_head;         // Written by ISRs only
+    volatile uint32_t cmd_tail;         // Written by Dispatch only
+    volatile uint8_t signal_posted[SCH_MAX_TASKS];
+
+    /* ---- Fast lane / pipelines / sleep ---- */
+#if SCH_FAST_LANE
+    sch_fast_t fast_tasks[SCH_FAST_MAX_TASKS];
+    uint8_t fast_count;
+#endif
+#if SCH_PIPELINE
+    sch_stage_t pipe_stages[SCH_PIPE_MAX_STAGES];
+    sch_pipe_out_t pipe_outs[SCH_PIPE_MAX_STAGES];
+    uint8_t pipe_count;
+    uint8_t pipe_depth;
+#endif
+    SCH_Idle_Stats_t idle_stats;
+} SCH_Instance_t;
+
+#endif /* INC_SCHEDULER_INSTANCE_H_ */
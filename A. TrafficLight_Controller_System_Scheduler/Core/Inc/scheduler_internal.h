@@ -0,0 +1,321 @@
+/*
+ * scheduler_internal.h
+ * Slot table and handle helpers shared by the scheduler backends
+ * (scheduler.c, scheduler_wheel.c, scheduler_cyclic.c), and the backend hooks used by the
+ * port layer (scheduler_port.c), and the port hooks they call.
+ * Not for application code.
+ *
+ * Every function works on the instance passed as SCH (SCH_Instance_t,
+ * scheduler_instance.h). The macros below that read scheduler state use
+ * the SCH of the function they are expanded in.
+ */
+#ifndef INC_SCHEDULER_INTERNAL_H_
+#define INC_SCHEDULER_INTERNAL_H_
+
+#include "scheduler.h"
+
+/* ==================== SLOT FIELDS ==================== */
+
+// Fields of the task in SLOT of instance SCH, whatever the layout
+// (SCH_COMPACT). All are lvalues except SCH_TASK_ID (set by SCH_Slot_Alloc only).
+#if SCH_COMPACT
+#define SCH_TASK_FN(slot)       (SCH->task_fn[(slot)])
+#define SCH_TASK_DELAY(slot)    (SCH->task_delay[(slot)])
+#define SCH_TASK_PERIOD(slot)   (SCH->task_period[(slot)])
+#define SCH_TASK_RUNME(slot)    (SCH->task_runme[(slot)])
+#define SCH_TASK_ID(slot)       (((uint32_t)SCH->task_gen[(slot)] << 16) | (uint32_t)(slot))
+#else
+#define SCH_TASK_FN(slot)       (SCH->tasks[(slot)].pTask)
+#define SCH_TASK_DELAY(slot)    (SCH->tasks[(slot)].Delay)
+#define SCH_TASK_PERIOD(slot)   (SCH->tasks[(slot)].Period)
+#define SCH_TASK_RUNME(slot)    (SCH->tasks[(slot)].RunMe)
+#define SCH_TASK_ID(slot)       (SCH->tasks[(slot)].TaskID)
+#endif
+
+/**
+ * @brief Empty the slot table - O(1), slots are handed out lazily
+ */
+void SCH_Slots_Init(SCH_Instance_t *SCH);
+
+/**
+ * @brief Take a free slot and issue a new handle (generation + 1) - O(1)
+ * @return Slot, or SCH_NO_SLOT if the table is full (Error_code_G is set)
+ */
+sch_index_t SCH_Slot_Alloc(SCH_Instance_t *SCH, void (*pFunction)(void), uint32_t PERIOD);
+
+/**
+ * @brief Check DELAY and PERIOD against SCH_MAX_PERIOD (SCH_COMPACT = 1)
+ * @return 1 if they fit, else 0 with Error_code_G = ERROR_SCH_PERIOD_TOO_LONG
+ */
+#if SCH_COMPACT && SCH_MAX_PERIOD < 0xFFFFFFFFuL
+uint8_t SCH_Ticks_Check(SCH_Instance_t *SCH, uint32_t DELAY, uint32_t PERIOD);
+#else
+#define SCH_Ticks_Check(SCH, DELAY, PERIOD)     1
+#endif
+
+/**
+ * @brief Admission check of a new task (SCH_ADMISSION = 1), called by
+ *        SCH_Add_Task of every backend before a slot is taken
+ * @return 1 if the task set stays schedulable, else 0 with
+ *         Error_code_G = ERROR_SCH_NOT_SCHEDULABLE
+ */
+#if SCH_ADMISSION
+uint8_t SCH_Admit(SCH_Instance_t *SCH, uint32_t DELAY, uint32_t PERIOD);
+#else
+#define SCH_Admit(SCH, DELAY, PERIOD)           1
+#endif
+
+/**
+ * @brief Admission check of SCH_Reschedule_Task (SCH_ADMISSION = 1): the
+ *        slot's entry is replaced by (DELAY, PERIOD) with its current WCET;
+ *        one-shot and event tasks always pass
+ * @return 1 if the task set stays schedulable, else 0 with
+ *         Error_code_G = ERROR_SCH_NOT_SCHEDULABLE
+ */
+#if SCH_ADMISSION
+uint8_t SCH_Admit_Reschedule(SCH_Instance_t *SCH, uint32_t SLOT, uint32_t DELAY, uint32_t PERIOD);
+#else
+#define SCH_Admit_Reschedule(SCH, SLOT, DELAY, PERIOD)  1
+#endif
+
+/**
+ * @brief SCH_Init_Static of every backend: rows are added between Begin
+ *        and End without the check (row i must get slot i), End checks the
+ *        whole table once and sets ERROR_SCH_NOT_SCHEDULABLE if it fails
+ */
+#if SCH_ADMISSION
+void SCH_Admit_Table_Begin(SCH_Instance_t *SCH);
+void SCH_Admit_Table_End(SCH_Instance_t *SCH);
+#else
+#define SCH_Admit_Table_Begin(SCH)      ((void)0)
+#define SCH_Admit_Table_End(SCH)        ((void)0)
+#endif
+
+/**
+ * @brief Mark the task as deleted: pTask = 0, handle becomes stale - O(1)
+ */
+void SCH_Slot_Kill(SCH_Instance_t *SCH, sch_index_t slot);
+
+/**
+ * @brief Return a killed slot to the free list - O(1)
+ */
+void SCH_Slot_Release(SCH_Instance_t *SCH, sch_index_t slot);
+
+/**
+ * @brief Validate a handle - O(1)
+ * @return Slot, or SCH_NO_SLOT if the handle is invalid or stale
+ */
+sch_index_t SCH_Handle_To_Slot(SCH_Instance_t *SCH, SCH_Handle_t handle);
+
+/**
+ * @brief Call the task in SLOT; timed into its profile when SCH_PROFILE = 1
+ * Used by the dispatchers of both backends.
+ */
+void SCH_Run_Task(SCH_Instance_t *SCH, sch_index_t slot);
+
+/* ==================== DEADLINES (COMMON) ==================== */
+
+/**
+ * @brief Record the tick at which the task in SLOT is next due
+ * Called by the backends whenever they arm a task.
+ */
+void SCH_Set_Due(SCH_Instance_t *SCH, sch_index_t slot, uint32_t due_tick);
+
+/**
+ * @brief Next due tick of the periodic task in SLOT that has just run
+ *        (SCH_REARM), recorded like SCH_Set_Due. Adds any slip of the
+ *        release grid to Phase_Error.
+ * @return Due tick, always after SCH->tick_now
+ */
+uint32_t SCH_Rearm_Due(SCH_Instance_t *SCH, sch_index_t slot);
+
+/**
+ * @brief Check the start time of a release against its due tick, right
+ *        before the dispatcher calls the task. Counts late starts and
+ *        missed periods and applies SCH_CATCHUP_POLICY.
+ * @return 1 = call the task, 0 = skip this release (SCH_CATCHUP_SKIP)
+ */
+uint8_t SCH_Deadline_Check(SCH_Instance_t *SCH, sch_index_t slot);
+
+/**
+ * @brief SCH_CATCHUP_REPLAY: missed releases still to run. While this is
+ *        non-zero the dispatcher runs the task again instead of re-arming it.
+ */
+uint8_t SCH_Replay_Pending(SCH_Instance_t *SCH, sch_index_t slot);
+
+/**
+ * @brief RunMe is already 255 and the task is due again - safe in the ISR
+ */
+void SCH_RunMe_Saturated(SCH_Instance_t *SCH, sch_index_t slot);
+
+/* ==================== PRIORITY CLASSES (COMMON) ==================== */
+
+#if SCH_PRIORITY
+// Cycle counter at the last SCH_Update() (start of the release latency)
+#define SCH_TICK_STAMP()        (SCH->tick_cycles = SCH_Cycles_Now())
+
+/**
+ * @brief Priority class of the task in SLOT
+ */
+uint8_t SCH_Task_Class(SCH_Instance_t *SCH, sch_index_t slot);
+
+/**
+ * @brief Backend hook: the class of the task in SLOT has changed
+ *        (re-file it if the backend keeps tasks sorted by class)
+ */
+void SCH_Class_Changed(SCH_Instance_t *SCH, sch_index_t slot);
+#else
+#define SCH_TICK_STAMP()        ((void)0)
+#define SCH_Task_Class(SCH, slot)   SCH_CLASS_NORMAL
+#endif
+
+#if SCH_SHED
+/**
+ * @brief Shedding decision for one release of work of class CLASS at the
+ *        current shed level; COUNT is its stretch counter
+ * @return 1 if the release is dropped (counted in Shed_Releases)
+ */
+uint8_t SCH_Shed_Drop(SCH_Instance_t *SCH, uint8_t CLASS, uint8_t *COUNT);
+#endif
+
+/* ==================== ISR COMMAND RING ==================== */
+
+/**
+ * @brief Run every command posted by ISRs - start of SCH_Dispatch_Tasks()
+ */
+void SCH_Process_Commands(SCH_Instance_t *SCH);
+
+/**
+ * @brief 1 if ISRs posted commands that are not drained yet
+ */
+uint8_t SCH_Commands_Pending(SCH_Instance_t *SCH);
+
+/* ==================== FAST LANE ==================== */
+
+/**
+ * @brief Empty the fast lane - called by SCH_Init
+ */
+void SCH_Fast_Init(SCH_Instance_t *SCH);
+
+#if SCH_FAST_LANE
+/**
+ * @brief Run every released fast lane task once - start of SCH_Dispatch_Tasks()
+ */
+void SCH_Fast_Dispatch(SCH_Instance_t *SCH);
+
+/**
+ * @brief 1 if a fast lane task is released and has not run yet
+ */
+uint8_t SCH_Fast_Pending(SCH_Instance_t *SCH);
+
+/**
+ * @brief 1 if the fast lane holds any task (SysTick must keep running)
+ */
+uint8_t SCH_Fast_Active(SCH_Instance_t *SCH);
+
+/**
+ * @brief SCH_Delete_Task / SCH_Reschedule_Task for a fast lane handle
+ */
+uint8_t SCH_Fast_Delete(SCH_Instance_t *SCH, SCH_Handle_t TASK_HANDLE);
+uint8_t SCH_Fast_Reschedule(SCH_Instance_t *SCH, SCH_Handle_t TASK_HANDLE, uint32_t DELAY, uint32_t PERIOD);
+#endif
+
+/* ==================== TASK PIPELINES ==================== */
+
+/**
+ * @brief Empty the stage table - called by SCH_Init
+ */
+void SCH_Pipe_Init(SCH_Instance_t *SCH);
+
+#if SCH_PIPELINE
+/**
+ * @brief Run the stages after the task HEAD (its handle before the run)
+ * Called by SCH_Run_Task right after the task, inside its timing.
+ */
+void SCH_Pipeline_Run(SCH_Instance_t *SCH, SCH_Handle_t HEAD);
+
+/**
+ * @brief SCH_Delete_Task for a stage handle (SCH_STAGE_HANDLE)
+ */
+uint8_t SCH_Stage_Delete(SCH_Instance_t *SCH, SCH_Handle_t TASK_HANDLE);
+
+#if SCH_PRIORITY
+/**
+ * @brief SCH_Set_Task_Class for a stage handle (SCH_STAGE_HANDLE)
+ */
+uint8_t SCH_Stage_Set_Class(SCH_Instance_t *SCH, SCH_Handle_t TASK_HANDLE, uint8_t CLASS);
+#endif
+#else
+#define SCH_Pipeline_Run(SCH, HEAD) ((void)0)
+#endif
+
+/* ==================== BACKEND HOOKS (TICKLESS IDLE) ==================== */
+
+// SCH_Idle_Ticks(): nothing is queued, sleep as long as the timer allows
+#define SCH_IDLE_FOREVER        0xFFFFFFFFuL
+
+/**
+ * @brief Ticks until the next task becomes due, counting the tick that
+ *        makes it due (1 = next tick, as without tickless idle)
+ * @return 0 if a task is already due or ticks are waiting to be processed
+ * Must be called with interrupts disabled on the target.
+ */
+uint32_t SCH_Idle_Ticks(SCH_Instance_t *SCH);
+
+/**
+ * @brief Account for TICKS timer ticks that were slept through without
+ *        calling SCH_Update(). TICKS is always < SCH_Idle_Ticks().
+ * Must be called with interrupts disabled on the target.
+ */
+void SCH_Skip_Ticks(SCH_Instance_t *SCH, uint32_t TICKS);
+
+/* ==================== TRACE RECORDER ==================== */
+
+/**
+ * @brief Empty the trace ring and fill in its header - called by SCH_Init
+ */
+void SCH_Trace_Init(void);
+
+// Scheduler trace points; compiled out when SCH_TRACE = 0
+#if SCH_TRACE
+#define SCH_TRACE_RECORD(EVENT, DATA, VALUE) \
+    SCH_Trace_Event((EVENT), (uint16_t)(DATA), (uint8_t)(VALUE))
+#else
+#define SCH_TRACE_RECORD(EVENT, DATA, VALUE) ((void)0)
+#endif
+
+/* ==================== PORT HOOKS (PROFILER) ==================== */
+
+// Units of SCH_Cycles_Now() per second
+#ifdef SCH_HOST_SIM
+#define SCH_CYCLES_PER_SECOND   1000000000uL
+#else
+#define SCH_CYCLES_PER_SECOND   SystemCoreClock
+#endif
+
+// Units of SCH_Cycles_Now() per tick
+#define SCH_CYCLES_PER_TICK     (SCH_CYCLES_PER_SECOND / (1000u / TIMER_TICK_MS))
+
+
+/**
+ * @brief Start the cycle counter (DWT CYCCNT on target) - called by SCH_Init
+ * when SCH_PROFILE, SCH_UTIL, SCH_TRACE or SCH_PRIORITY is on
+ */
+void SCH_Cycle_Counter_Init(void);
+
+/**
+ * @brief Free-running counter: CPU cycles on target, ns on host.
+ * Wraps; only differences of two readings are meaningful.
+ */
+uint32_t SCH_Cycles_Now(void);
+
+/* ==================== PORT HOOKS (MEMORY ORDER) ==================== */
+
+// Orders ring slot writes before the index that publishes them
+#ifdef SCH_HOST_SIM
+#define SCH_MEMORY_BARRIER()    __sync_synchronize()
+#else
+#define SCH_MEMORY_BARRIER()    __DMB()
+#endif
+
+#endif /* INC_SCHEDULER_INTERNAL_H_ */
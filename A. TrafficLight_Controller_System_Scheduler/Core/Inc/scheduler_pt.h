@@ -0,0 +1,91 @@
+/*
+ * scheduler_pt.h
+ * Stackless coroutines (protothreads) for scheduler tasks.
+ *
+ * A long job (flash write, CRC over a config block, formatting a frame)
+ * written as one task blocks every other task until it returns. As a
+ * coroutine it stops at SCH_PT_YIELD() and carries on from that point the
+ * next time the scheduler calls it, so each call does a bounded slice.
+ *
+ * The resume point is kept in a SCH_PT_t (12 bytes) owned by the task;
+ * there is no separate stack. Local variables are NOT kept across a
+ * yield: make them static (or put them in a struct next to the SCH_PT_t).
+ * A switch statement must not contain a yield point, and each source line
+ * holds at most one (the line number is the resume point).
+ *
+ * Usage - CRC of a 4 KB block, 64 bytes per tick:
+ *
+ *   static SCH_PT_t crc_pt;
+ *
+ *   void Task_Crc(void) {
+ *       static uint32_t i;
+ *       SCH_PT_BEGIN(&crc_pt);
+ *       for (i = 0; i < 4096; i++) {
+ *           crc = crc_step(crc, block[i]);
+ *           if ((i & 63) == 63) SCH_PT_YIELD(&crc_pt);
+ *       }
+ *       SCH_PT_END(&crc_pt);           // next call starts over
+ *   }
+ *
+ *   SCH_Add_Task(Task_Crc, 0, 1);                       // resumes every tick
+ *   crc_pt.Task = SCH_Add_Event_Task(Task_Crc, 0);      // or: runs on SCH_Signal,
+ *                                                       // yields resume next tick
+ *
+ * Resuming:
+ *   - Periodic task: at its next due tick
+ *   - Event task (SCH_Add_Event_Task, handle stored in Task): SCH_PT_YIELD
+ *     signals the task itself, so it resumes on the next tick;
+ *     SCH_PT_WAIT_UNTIL / SCH_PT_DELAY wait for the next signal or timeout
+ */
+#ifndef INC_SCHEDULER_PT_H_
+#define INC_SCHEDULER_PT_H_
+
+#include "scheduler.h"
+
+/* ==================== COROUTINE CONTEXT ==================== */
+
+typedef struct {
+    uint16_t Line;              // Resume point (source line), 0 = start
+    SCH_Handle_t Task;          // Own handle if an event task, else SCH_INVALID_HANDLE
+    uint32_t Wake;              // SCH_PT_DELAY: tick to continue at
+} SCH_PT_t;
+
+#define SCH_PT_INIT(PT)         do { (PT)->Line = 0; } while (0)
+
+/* ==================== COROUTINE BODY ==================== */
+
+// First statement of the task
+#define SCH_PT_BEGIN(PT)        switch ((PT)->Line) { case 0:
+
+// Last statement of the task: the next call starts from SCH_PT_BEGIN
+#define SCH_PT_END(PT)          } (PT)->Line = 0; return
+
+// Return now; continue after this point on the next call
+#define SCH_PT_YIELD(PT)                                                        \
+    do {                                                                        \
+        (PT)->Line = (uint16_t)__LINE__;                                        \
+        (void)SCH_Signal((PT)->Task);                                           \
+        return;                                                                 \
+        case __LINE__:;                                                         \
+    } while (0)
+
+// Return on every call until COND holds, then continue
+#define SCH_PT_WAIT_UNTIL(PT, COND)                                             \
+    do {                                                                        \
+        (PT)->Line = (uint16_t)__LINE__;                                        \
+        __attribute__((fallthrough));                                           \
+        case __LINE__:                                                          \
+        if (!(COND)) return;                                                    \
+    } while (0)
+
+// Wait at least TICKS ticks (checked each time the task is called)
+#define SCH_PT_DELAY(PT, TICKS)                                                 \
+    do {                                                                        \
+        (PT)->Wake = SCH_Get_Tick() + (uint32_t)(TICKS);                        \
+        SCH_PT_WAIT_UNTIL(PT, (int32_t)(SCH_Get_Tick() - (PT)->Wake) >= 0);     \
+    } while (0)
+
+// Stop here; the next call starts from SCH_PT_BEGIN
+#define SCH_PT_RESTART(PT)      do { (PT)->Line = 0; return; } while (0)
+
+#endif /* INC_SCHEDULER_PT_H_ */
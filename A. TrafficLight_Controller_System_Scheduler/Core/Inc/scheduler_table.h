@@ -0,0 +1,140 @@
+/*
+ * scheduler_table.h
+ * Start-up task set declared as a const table (placed in flash).
+ *
+ * The queue order and MARKING of the table are computed by the compiler,
+ * so SCH_Init_Static() only copies them - no clearing loop and no
+ * insertion sort at boot. RAM holds only what changes at run time
+ * (the slot table entries and queue indices of the tasks in the table).
+ *
+ * Usage (one table per program, at file scope):
+ *
+ *   SCH_TASK_TABLE(app_tasks,
+ *       (Task_Traffic_FSM,    0, TASK_FSM_PERIOD),
+ *       (Task_Update_Display, 0, TASK_DISPLAY_PERIOD));
+ *
+ *   int main(void) {
+ *       ...
+ *       SCH_Init_Static(&app_tasks);   // instead of SCH_Init + SCH_Add_Task
+ *       SCH_Add_Lane_Task(SCH_LANE_FAST, Task_Button_Scan, 0, TASK_BUTTON_PERIOD_MS);
+ *   }
+ *
+ * Each row is (function, delay, period), same meaning as SCH_Add_Task.
+ * Delay and period must be compile-time constants. Up to 16 rows. Row i
+ * gets slot i, so its handle is SCH_TABLE_HANDLE(i) (e.g. to set its
+ * priority class after SCH_Init_Static). With SCH_COMPACT they must not exceed
+ * SCH_MAX_PERIOD; table rows are not checked at run time. MARKING is
+ * not copied with SCH_COMPACT (the sorted backend has none).
+ * The table only fills the tick lane; fast lane tasks (SCH_FAST_LANE) are
+ * added after SCH_Init_Static().
+ */
+#ifndef INC_SCHEDULER_TABLE_H_
+#define INC_SCHEDULER_TABLE_H_
+
+#include "scheduler.h"
+
+/* ==================== TABLE DECLARATION ==================== */
+
+#define SCH_TASK_TABLE(NAME, ...)                                               \
+    static const SCH_Task_Config_t NAME##_tasks[] = {                           \
+        SCH_FE_A(SCH_ROW_CONFIG, ~, __VA_ARGS__)                                \
+    };                                                                          \
+    static const sch_index_t NAME##_order[] = {                                 \
+        SCH_FE_A(SCH_ROW_ORDER, (__VA_ARGS__), __VA_ARGS__)                     \
+    };                                                                          \
+    static const uint8_t NAME##_marking[] = {                                   \
+        SCH_FE_A(SCH_ROW_MARKING, (__VA_ARGS__), __VA_ARGS__)                   \
+    };                                                                          \
+    _Static_assert(sizeof(NAME##_tasks) / sizeof(NAME##_tasks[0]) <= SCH_MAX_TASKS, \
+                   "SCH_TASK_TABLE " #NAME ": more rows than SCH_MAX_TASKS");   \
+    const SCH_Task_Table_t NAME = {                                             \
+        NAME##_tasks, NAME##_order, NAME##_marking,                             \
+        (uint8_t)(sizeof(NAME##_tasks) / sizeof(NAME##_tasks[0]))               \
+    }
+
+// Handle of row ROW of the table loaded by SCH_Init_Static()
+#if SCH_COMPACT
+#define SCH_TABLE_HANDLE(ROW)   ((SCH_Handle_t)(((uint32_t)SCH_task_gen_G[(ROW)] << 16) | (uint32_t)(ROW)))
+#else
+#define SCH_TABLE_HANDLE(ROW)   ((SCH_Handle_t)SCH_tasks_G[(ROW)].TaskID)
+#endif
+
+/* ==================== ROW HELPERS (INTERNAL) ==================== */
+
+// Fields of a row (function, delay, period)
+#define SCH_ROW_DELAY(ROW)          SCH_ROW_DELAY_ ROW
+#define SCH_ROW_DELAY_(F, D, P)     (D)
+#define SCH_ROW_CFG_(F, D, P)       { F, (D), (P) },
+
+// Row I goes to slot I
+#define SCH_ROW_CONFIG(I, ROW, ALL) SCH_ROW_CFG_ ROW
+
+// Queue position of row I: rows with a smaller delay, plus earlier rows
+// with the same delay (same tie rule as SCH_Add_Task)
+#define SCH_ROW_RANK(I, ROW, ALL)                                               \
+    (0 SCH_FE_B(SCH_ROW_BEFORE, (I, SCH_ROW_DELAY(ROW)), SCH_PP_STRIP ALL))
+#define SCH_ROW_BEFORE(J, ROW, CTX) SCH_ROW_BEFORE_(J, SCH_ROW_DELAY(ROW), SCH_PP_STRIP CTX)
+#define SCH_ROW_BEFORE_(...)        SCH_ROW_BEFORE__(__VA_ARGS__)
+#define SCH_ROW_BEFORE__(J, DJ, I, DI) + ((DJ) < (DI) || ((DJ) == (DI) && (J) < (I)))
+
+// Rows with the smallest delay are marked (same delay as the queue head)
+#define SCH_ROW_EARLIER(J, ROW, DI) + (SCH_ROW_DELAY(ROW) < (DI))
+
+#define SCH_ROW_ORDER(I, ROW, ALL)   [SCH_ROW_RANK(I, ROW, ALL)] = (I),
+#define SCH_ROW_MARKING(I, ROW, ALL)                                            \
+    [SCH_ROW_RANK(I, ROW, ALL)] =                                               \
+        ((0 SCH_FE_B(SCH_ROW_EARLIER, SCH_ROW_DELAY(ROW), SCH_PP_STRIP ALL)) == 0),
+
+/* ==================== PREPROCESSOR FOR-EACH (INTERNAL) ==================== */
+/*
+ * SCH_FE_x(M, CTX, a, b, c) → M(0, a, CTX) M(1, b, CTX) M(2, c, CTX)
+ * Two identical copies (A outer, B inner) because a macro cannot expand
+ * inside its own expansion.
+ */
+#define SCH_PP_STRIP(...)           __VA_ARGS__
+#define SCH_PP_CAT(A, B)            SCH_PP_CAT_(A, B)
+#define SCH_PP_CAT_(A, B)           A##B
+#define SCH_PP_NARGS(...)           SCH_PP_NARGS_(__VA_ARGS__, 16, 15, 14, 13, 12, 11, 10, \
+                                                  9, 8, 7, 6, 5, 4, 3, 2, 1, 0)
+#define SCH_PP_NARGS_(_1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11, _12, _13, _14, \
+                      _15, _16, N, ...) N
+
+#define SCH_FE_A(M, C, ...)         SCH_FE_A_(SCH_PP_NARGS(__VA_ARGS__), M, C, __VA_ARGS__)
+#define SCH_FE_A_(N, M, C, ...)     SCH_PP_CAT(SCH_FE_A_, N)(M, C, 0, __VA_ARGS__)
+#define SCH_FE_A_1(M, C, I, X)      M(I, X, C)
+#define SCH_FE_A_2(M, C, I, X, ...) M(I, X, C) SCH_FE_A_1(M, C, I + 1, __VA_ARGS__)
+#define SCH_FE_A_3(M, C, I, X, ...) M(I, X, C) SCH_FE_A_2(M, C, I + 1, __VA_ARGS__)
+#define SCH_FE_A_4(M, C, I, X, ...) M(I, X, C) SCH_FE_A_3(M, C, I + 1, __VA_ARGS__)
+#define SCH_FE_A_5(M, C, I, X, ...) M(I, X, C) SCH_FE_A_4(M, C, I + 1, __VA_ARGS__)
+#define SCH_FE_A_6(M, C, I, X, ...) M(I, X, C) SCH_FE_A_5(M, C, I + 1, __VA_ARGS__)
+#define SCH_FE_A_7(M, C, I, X, ...) M(I, X, C) SCH_FE_A_6(M, C, I + 1, __VA_ARGS__)
+#define SCH_FE_A_8(M, C, I, X, ...) M(I, X, C) SCH_FE_A_7(M, C, I + 1, __VA_ARGS__)
+#define SCH_FE_A_9(M, C, I, X, ...) M(I, X, C) SCH_FE_A_8(M, C, I + 1, __VA_ARGS__)
+#define SCH_FE_A_10(M, C, I, X, ...) M(I, X, C) SCH_FE_A_9(M, C, I + 1, __VA_ARGS__)
+#define SCH_FE_A_11(M, C, I, X, ...) M(I, X, C) SCH_FE_A_10(M, C, I + 1, __VA_ARGS__)
+#define SCH_FE_A_12(M, C, I, X, ...) M(I, X, C) SCH_FE_A_11(M, C, I + 1, __VA_ARGS__)
+#define SCH_FE_A_13(M, C, I, X, ...) M(I, X, C) SCH_FE_A_12(M, C, I + 1, __VA_ARGS__)
+#define SCH_FE_A_14(M, C, I, X, ...) M(I, X, C) SCH_FE_A_13(M, C, I + 1, __VA_ARGS__)
+#define SCH_FE_A_15(M, C, I, X, ...) M(I, X, C) SCH_FE_A_14(M, C, I + 1, __VA_ARGS__)
+#define SCH_FE_A_16(M, C, I, X, ...) M(I, X, C) SCH_FE_A_15(M, C, I + 1, __VA_ARGS__)
+
+#define SCH_FE_B(M, C, ...)         SCH_FE_B_(SCH_PP_NARGS(__VA_ARGS__), M, C, __VA_ARGS__)
+#define SCH_FE_B_(N, M, C, ...)     SCH_PP_CAT(SCH_FE_B_, N)(M, C, 0, __VA_ARGS__)
+#define SCH_FE_B_1(M, C, I, X)      M(I, X, C)
+#define SCH_FE_B_2(M, C, I, X, ...) M(I, X, C) SCH_FE_B_1(M, C, I + 1, __VA_ARGS__)
+#define SCH_FE_B_3(M, C, I, X, ...) M(I, X, C) SCH_FE_B_2(M, C, I + 1, __VA_ARGS__)
+#define SCH_FE_B_4(M, C, I, X, ...) M(I, X, C) SCH_FE_B_3(M, C, I + 1, __VA_ARGS__)
+#define SCH_FE_B_5(M, C, I, X, ...) M(I, X, C) SCH_FE_B_4(M, C, I + 1, __VA_ARGS__)
+#define SCH_FE_B_6(M, C, I, X, ...) M(I, X, C) SCH_FE_B_5(M, C, I + 1, __VA_ARGS__)
+#define SCH_FE_B_7(M, C, I, X, ...) M(I, X, C) SCH_FE_B_6(M, C, I + 1, __VA_ARGS__)
+#define SCH_FE_B_8(M, C, I, X, ...) M(I, X, C) SCH_FE_B_7(M, C, I + 1, __VA_ARGS__)
+#define SCH_FE_B_9(M, C, I, X, ...) M(I, X, C) SCH_FE_B_8(M, C, I + 1, __VA_ARGS__)
+#define SCH_FE_B_10(M, C, I, X, ...) M(I, X, C) SCH_FE_B_9(M, C, I + 1, __VA_ARGS__)
+#define SCH_FE_B_11(M, C, I, X, ...) M(I, X, C) SCH_FE_B_10(M, C, I + 1, __VA_ARGS__)
+#define SCH_FE_B_12(M, C, I, X, ...) M(I, X, C) SCH_FE_B_11(M, C, I + 1, __VA_ARGS__)
+#define SCH_FE_B_13(M, C, I, X, ...) M(I, X, C) SCH_FE_B_12(M, C, I + 1, __VA_ARGS__)
+#define SCH_FE_B_14(M, C, I, X, ...) M(I, X, C) SCH_FE_B_13(M, C, I + 1, __VA_ARGS__)
+#define SCH_FE_B_15(M, C, I, X, ...) M(I, X, C) SCH_FE_B_14(M, C, I + 1, __VA_ARGS__)
+#define SCH_FE_B_16(M, C, I, X, ...) M(I, X, C) SCH_FE_B_15(M, C, I + 1, __VA_ARGS__)
+
+#endif /* INC_SCHEDULER_TABLE_H_ */
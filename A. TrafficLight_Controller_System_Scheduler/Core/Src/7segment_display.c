@@ -10,18 +10,18 @@
  * Hàm cập nhật toàn bộ màn hình LED 7 đoạn
  *
  * Logic hoạt động:
- * - Kiểm tra mode hiện tại
+ * - Kiểm tra mode trong bản chụp
  * - Hiển thị thông tin tương ứng với từng mode
  */
-void update_7seg_display(void)
+void update_7seg_display(const traffic_view_t *view)
 {
     // ============ CHẾ ĐỘ HOẠT ĐỘNG BÌNH THƯỜNG ============
-    if (current_mode == MODE_1_NORMAL)
+    if (view->mode == MODE_1_NORMAL)
     {
         // Hiển thị thời gian đếm ngược của đèn giao thông
 
-        display_7seg_left(counter_road1);  // Bên trái: thời gian đường 1
-        display_7seg_right(counter_road2); // Bên phải: thời gian đường 2
+        display_7seg_left(view->counter_road1);  // Bên trái: thời gian đường 1
+        display_7seg_right(view->counter_road2); // Bên phải: thời gian đường 2
         display_7seg_mode(1);              // Hiển thị số mode = 1
     }
     // ============ CÁC CHẾ ĐỘ ĐIỀU CHỈNH ============
@@ -31,9 +31,9 @@ void update_7seg_display(void)
         // - Cả 2 bên đều hiển thị giá trị đang điều chỉnh
         // - Người dùng có thể thấy rõ giá trị mới đang được thiết lập
 
-        display_7seg_left(temp_duration);  // Bên trái: giá trị tạm thời
-        display_7seg_right(temp_duration); // Bên phải: giá trị tạm thời (giống bên trái)
-        display_7seg_mode(current_mode);   // Hiển thị số mode hiện tại (2, 3, hoặc 4)
+        display_7seg_left(view->temp_duration);  // Bên trái: giá trị tạm thời
+        display_7seg_right(view->temp_duration); // Bên phải: giá trị tạm thời (giống bên trái)
+        display_7seg_mode(view->mode);           // Hiển thị số mode hiện tại (2, 3, hoặc 4)
     }
 }
 
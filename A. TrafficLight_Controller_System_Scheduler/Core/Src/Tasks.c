@@ -7,16 +7,19 @@
 
 #include "tasks.h"
 
+// Bản chụp FSM → Display (ghi bởi Task_Traffic_FSM)
+traffic_view_t traffic_view;
+
 /* ============================================================================
  * TASK 1: BUTTON SCANNING
  * ============================================================================
  * Mục đích: Quét và xử lý trạng thái nút nhấn
- * Tần suất: 10ms (PERIOD = 1)
+ * Tần suất: 5ms (làn nhanh SysTick 1ms, TASK_BUTTON_PERIOD_MS)
  * Độ ưu tiên: CAO - Phải chạy nhanh để phát hiện nhấn chính xác
  * ============================================================================ */
 
 /**
- * Task_Button_Scan - Quét nút nhấn mỗi 10ms
+ * Task_Button_Scan - Quét nút nhấn mỗi 5ms
  *
  * Chức năng:
  * - Đọc trạng thái GPIO của 3 nút (MODE, MODIFY, SET)
@@ -25,7 +28,8 @@
  * - Cập nhật các cờ button_flag[] và button_long_pressed[]
  *
  * Lưu ý:
- * - Task này PHẢI chạy mỗi 10ms (không được chậm hơn)
+ * - Task này PHẢI chạy đúng BUTTON_SCAN_MS (các bộ đếm trong button.c
+ *   tính theo số lần quét)
  * - Nếu chạy chậm → nút nhấn sẽ bị miss
  */
 void Task_Button_Scan(void)
@@ -55,23 +59,26 @@ void Task_Button_Scan(void)
  *
  * Lưu ý:
  * - Task này chứa toàn bộ logic điều khiển
- * - Không tự cập nhật LED/7-segment
+ * - Không tự cập nhật LED/7-segment: chụp trạng thái vào traffic_view,
+ *   stage Display vẽ ngay sau trong cùng tick
  */
 void Task_Traffic_FSM(void)
 {
-    traffic_run();  // Hàm từ fsm_traffic.c - xử lý toàn bộ FSM
+    traffic_run();                  // Hàm từ fsm_traffic.c - xử lý toàn bộ FSM
+    traffic_snapshot(&traffic_view);
 }
 
 /* ============================================================================
  * TASK 3: UPDATE DISPLAY
  * ============================================================================
  * Mục đích: Cập nhật hiển thị LED và LED 7 đoạn
- * Tần suất: 50ms (PERIOD = 5) - Có thể điều chỉnh
- * Độ ưu tiên: TRUNG BÌNH - Không cần cập nhật quá nhanh
+ * Tần suất: mỗi lần FSM chạy (10ms) - stage ngay sau FSM (SCH_PIPELINE)
+ *           50ms (PERIOD = 5) nếu không có pipeline
+ * Độ ưu tiên: theo task FSM (cùng chuỗi)
  * ============================================================================ */
 
 /**
- * Task_Update_Display - Cập nhật phần cứng hiển thị
+ * Stage_Update_Display - Cập nhật phần cứng hiển thị từ bản chụp của FSM
  *
  * Chức năng:
  * - Cập nhật 6 LED đèn giao thông (đỏ, vàng, xanh x 2 đường)
@@ -79,19 +86,38 @@ void Task_Traffic_FSM(void)
  * - Cập nhật LED mode (hiển thị chế độ hiện tại)
  *
  * Tối ưu hóa:
- * - PERIOD = 5 (50ms): Cân bằng giữa mượt mà và hiệu năng ✅ RECOMMENDED
- * - PERIOD = 2 (20ms): Mượt hơn, tốn CPU hơn
- * - PERIOD = 10 (100ms): Tiết kiệm CPU, nhưng có thể thấy giật
+ * - Chạy ngay sau FSM trong cùng tick → nút nhấn tới đèn trong 1 tick
+ * - Bản chụp giống lần vẽ trước → không ghi GPIO (LED và 7 đoạn BCD
+ *   giữ nguyên mức) → phần lớn các tick gần như không tốn CPU
  *
  * Lưu ý:
  * - Task này chỉ HIỂN THỊ, không xử lý logic
- * - Logic đã được xử lý trong Task_Traffic_FSM
+ * - Chỉ đọc IN (bản chụp), không đọc biến toàn cục của FSM
  */
-void Task_Update_Display(void)
+void Stage_Update_Display(const void *IN, void *OUT)
 {
+    static traffic_view_t shown;    // Bản chụp đã vẽ lần trước
+    static int shown_valid = 0;
+    const traffic_view_t *view = (const traffic_view_t *)IN;
+
+    if (shown_valid && memcmp(view, &shown, sizeof(shown)) == 0) {
+        return;                     // Không có gì thay đổi
+    }
+
     // Cập nhật LED đơn (đèn giao thông)
-    update_led_display();    // Hàm từ led_display.c
+    update_led_display(view);       // Hàm từ led_display.c
 
     // Cập nhật LED 7 đoạn (đồng hồ đếm ngược)
-    update_7seg_display();   // Hàm từ 7segment_display.c
+    update_7seg_display(view);      // Hàm từ 7segment_display.c
+
+    shown = *view;
+    shown_valid = 1;
+}
+
+/**
+ * Task_Update_Display - SCH_PIPELINE = 0: task riêng mỗi 50ms
+ */
+void Task_Update_Display(void)
+{
+    Stage_Update_Display(&traffic_view, 0);
 }
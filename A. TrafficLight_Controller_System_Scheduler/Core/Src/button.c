@@ -8,10 +8,10 @@
  * 2. SHORT PRESS: Phát hiện nhấn nhanh
  * 3. LONG PRESS: Phát hiện nhấn giữ (sau 1 giây)
  *
- * THỜI GIAN:
- * - Hàm getKeyInput() được gọi mỗi 10ms trong timer interrupt
- * - Debounce time = 3 lần x 10ms = 30ms
- * - Long press = 100 lần x 10ms = 1000ms (1 giây)
+ * THỜI GIAN (BUTTON_SCAN_MS = 5, làn nhanh của scheduler):
+ * - Hàm getKeyInput() được gọi mỗi BUTTON_SCAN_MS
+ * - Debounce time = 3 lần x 5ms = 15ms
+ * - Long press = BUTTON_LONG_PRESS_COUNT lần = 1000ms (1 giây)
  * ================================================================== */
 
 // ==================================================================
@@ -25,8 +25,8 @@ int KeyReg2[3] = {NORMAL_STATE, NORMAL_STATE, NORMAL_STATE};
 int KeyReg3[3] = {NORMAL_STATE, NORMAL_STATE, NORMAL_STATE};
 
 // Bộ đếm thời gian cho long press
-// 100 lần gọi x 10ms = 1000ms (1 giây)
-int TimeOutForKeyPress[3] = {100, 100, 100};
+// BUTTON_LONG_PRESS_COUNT lần gọi = 1000ms (1 giây)
+int TimeOutForKeyPress[3] = {BUTTON_LONG_PRESS_COUNT, BUTTON_LONG_PRESS_COUNT, BUTTON_LONG_PRESS_COUNT};
 
 // Cờ báo hiệu nút được nhấn (short press)
 int button_flag[3] = {0, 0, 0};
@@ -35,7 +35,7 @@ int button_flag[3] = {0, 0, 0};
 int button_long_pressed[3] = {0, 0, 0};
 
 // Bộ đếm khởi động - BỎ QUA NÚT TRONG 100ms ĐẦU
-int startup_counter = 10;  // 10 lần x 10ms = 100ms
+int startup_counter = BUTTON_STARTUP_COUNT;  // 100ms
 
 /* ==================================================================
  * HÀM KIỂM TRA TRẠNG THÁI NÚT (GỌI TRONG MAIN)
@@ -111,7 +111,7 @@ void subKeyProcess(int index)
 }
 
 /* ==================================================================
- * HÀM CHÍNH - ĐỌC VÀ XỬ LÝ NÚT BẤM (GỌI TRONG TIMER INTERRUPT)
+ * HÀM CHÍNH - ĐỌC VÀ XỬ LÝ NÚT BẤM (TASK BUTTON_SCAN, MỖI BUTTON_SCAN_MS)
  * ================================================================== */
 
 void getKeyInput()
@@ -153,7 +153,7 @@ void getKeyInput()
         if (KeyReg3[i] == PRESSED_STATE)
         {
           subKeyProcess(i);
-          TimeOutForKeyPress[i] = 100;  // 100 x 10ms = 1000ms
+          TimeOutForKeyPress[i] = BUTTON_LONG_PRESS_COUNT;  // 1000ms
         }
       }
       else
@@ -163,7 +163,7 @@ void getKeyInput()
 
         if (TimeOutForKeyPress[i] == 0)
         {
-          TimeOutForKeyPress[i] = 100;  // Reset về 1 giây
+          TimeOutForKeyPress[i] = BUTTON_LONG_PRESS_COUNT;  // Reset về 1 giây
 
           if (KeyReg3[i] == PRESSED_STATE)
           {
@@ -87,8 +87,9 @@ void traffic_init(void)
  * THỨ TỰ THỰC THI (QUAN TRỌNG):
  * 1. update_button_state()   → Đọc trạng thái nút nhấn
  * 2. fsm_*_mode()            → Xử lý logic theo chế độ hiện tại
- * 3. update_led_display()    → Cập nhật phần cứng LED
- * 4. update_7seg_display()   → Cập nhật màn hình 7 đoạn
+ *
+ * KHÔNG tự cập nhật LED / 7 đoạn: task FSM chụp trạng thái
+ * (traffic_snapshot) và stage Display vẽ ngay sau, trong cùng tick
  *
  * TỐC ĐỘ GỌI: 100 lần/giây = 100Hz
  */
@@ -115,12 +116,25 @@ void traffic_run(void)
             fsm_green_modify_mode();  // Điều chỉnh thời gian XANH
             break;
     }
+}
 
-    // Bước 3: Cập nhật phần cứng LED
-    update_led_display();
-
-    // Bước 4: Cập nhật màn hình 7 đoạn
-    update_7seg_display();
+/**
+ * traffic_snapshot() - Chụp những gì phần hiển thị cần
+ *
+ * Gọi ngay sau traffic_run() → bản chụp của đúng bước FSM vừa chạy
+ */
+void traffic_snapshot(traffic_view_t *view)
+{
+    view->mode = current_mode;
+    view->state = traffic_state;
+    view->counter_road1 = counter_road1;
+    view->counter_road2 = counter_road2;
+    view->temp_duration = temp_duration;
+    for (int i = 0; i < 2; i++) {
+        view->flagRed[i] = flagRed[i];
+        view->flagGreen[i] = flagGreen[i];
+        view->flagYellow[i] = flagYellow[i];
+    }
 }
 
 /* ============================================================================
@@ -14,19 +14,19 @@
  * Hàm cập nhật hiển thị LED dựa trên chế độ hiện tại
  *
  * Logic:
- * - MODE_1_NORMAL: Hiển thị đèn giao thông theo traffic_state
+ * - MODE_1_NORMAL: Hiển thị đèn giao thông theo view->state
  * - MODE 2/3/4: Hiển thị LED nhấp nháy dựa trên các flag
  *
- * Được gọi: Liên tục trong vòng lặp chính hoặc từ timer
+ * Được gọi: stage Display, ngay sau task FSM (view = bản chụp của FSM)
  */
-void update_led_display(void)
+void update_led_display(const traffic_view_t *view)
 {
     // ============ CHẾ ĐỘ HOẠT ĐỘNG BÌNH THƯỜNG ============
-    if (current_mode == MODE_1_NORMAL)
+    if (view->mode == MODE_1_NORMAL)
     {
         // Hiển thị đèn giao thông theo trạng thái finite state machine
 
-        switch (traffic_state)
+        switch (view->state)
         {
         case INIT:               // Trạng thái khởi tạo
             turn_off_all_leds(); // Tắt hết tất cả LED
@@ -60,16 +60,16 @@ void update_led_display(void)
         // Các flag này được thay đổi mỗi 500ms để tạo hiệu ứng nhấp nháy
 
         // Cập nhật đèn đỏ cả 2 đường
-        displayLED_RED(flagRed[0], 0); // Đèn đỏ đường 1
-        displayLED_RED(flagRed[1], 1); // Đèn đỏ đường 2
+        displayLED_RED(view->flagRed[0], 0); // Đèn đỏ đường 1
+        displayLED_RED(view->flagRed[1], 1); // Đèn đỏ đường 2
 
         // Cập nhật đèn vàng cả 2 đường
-        displayLED_YELLOW(flagYellow[0], 0); // Đèn vàng đường 1
-        displayLED_YELLOW(flagYellow[1], 1); // Đèn vàng đường 2
+        displayLED_YELLOW(view->flagYellow[0], 0); // Đèn vàng đường 1
+        displayLED_YELLOW(view->flagYellow[1], 1); // Đèn vàng đường 2
 
         // Cập nhật đèn xanh cả 2 đường
-        displayLED_GREEN(flagGreen[0], 0); // Đèn xanh đường 1
-        displayLED_GREEN(flagGreen[1], 1); // Đèn xanh đường 2
+        displayLED_GREEN(view->flagGreen[0], 0); // Đèn xanh đường 1
+        displayLED_GREEN(view->flagGreen[1], 1); // Đèn xanh đường 2
     }
 }
 
@@ -7,7 +7,8 @@
   ******************************************************************************
   * KIẾN TRÚC MỚI:
   * - Không còn gọi traffic_run() trực tiếp trong timer interrupt
-  * - Sử dụng SCH_Add_Task() để thêm các task vào scheduler
+  * - Các task khởi động khai báo trong bảng const app_tasks (nằm trong flash)
+  *   và nạp bằng SCH_Init_Static(); SCH_Add_Task() vẫn dùng được lúc chạy
   * - Timer interrupt chỉ gọi SCH_Update() (O(1) - rất nhanh!)
   * - Main loop gọi SCH_Dispatch_Tasks() để thực thi task
   ******************************************************************************
@@ -20,6 +21,7 @@
 /* Private includes ----------------------------------------------------------*/
 /* USER CODE BEGIN Includes */
 #include "scheduler.h"         // Thư viện Cooperative Scheduler
+#include "scheduler_table.h"   // Bảng task khởi động (SCH_TASK_TABLE)
 #include "button.h"            // Thư viện xử lý nút nhấn
 #include "fsm_traffic.h"       // Thư viện FSM điều khiển đèn giao thông
 #include "tasks.h"        // Tất cả task functions
@@ -28,6 +30,30 @@
 /* Private variables ---------------------------------------------------------*/
 TIM_HandleTypeDef htim2;    // Biến quản lý Timer 2
 
+/* ========== CORE TASKS - BẮT BUỘC PHẢI CÓ =============== */
+
+/**
+ * Bảng task khởi động - const → nằm trong flash, thứ tự hàng đợi
+ * và MARKING được trình biên dịch tính sẵn (xem scheduler_table.h)
+ *
+ * Task 1: Button Scanning (làn nhanh, thêm sau SCH_Init_Static)
+ * - Quét nút nhấn mỗi 5ms theo SysTick 1ms
+ *
+ * Task 2: Traffic FSM (lớp CRITICAL)
+ * - Chạy máy trạng thái đèn giao thông mỗi 10ms, chụp traffic_view
+ * - Xử lý logic chuyển đèn và mode
+ * - Không bao giờ bị giảm tải (SCH_SHED) → đếm ngược 1 giây luôn đúng
+ *
+ * Task 3: Update Display (stage sau FSM, thêm sau SCH_Init_Static)
+ * - Chạy ngay sau FSM trong cùng tick với bản chụp traffic_view
+ *   → nút nhấn (làn nhanh chạy trước FSM) tới đèn trong 1 tick
+ * - Chỉ ghi GPIO khi bản chụp thay đổi
+ * - Stage lớp BACKGROUND: thời gian tính cho FSM nhưng quá tải → Display
+ *   bị giảm tải (bỏ bớt lần vẽ), FSM vẫn chạy mỗi tick
+ * - SCH_PIPELINE = 0: task riêng mỗi 50ms (lớp BACKGROUND, giảm tải được)
+ */
+SCH_TASK_TABLE(app_tasks,
+    (Task_Traffic_FSM,    0, TASK_FSM_PERIOD));
 
 /* Private function prototypes -----------------------------------------------*/
 void SystemClock_Config(void);
@@ -76,38 +102,45 @@ int main(void)
 
   /* ==================== KHỞI TẠO HỆ THỐNG ==================== */
 
-  // 1. Khởi tạo Scheduler
-  SCH_Init();
+  // 1. Khởi tạo Scheduler + nạp các task trong bảng app_tasks
+  SCH_Init_Static(&app_tasks);
+
+#if SCH_FAST_LANE
+  // Quét nút ở làn nhanh (SysTick 1ms, SCH_Fast_Update trong SysTick_Handler)
+  SCH_Add_Lane_Task(SCH_LANE_FAST, Task_Button_Scan, 0, TASK_BUTTON_PERIOD_MS);
+#else
+  // Không có làn nhanh: quét nút ở làn tick (BUTTON_SCAN_MS = 1 tick)
+  SCH_Add_Task(Task_Button_Scan, 0, TASK_BUTTON_PERIOD);
+#endif
+
+#if SCH_PIPELINE
+  // Pipeline Button → FSM → Display: FSM ghi traffic_view, Display vẽ nó
+  // ngay sau FSM (không phụ thuộc thứ tự hàng đợi)
+  SCH_Set_Task_Output(SCH_TABLE_HANDLE(0), &traffic_view);
+#if SCH_PRIORITY
+  // Thời gian của Display tính chung cho FSM (profile, WCET), nhưng stage
+  // có lớp riêng: quá tải → Display bị giảm tải, FSM (CRITICAL) giữ nhịp
+  SCH_Set_Task_Class(SCH_Add_Stage(Stage_Update_Display, SCH_TABLE_HANDLE(0), 0),
+                     SCH_CLASS_BACKGROUND);
+#else
+  SCH_Add_Stage(Stage_Update_Display, SCH_TABLE_HANDLE(0), 0);
+#endif
+#elif SCH_PRIORITY
+  // Không có pipeline: Display là task riêng mỗi 50ms, nhường FSM
+  SCH_Set_Task_Class(SCH_Add_Task(Task_Update_Display, 0, TASK_DISPLAY_PERIOD),
+                     SCH_CLASS_BACKGROUND);
+#else
+  SCH_Add_Task(Task_Update_Display, 0, TASK_DISPLAY_PERIOD);
+#endif
+
+#if SCH_PRIORITY
+  // FSM (hàng 0) không bao giờ phải chờ task khác cùng đến hạn
+  SCH_Set_Task_Class(SCH_TABLE_HANDLE(0), SCH_CLASS_CRITICAL);
+#endif
 
   // 2. Khởi tạo hệ thống đèn giao thông
   traffic_init();
 
-  /* ========== CORE TASKS - BẮT BUỘC PHẢI CÓ =============== */
-
-   /**
-    * Task 1: Button Scanning
-    * - Quét nút nhấn mỗi 10ms
-    */
-   SCH_Add_Task(Task_Button_Scan, 0, TASK_BUTTON_PERIOD);
-
-   /**
-    * Task 2: Traffic FSM
-    * - Chạy máy trạng thái đèn giao thông mỗi 10ms
-    * - Xử lý logic chuyển đèn và mode
-    */
-   SCH_Add_Task(Task_Traffic_FSM, 0, TASK_FSM_PERIOD);
-
-   /**
-    * Task 3: Update Display
-    * - Cập nhật LED và 7-segment mỗi 50ms
-    * - TÙYCHỈNH: Có thể thay đổi TASK_DISPLAY_PERIOD trong tasks.h
-    *   + 20ms: Mượt hơn nhưng tốn CPU
-    *   + 50ms: Cân bằng (RECOMMENDED) ✅
-    *   + 100ms: Tiết kiệm CPU
-    */
-   SCH_Add_Task(Task_Update_Display, 0, TASK_DISPLAY_PERIOD);
-
-
   // 3. Bật Timer interrupt
   HAL_TIM_Base_Start_IT(&htim2);
 
@@ -132,7 +165,11 @@ int main(void)
      */
     SCH_Dispatch_Tasks();
 
-    // SCH_Go_To_Sleep();
+    /**
+     * SCH_Go_To_Sleep() - Ngủ tới deadline kế tiếp (tickless idle)
+     * TIM2 được kéo dài tới lúc task kế tiếp đến giờ → không ngắt thừa
+     */
+    SCH_Go_To_Sleep();
 
   }
   /* USER CODE END 3 */
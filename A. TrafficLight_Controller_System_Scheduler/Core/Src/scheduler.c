@@ -8,517 +8,2449 @@
  * - SCH_Update() chạy trong O(1) → Nhanh trong interrupt
  * - Mảng task luôn được sắp xếp theo delay tăng dần
  * - Hỗ trợ cả periodic và one-shot tasks
+ *
+ * BACKEND:
+ * - File này chứa backend MẢNG SẮP XẾP (SCH_BACKEND_SORTED_ARRAY)
+ * - Backend TIMING WHEEL nằm trong scheduler_wheel.c
+ * - Backend CYCLIC EXECUTIVE nằm trong scheduler_cyclic.c
+ * - Bảng slot + handle và các hàm dùng chung nằm đầu/cuối file
+ *
+ * HANDLE:
+ * - SCH->tasks[] (SCH_COMPACT: các mảng SCH->task_xxx[]) là BẢNG SLOT: task nằm
+ *   cố định ở 1 slot cho tới khi bị xóa
+ * - Handle = (generation << 16) | slot, generation tăng mỗi lần slot được
+ *   dùng lại → handle cũ (task đã xóa) bị từ chối thay vì xóa nhầm task khác
+ * ============================================================================
+ */
+
+#include "scheduler.h"
+#include "scheduler_internal.h"
+
+/* ==================== TRẠNG THÁI (SCH_Instance_t) ==================== */
+
+// Mọi biến của scheduler nằm trong 1 SCH_Instance_t (scheduler_instance.h),
+// mỗi hàm nhận con trỏ SCH tới instance của nó → nhiều scheduler độc lập
+// trong cùng 1 chương trình. API cũ SCH_xxx() dùng SCH_default
+// (scheduler_default.c).
+//
+// Bảng slot chứa tất cả các task (index = slot trong handle, không đổi)
+// Slot trống: pTask = 0, Delay = slot trống kế tiếp (danh sách slot trống)
+// Slot >= SCH->fresh_slot chưa từng được cấp → không cần xóa lúc khởi tạo
+// Truy cập qua SCH_TASK_xxx(slot) (scheduler_internal.h), giống nhau
+// với cả 2 cách bố trí
+// SCH_COMPACT: mỗi trường 1 mảng riêng
+//   NÓNG (Update/Dispatch đọc mỗi tick): Delay, RunMe → 3 byte/slot liền nhau
+//   LẠNH (chỉ đọc khi task chạy / Add / Delete): pTask, Period, generation
+// VÍ DỤ (40 slot, SCH_MAX_PERIOD = 65535, trên STM32):
+//   sTask + MARKING: 40 x (20 + 1) = 840 byte
+//   Compact:         40 x (2 + 1 + 4 + 2 + 2) = 440 byte
+//                    + mark_delay 4 + task_view 20 = 464 byte
+//
+// Theo từng slot: task_due (tick đến hạn kế tiếp), task_release (tick phát
+// hành danh nghĩa, không bị SCH_Deadline_Check ghi đè → mốc tính lần phát
+// hành kế tiếp), task_replay (SCH_CATCHUP_REPLAY: số lần chạy bù còn lại),
+// task_event / task_signal (loại task, cờ "đã được SCH_Signal, chưa chạy")
+
+// Loại task (SCH->task_event[slot])
+#define TASK_POLLED         0   // Task thường (SCH_Add_Task)
+#define TASK_EVENT_TIMEOUT  1   // Task sự kiện, chạy cả khi hết TIMEOUT
+#define TASK_EVENT_FOREVER  2   // Task sự kiện, chỉ chạy khi có tín hiệu
+
+#if SCH_STAGGER
+static uint32_t SCH_Load_Build(SCH_Instance_t *SCH);
+#endif
+
+#if SCH_PRIORITY
+static void SCH_Latency_Record(SCH_Instance_t *SCH, sch_index_t slot, int32_t late);
+#else
+#define SCH_Latency_Record(SCH, slot, late)  ((void)0)
+#endif
+
+#if SCH_SHED
+static uint8_t SCH_Shed_Skip(SCH_Instance_t *SCH, sch_index_t slot);
+static void SCH_Shed_Tick(SCH_Instance_t *SCH, uint32_t busy, uint32_t idle_ticks);
+#endif
+
+#if SCH_PROFILE
+static void SCH_Profile_Clear(SCH_Instance_t *SCH, sch_index_t slot);
+#endif
+
+#if SCH_UTIL
+#define UTIL_TICKS_PER_SECOND   (1000u / TIMER_TICK_MS)
+#define UTIL_HISTORY            SCH_UTIL_HISTORY    // Giây lưu lại (cửa sổ dài nhất)
+
+static void SCH_Util_Clear(SCH_Instance_t *SCH);
+static void SCH_Util_Advance(SCH_Instance_t *SCH, uint32_t tick);
+#endif
+
+/* ==================== BẢNG SLOT & HANDLE (DÙNG CHUNG) ==================== */
+
+// Bộ đếm chu kỳ và trace (dùng chung mọi instance) đã được khởi tạo
+static uint8_t sch_global_ready;
+
+/**
+ * ============================================================================
+ * HÀM: SCH_Slots_Init (INTERNAL)
+ * ============================================================================
+ * MÔ TẢ: Làm rỗng bảng slot - O(1), KHÔNG duyệt bảng
+ *        Các slot được cấp dần từ slot 0 (giống thứ tự của mảng cũ),
+ *        slot chưa cấp bị SCH_Handle_To_Slot từ chối nên không cần xóa.
+ *        TaskID cũ được giữ → generation tiếp tục tăng, handle cấp trước
+ *        lần SCH_Init này vẫn bị từ chối.
+ *        SCH_UTIL / SCH_PRIORITY = 1: xóa thống kê tải và độ trễ
+ *        Bộ đếm chu kỳ và trace dùng chung mọi instance → chỉ bật / làm
+ *        rỗng ở lần SCH_Init_In đầu tiên (sch_global_ready), SCH_Init_In
+ *        sau đó không làm hỏng số đo của instance đang chạy
+ * ============================================================================
+ */
+void SCH_Slots_Init(SCH_Instance_t *SCH) {
+    SCH->free_head = SCH_NO_SLOT;
+    SCH->fresh_slot = 0;
+    SCH->task_count = 0;
+    SCH->tick_now = 0;
+    SCH->last_error_code = 0;
+
+    if (!sch_global_ready) {
+        sch_global_ready = 1;
+#if SCH_PROFILE || SCH_UTIL || SCH_TRACE || SCH_PRIORITY
+        SCH_Cycle_Counter_Init();
+#endif
+        SCH_Trace_Init();
+    }
+#if SCH_UTIL
+    SCH_Util_Clear(SCH);
+#endif
+#if SCH_PRIORITY
+    for (uint32_t c = 0; c < SCH_CLASSES; c++) {
+        SCH->class_latency[c] = (SCH_Class_Latency_t){ 0 };
+    }
+#endif
+#if SCH_SHED
+    SCH->shed_stats = (SCH_Shed_Stats_t){ 0 };
+    SCH->shed_hot_ticks = 0;
+    SCH->shed_calm_ticks = 0;
+#endif
+    SCH_Fast_Init(SCH);
+    SCH_Pipe_Init(SCH);
+}
+
+/**
+ * ============================================================================
+ * HÀM: SCH_Slot_Alloc (INTERNAL)
+ * ============================================================================
+ * MÔ TẢ: Lấy 1 slot trống - O(1)
+ *        (slot đã trả lại trước, hết thì lấy slot chưa từng dùng)
+ *        Ghi pTask, Period, RunMe = 0 và cấp handle mới (generation + 1)
+ *
+ * TRẢ VỀ: slot, hoặc SCH_NO_SLOT nếu đã đầy (Error_code_G được đặt)
+ * ============================================================================
+ */
+sch_index_t SCH_Slot_Alloc(SCH_Instance_t *SCH, void (*pFunction)(void), uint32_t PERIOD) {
+    sch_index_t slot;
+
+    if (SCH->free_head != SCH_NO_SLOT) {
+        slot = SCH->free_head;                  // Dùng lại slot đã trả
+        SCH->free_head = (sch_index_t)SCH_TASK_DELAY(slot);
+    } else if (SCH->fresh_slot < SCH_MAX_TASKS) {
+        slot = (sch_index_t)SCH->fresh_slot++;  // Slot chưa từng dùng
+    } else {
+        SCH->error_code = ERROR_SCH_TOO_MANY_TASKS;
+        return SCH_NO_SLOT;
+    }
+
+    // Generation mới, bỏ qua 0 để handle không bao giờ bằng SCH_INVALID_HANDLE
+    uint32_t gen = (SCH_HANDLE_GEN(SCH_TASK_ID(slot)) + 1u) & 0xFFFFu;
+    if (gen == 0) gen = 1;
+
+    SCH_TASK_FN(slot) = pFunction;
+    SCH_TASK_DELAY(slot) = 0;
+    SCH_TASK_PERIOD(slot) = PERIOD;
+    SCH_TASK_RUNME(slot) = 0;
+#if SCH_COMPACT
+    SCH->task_gen[slot] = (uint16_t)gen;
+#else
+    SCH->tasks[slot].TaskID = (gen << 16) | slot;
+#endif
+
+#if SCH_PROFILE
+    SCH_Profile_Clear(SCH, slot);
+#endif
+    SCH->task_replay[slot] = 0;
+    SCH->task_event[slot] = TASK_POLLED;
+    SCH->task_signal[slot] = 0;
+    SCH->task_misses[slot].Late_Starts = 0;
+    SCH->task_misses[slot].Missed_Periods = 0;
+    SCH->task_misses[slot].Saturations = 0;
+    SCH->task_misses[slot].Max_Lateness = 0;
+    SCH->task_misses[slot].Phase_Error = 0;
+#if SCH_STAGGER || SCH_ADMISSION
+    SCH->task_cost[slot] = 0;
+#endif
+#if SCH_PRIORITY
+    SCH->task_class[slot] = SCH_CLASS_NORMAL;
+#endif
+#if SCH_SHED
+    SCH->task_shed_count[slot] = 0;
+#endif
+
+    SCH->task_count++;
+    return slot;
+}
+
+#if SCH_COMPACT && SCH_MAX_PERIOD < 0xFFFFFFFFuL
+/**
+ * ============================================================================
+ * HÀM: SCH_Ticks_Check (INTERNAL)
+ * ============================================================================
+ * MÔ TẢ: SCH_COMPACT: Delay / Period lưu bằng kiểu hẹp (sch_delay_t,
+ *        sch_period_t) → từ chối DELAY / PERIOD lớn hơn SCH_MAX_PERIOD
+ *        thay vì cắt bớt âm thầm
+ *
+ * VÍ DỤ: SCH_MAX_PERIOD = 65535
+ *   SCH_Add_Task(Log, 0, 6000)    → OK (1 phút)
+ *   SCH_Add_Task(Log, 0, 360000)  → SCH_INVALID_HANDLE,
+ *                                   Error_code_G = ERROR_SCH_PERIOD_TOO_LONG
+ * ============================================================================
+ */
+uint8_t SCH_Ticks_Check(SCH_Instance_t *SCH, uint32_t DELAY, uint32_t PERIOD) {
+    if (DELAY > SCH_MAX_PERIOD || PERIOD > SCH_MAX_PERIOD) {
+        SCH->error_code = ERROR_SCH_PERIOD_TOO_LONG;
+        return 0;
+    }
+    return 1;
+}
+#endif
+
+/**
+ * ============================================================================
+ * HÀM: SCH_Slot_Kill / SCH_Slot_Release (INTERNAL)
+ * ============================================================================
+ * MÔ TẢ:
+ *   - Kill:    task không còn hoạt động (pTask = 0 → handle hết hiệu lực)
+ *   - Release: trả slot về danh sách trống (slot phải đã bị Kill)
+ *
+ *   Mảng sắp xếp tách 2 bước này: Delete chỉ Kill (O(1)), slot được
+ *   Release khi mục của nó rời hàng đợi. Timing wheel làm cả 2 cùng lúc.
+ *   TaskID được GIỮ LẠI để lần cấp phát sau tăng generation.
+ * ============================================================================
+ */
+void SCH_Slot_Kill(SCH_Instance_t *SCH, sch_index_t slot) {
+    if (SCH_TASK_FN(slot) != 0x0000) {
+        SCH_TASK_FN(slot) = 0x0000;
+        SCH->task_count--;
+    }
+}
+
+void SCH_Slot_Release(SCH_Instance_t *SCH, sch_index_t slot) {
+    SCH_TASK_DELAY(slot) = SCH->free_head;
+    SCH_TASK_PERIOD(slot) = 0;
+    SCH_TASK_RUNME(slot) = 0;
+    SCH->free_head = slot;
+}
+
+/**
+ * ============================================================================
+ * HÀM: SCH_Handle_To_Slot (INTERNAL)
+ * ============================================================================
+ * MÔ TẢ: Kiểm tra handle và trả về slot - O(1)
+ *
+ * TRẢ VỀ: slot, hoặc SCH_NO_SLOT nếu handle sai / task đã bị xóa /
+ *         slot đã được dùng lại cho task khác (generation khác)
+ * ============================================================================
+ */
+sch_index_t SCH_Handle_To_Slot(SCH_Instance_t *SCH, SCH_Handle_t handle) {
+    uint32_t slot = SCH_HANDLE_SLOT(handle);
+
+    if (handle == SCH_INVALID_HANDLE || slot >= SCH->fresh_slot) {
+        return SCH_NO_SLOT;
+    }
+    if (SCH_TASK_FN(slot) == 0x0000 || SCH_TASK_ID(slot) != handle) {
+        return SCH_NO_SLOT;
+    }
+    return (sch_index_t)slot;
+}
+
+/**
+ * ============================================================================
+ * HÀM: SCH_Get_Task_In
+ * ============================================================================
+ * MÔ TẢ: Tra cứu task theo handle - O(1)
+ *
+ * VÍ DỤ:
+ *   const sTask *t = SCH_Get_Task(buzzer);
+ *   if (t != 0) { ... t->Period ... }   // 0 = task đã bị xóa
+ *
+ * LƯU Ý: SCH_COMPACT = 1 → trả về BẢN SAO các trường (không có sTask
+ *        trong RAM), bị ghi đè ở lần gọi sau
+ * ============================================================================
+ */
+const sTask *SCH_Get_Task_In(SCH_Instance_t *SCH, const SCH_Handle_t TASK_HANDLE) {
+    sch_index_t slot = SCH_Handle_To_Slot(SCH, TASK_HANDLE);
+    if (slot == SCH_NO_SLOT) {
+        return 0;
+    }
+#if SCH_COMPACT
+    SCH->task_view.pTask = SCH_TASK_FN(slot);
+    SCH->task_view.Delay = SCH_TASK_DELAY(slot);
+    SCH->task_view.Period = SCH_TASK_PERIOD(slot);
+    SCH->task_view.RunMe = SCH_TASK_RUNME(slot);
+    SCH->task_view.TaskID = SCH_TASK_ID(slot);
+    return &SCH->task_view;
+#else
+    return &SCH->tasks[slot];
+#endif
+}
+
+/**
+ * ============================================================================
+ * HÀM: SCH_Run_Task (INTERNAL)
+ * ============================================================================
+ * MÔ TẢ: Gọi hàm task ở slot - dùng chung cho Dispatch của các backend
+ *        SCH_PROFILE = 1: đo thời gian chạy và cộng vào profile của task
+ *        SCH_UTIL = 1:    cộng thời gian chạy vào tải của tick hiện tại
+ *        SCH_PIPELINE = 1: chạy luôn các stage sau task (SCH_Pipeline_Run),
+ *                          thời gian của cả chuỗi tính cho task
+ *
+ * LƯU Ý: Task tự Delete rồi Add task mới có thể nhận lại đúng slot này
+ *        → chỉ ghi profile nếu handle không đổi trong lúc chạy
+ * ============================================================================
+ */
+void SCH_Run_Task(SCH_Instance_t *SCH, sch_index_t slot) {
+    SCH_TRACE_RECORD(SCH_TRACE_TASK_BEGIN, slot, SCH_TASK_RUNME(slot));
+#if SCH_PROFILE || SCH_UTIL
+    uint32_t handle = SCH_TASK_ID(slot);
+#if SCH_UTIL
+    SCH_Util_Advance(SCH, SCH->tick_now); // Thời gian chạy tính cho tick bắt đầu
+#endif
+    uint32_t start = SCH_Cycles_Now();
+
+    (*SCH_TASK_FN(slot))();
+    SCH_Pipeline_Run(SCH, handle);
+
+    uint32_t cycles = SCH_Cycles_Now() - start;
+
+#if SCH_UTIL
+    SCH->util_tick_busy += cycles;
+    SCH->util_second_busy += cycles;
+#endif
+#if SCH_PROFILE
+    SCH_Task_Profile_t *p = &SCH->task_profile[slot];
+
+    if (SCH_TASK_ID(slot) == handle) {
+        p->Count++;
+        p->Total_Cycles += cycles;
+        if (cycles < p->Min_Cycles) p->Min_Cycles = cycles;
+        if (cycles > p->Max_Cycles) p->Max_Cycles = cycles;
+    }
+#else
+    (void)handle;
+#endif
+#else
+#if SCH_PIPELINE
+    uint32_t handle = SCH_TASK_ID(slot);
+#endif
+    (*SCH_TASK_FN(slot))();
+    SCH_Pipeline_Run(SCH, handle);
+#endif
+    SCH_TRACE_RECORD(SCH_TRACE_TASK_END, slot, 0);
+}
+
+/**
+ * ============================================================================
+ * HÀM: SCH_Set_Due / SCH_Deadline_Check / SCH_Replay_Pending (INTERNAL)
+ * ============================================================================
+ * MÔ TẢ: Phát hiện task chạy trễ - dùng chung cho 2 backend
+ *   - Backend gọi SCH_Set_Due() mỗi khi đặt lịch cho task (tick đến hạn)
+ *   - Dispatch gọi SCH_Deadline_Check() ngay trước khi chạy task:
+ *       trễ = SCH->tick_now - tick đến hạn
+ *       trễ >= 1 tick      → Late_Starts++
+ *       trễ >= Period tick → lỡ (trễ / Period) chu kỳ → Missed_Periods,
+ *                            Error_code_G = ERROR_SCH_MISSED_DEADLINE
+ *
+ * CHÍNH SÁCH BÙ (SCH_CATCHUP_POLICY):
+ *   - COALESCE: chạy 1 lần cho mọi chu kỳ đã lỡ
+ *   - REPLAY:   chạy thêm 1 lần cho mỗi chu kỳ đã lỡ (task_replay)
+ *   - SKIP:     lỡ >= 1 chu kỳ → bỏ lần chạy này, chờ chu kỳ sau
+ *
+ * VÍ DỤ: Task FSM Period=1, Dispatch bị chặn 5 tick
+ *   trễ = 5 → Late_Starts=1, Missed_Periods=5
+ *   COALESCE: chạy 1 lần | REPLAY: chạy 6 lần liền | SKIP: không chạy
+ *
+ * SCH_PRIORITY = 1: mỗi lần phát hành được chạy (không tính lần chạy bù)
+ *   → ghi độ trễ phát hành → bắt đầu vào lớp của task (SCH_Latency_Record)
+ *
+ * SCH_SHED = 1: lần phát hành bị giảm tải (SCH_Shed_Skip) → bỏ qua như
+ *   lần "đỗ" của task sự kiện, không tính trễ / lỡ chu kỳ
+ *
+ * TASK SỰ KIỆN: xóa cờ tín hiệu TRƯỚC khi chạy (tín hiệu đến lúc task
+ *   đang chạy → chạy thêm 1 lần); không có tín hiệu và không có TIMEOUT
+ *   → chỉ là lần "đỗ" SCH_EVENT_PARK_TICKS hết hạn → bỏ qua, chờ tiếp
+ * ============================================================================
+ */
+void SCH_Set_Due(SCH_Instance_t *SCH, sch_index_t slot, uint32_t due_tick) {
+    SCH->task_due[slot] = due_tick;
+    SCH->task_release[slot] = due_tick;
+    SCH->task_replay[slot] = 0;
+}
+
+/**
+ * ============================================================================
+ * HÀM: SCH_Rearm_Due (INTERNAL)
+ * ============================================================================
+ * MÔ TẢ: Tính tick đến hạn kế tiếp của task periodic vừa chạy xong,
+ *        ghi lại (giống SCH_Set_Due) và trả về cho backend
+ *   - SCH_REARM_FROM_RELEASE: tick phát hành danh nghĩa + Period; đã qua
+ *     rồi (Dispatch trễ >= 1 chu kỳ) → lần phát hành đầu tiên SAU
+ *     SCH->tick_now, cùng pha → task không bao giờ bị lệch pha
+ *   - SCH_REARM_FROM_RUN: SCH->tick_now + Period (cách cũ)
+ *   Lưới phát hành bị lệch bao nhiêu tick (khác bội của Period) được
+ *   cộng vào Phase_Error
+ *
+ * VÍ DỤ: Period = 100, phát hành danh nghĩa ở tick 1000, Dispatch trễ
+ *        nên task chạy ở tick 1003
+ *   FROM_RELEASE: đến hạn tick 1100, Phase_Error += 0
+ *   FROM_RUN:     đến hạn tick 1103, Phase_Error += 3 (trôi mãi mãi)
+ *
+ * TRẢ VỀ: Tick đến hạn mới (luôn > SCH->tick_now)
+ * ============================================================================
+ */
+uint32_t SCH_Rearm_Due(SCH_Instance_t *SCH, sch_index_t slot) {
+    uint32_t period = SCH_TASK_PERIOD(slot);
+    uint32_t release = SCH->task_release[slot];
+
+#if SCH_REARM == SCH_REARM_FROM_RUN && SCH_BACKEND != SCH_BACKEND_CYCLIC
+    uint32_t due = SCH->tick_now + period;
+#else
+    uint32_t due = release + period;
+    if ((int32_t)(due - SCH->tick_now) <= 0) {
+        due += period * ((SCH->tick_now - due) / period + 1u);
+    }
+#endif
+
+    SCH->task_misses[slot].Phase_Error += (due - release) % period;
+    SCH_Set_Due(SCH, slot, due);
+    return due;
+}
+
+uint8_t SCH_Deadline_Check(SCH_Instance_t *SCH, sch_index_t slot) {
+    // Lần chạy bù (REPLAY) → đã được tính khi kiểm tra lần đầu
+    if (SCH->task_replay[slot] > 0) {
+        SCH->task_replay[slot]--;
+        return 1;
+    }
+
+#if SCH_SHED
+    if (SCH_Shed_Skip(SCH, slot)) {
+        SCH->task_due[slot] = SCH->tick_now;
+        return 0;
+    }
+#endif
+
+    if (SCH->task_event[slot] != TASK_POLLED) {
+        uint8_t signalled = SCH->task_signal[slot];
+        SCH->task_signal[slot] = 0;
+        if (!signalled && SCH->task_event[slot] == TASK_EVENT_FOREVER) {
+            SCH->task_due[slot] = SCH->tick_now;
+            return 0;
+        }
+    }
+
+    int32_t late = (int32_t)(SCH->tick_now - SCH->task_due[slot]);
+    SCH->task_due[slot] = SCH->tick_now; // Không tính lại nếu chạy thêm lần nữa
+    if (late <= 0) {
+        SCH_Latency_Record(SCH, slot, 0);
+        return 1;                       // Đúng giờ
+    }
+
+    SCH_Task_Misses_t *m = &SCH->task_misses[slot];
+    uint32_t period = SCH_TASK_PERIOD(slot);
+    uint32_t missed = (period > 0) ? ((uint32_t)late / period) : 0;
+
+    m->Late_Starts++;
+    if ((uint32_t)late > m->Max_Lateness) {
+        m->Max_Lateness = (uint32_t)late;
+    }
+    if (missed == 0) {
+        SCH_Latency_Record(SCH, slot, late);
+        return 1;                       // Trễ nhưng chưa lỡ chu kỳ nào
+    }
+
+    m->Missed_Periods += missed;
+    SCH->error_code = ERROR_SCH_MISSED_DEADLINE;
+    SCH->error_tick = SCH->tick_now;
+
+#if SCH_CATCHUP_POLICY == SCH_CATCHUP_SKIP
+    return 0;
+#elif SCH_CATCHUP_POLICY == SCH_CATCHUP_REPLAY
+    SCH->task_replay[slot] = (missed < 0xFFu) ? (uint8_t)missed : 0xFFu;
+    SCH_Latency_Record(SCH, slot, late);
+    return 1;
+#else
+    SCH_Latency_Record(SCH, slot, late);
+    return 1;
+#endif
+}
+
+uint8_t SCH_Replay_Pending(SCH_Instance_t *SCH, sch_index_t slot) {
+    return SCH->task_replay[slot];
+}
+
+/**
+ * ============================================================================
+ * HÀM: SCH_RunMe_Saturated (INTERNAL)
+ * ============================================================================
+ * MÔ TẢ: RunMe là uint8_t → không tăng quá 255 (tránh tràn về 0 làm mất
+ *        hết các lần chạy đang chờ), chỉ đếm lại và báo lỗi
+ *        Gọi được trong ngắt (O(1))
+ * ============================================================================
+ */
+void SCH_RunMe_Saturated(SCH_Instance_t *SCH, sch_index_t slot) {
+    SCH->task_misses[slot].Saturations++;
+    SCH->error_code = ERROR_SCH_RUNME_SATURATED;
+    SCH->error_tick = SCH->tick_now;
+}
+
+/**
+ * ============================================================================
+ * HÀM: SCH_Add_Event_Task_In
+ * ============================================================================
+ * MÔ TẢ: Thêm task chạy theo sự kiện (SCH_Signal) thay vì theo chu kỳ
+ *        Là task định kỳ bình thường của backend với Period = TIMEOUT
+ *        (hoặc SCH_EVENT_PARK_TICKS), chỉ khác ở SCH_Deadline_Check
+ *
+ * VÍ DỤ - FSM chạy khi có cạnh nút nhấn, hoặc mỗi 1 giây:
+ *   fsm_id = SCH_Add_Event_Task(Task_Traffic_FSM, 100);
+ *   // trong Task_Button_Scan, khi phát hiện nhấn nút:
+ *   SCH_Signal(fsm_id);
+ * ============================================================================
+ */
+SCH_Handle_t SCH_Add_Event_Task_In(SCH_Instance_t *SCH, void (*pFunction)(void), uint32_t TIMEOUT) {
+    uint32_t period = (TIMEOUT > 0) ? TIMEOUT : SCH_EVENT_PARK_TICKS;
+
+#if SCH_ADMISSION
+    SCH->admit_any_tick = 1;    // Tín hiệu đến lúc nào cũng được → mọi tick
+#endif
+    SCH_Handle_t handle = SCH_Add_Task_In(SCH, pFunction, period, period);
+#if SCH_ADMISSION
+    SCH->admit_any_tick = 0;
+#endif
+
+    if (handle != SCH_INVALID_HANDLE) {
+        SCH->task_event[SCH_HANDLE_SLOT(handle)] = (TIMEOUT > 0) ? TASK_EVENT_TIMEOUT : TASK_EVENT_FOREVER;
+    }
+    return handle;
+}
+
+/**
+ * ============================================================================
+ * HÀM: SCH_Signal_In
+ * ============================================================================
+ * MÔ TẢ: Đánh thức task sự kiện → chạy ở tick kế tiếp
+ *   - Đã được đánh thức, chưa chạy → gộp (không làm gì thêm)
+ *   - Chưa → đặt cờ, Reschedule(DELAY = 0) → chạy ở tick kế tiếp,
+ *     sau đó chờ tiếp TIMEOUT tick (Period giữ nguyên)
+ *   Chỉ gọi từ task / main; trong ngắt dùng SCH_Signal_From_ISR
+ *
+ * VÍ DỤ: 3 lần SCH_Signal(fsm_id) trong cùng 1 tick → FSM chạy 1 lần
+ * ============================================================================
+ */
+uint8_t SCH_Signal_In(SCH_Instance_t *SCH, const SCH_Handle_t TASK_HANDLE) {
+    sch_index_t slot = SCH_Handle_To_Slot(SCH, TASK_HANDLE);
+
+    if (slot == SCH_NO_SLOT || SCH->task_event[slot] == TASK_POLLED) {
+        return RETURN_ERROR;
+    }
+    if (SCH->task_signal[slot]) {
+        return RETURN_NORMAL;
+    }
+
+    SCH->task_signal[slot] = 1;
+    return SCH_Reschedule_Task_In(SCH, TASK_HANDLE, 0, SCH_TASK_PERIOD(slot));
+}
+
+#if SCH_PROFILE
+/**
+ * ============================================================================
+ * HÀM: SCH_Profile_Clear (PRIVATE)
+ * ============================================================================
+ * MÔ TẢ: Xóa profile của 1 slot (Min = max uint32 để lần chạy đầu ghi đè)
+ * ============================================================================
+ */
+static void SCH_Profile_Clear(SCH_Instance_t *SCH, sch_index_t slot) {
+    SCH->task_profile[slot].Count = 0;
+    SCH->task_profile[slot].Min_Cycles = 0xFFFFFFFFu;
+    SCH->task_profile[slot].Max_Cycles = 0;
+    SCH->task_profile[slot].Mean_Cycles = 0;
+    SCH->task_profile[slot].Total_Cycles = 0;
+}
+#endif
+
+#if SCH_BACKEND == SCH_BACKEND_SORTED_ARRAY
+
+/* ==================== BACKEND MẢNG SẮP XẾP ==================== */
+
+// Hàng đợi SCH->order[]: các slot sắp xếp theo Delay tăng dần
+// VÍ DỤ: SCH->order = [2, 0, 1] → task ở slot 2 chạy sớm nhất
+
+// Có mảng MARKING hay không (chỉ cách bố trí sTask + Delay tương đối)
+#define QUEUE_MARKING_ARRAY (SCH_TIMEBASE == SCH_TIMEBASE_RELATIVE && !SCH_COMPACT)
+
+#if SCH_TIMEBASE == SCH_TIMEBASE_ABSOLUTE
+// SCH_TIMEBASE_ABSOLUTE: Delay = TICK ĐẾN HẠN TUYỆT ĐỐI (theo SCH->tick_now)
+// → không có gì phải trừ khi thời gian trôi: không cần elapsed_time, MARKING
+// VÍ DỤ: SCH->tick_now = 100, Add(A, 5, 10) → A.Delay = 105
+//        Tick 105: SCH_Update thấy 105 - 105 >= 0 → A.RunMe = 1
+#elif SCH_COMPACT
+// SCH_COMPACT: thay cho MARKING - Delay của task đầu lúc SCH_Update_Marking
+// Chỉ task đầu bị SCH_Update trừ Delay → task ở vị trí i > 0 "được đánh
+// dấu" khi Delay của nó vẫn bằng SCH->mark_delay
+// VÍ DỤ: Delay = [10, 10, 20] → mark_delay = 10 → giống MARKING = [1, 1, 0]
+#else
+// Mảng đánh dấu SCH->marking[] (MARKING): marking[i]=1 nếu task ở vị trí i
+// có cùng delay với vị trí 0
+// VÍ DỤ: Nếu Task[0].Delay=10, Task[1].Delay=10, Task[2].Delay=20
+//        → MARKING = [1, 1, 0]
+#endif
+
+// SCH_TIMEBASE_RELATIVE: SCH->elapsed_time đếm số tick đã trôi qua kể từ
+// lần dispatch cuối
+// VÍ DỤ: Nếu elapsed_time=50 → đã qua 50 tick (500ms với tick=10ms)
+
+// SCH->queue_len: số mục trong hàng đợi (gồm cả task đã bị Delete nhưng
+// chưa rời hàng đợi)
+// SCH->running_slot: slot đang được Dispatch chạy (SCH_NO_SLOT nếu task tự
+// Reschedule chính nó)
+
+// Truy cập task ở vị trí pos của hàng đợi
+#define QUEUE_DELAY(pos)    SCH_TASK_DELAY(SCH->order[(pos)])
+#define QUEUE_RUNME(pos)    SCH_TASK_RUNME(SCH->order[(pos)])
+
+#if SCH_TIMEBASE == SCH_TIMEBASE_ABSOLUTE
+// Khóa sắp xếp của task chạy sau DELAY tick, và so sánh 2 khóa
+// (hiệu có dấu → đúng cả khi SCH->tick_now tràn 2^32, miễn là mọi hạn
+//  nằm trong 2^31 tick quanh hiện tại)
+#define QUEUE_KEY(delay)    (SCH->tick_now + (((delay) > 0) ? (uint32_t)(delay) : 1u))
+#define QUEUE_KEY_LE(a, b)  ((int32_t)((uint32_t)(a) - (uint32_t)(b)) <= 0)
+
+// Task ở vị trí pos đã đến hạn / sẵn sàng chạy trong Dispatch
+#define QUEUE_DUE(pos)      ((int32_t)(SCH->tick_now - (uint32_t)QUEUE_DELAY(pos)) >= 0)
+#define QUEUE_READY(pos)    (QUEUE_RUNME(pos) > 0 || QUEUE_DUE(pos))
+#else
+#define QUEUE_READY(pos)    (QUEUE_RUNME(pos) > 0)
+#define QUEUE_KEY(delay)    (delay)
+#define QUEUE_KEY_LE(a, b)  ((a) <= (b))
+
+// Task ở vị trí pos có cùng delay với task đầu (lúc SCH_Update_Marking)
+#if SCH_COMPACT
+#define QUEUE_MARKED(pos)   ((pos) == 0 || QUEUE_DELAY(pos) == SCH->mark_delay)
+#else
+#define QUEUE_MARKED(pos)   (SCH->marking[(pos)] != 0)
+#endif
+#endif
+
+/* ==================== HÀM PRIVATE (INTERNAL) ==================== */
+static void SCH_Update_Marking(SCH_Instance_t *SCH);
+static void SCH_Rearm_Head(SCH_Instance_t *SCH);
+static void SCH_Queue_Insert(SCH_Instance_t *SCH, sch_index_t slot);
+static void SCH_Queue_Remove_At(SCH_Instance_t *SCH, uint32_t pos);
+static void SCH_Purge_Deleted(SCH_Instance_t *SCH);
+#if SCH_PRIORITY
+static void SCH_Queue_Pick(SCH_Instance_t *SCH);
+#endif
+
+/* ==================== IMPLEMENTATION ==================== */
+
+/**
+ * ============================================================================
+ * HÀM: SCH_Init_In
+ * ============================================================================
+ * MÔ TẢ: Khởi tạo scheduler - Xóa tất cả task và reset biến - O(1)
+ *        (các ô của hàng đợi ngoài queue_len không bao giờ được đọc
+ *         → không cần vòng lặp xóa)
+ *
+ * GỌI KHI NÀO: Trong main(), trước khi thêm bất kỳ task nào
+ *
+ * VÍ DỤ:
+ *   int main(void) {
+ *       HAL_Init();
+ *       SCH_Init();  // ← Gọi ở đây
+ *       SCH_Add_Task(Task1, 0, 100);
+ *       ...
+ *   }
+ * ============================================================================
+ */
+void SCH_Init_In(SCH_Instance_t *SCH) {
+    // Làm rỗng bảng slot
+    SCH_Slots_Init(SCH);
+
+    // Reset các biến đếm
+    SCH->queue_len = 0;                 // Hàng đợi rỗng
+#if SCH_TIMEBASE == SCH_TIMEBASE_RELATIVE
+    SCH->elapsed_time = 0;              // Chưa đếm thời gian
+#endif
+    SCH->error_code = 0;                // Không có lỗi
+    SCH->running_slot = SCH_NO_SLOT;    // Không có task đang chạy
+}
+
+/**
+ * ============================================================================
+ * HÀM: SCH_Init_Static_In
+ * ============================================================================
+ * MÔ TẢ: Khởi tạo scheduler với sẵn các task trong bảng const (flash)
+ *        Thay cho SCH_Init() + mỗi dòng 1 lần SCH_Add_Task()
+ *
+ * SO VỚI SCH_Add_Task TỪNG TASK:
+ *   - Add: tìm vị trí + dịch hàng đợi + SCH_Update_Marking → O(n) mỗi task
+ *   - Static: thứ tự và MARKING đã được trình biên dịch tính sẵn
+ *             (SCH_TASK_TABLE) → chỉ chép, O(1) mỗi task
+ *
+ * VÍ DỤ: xem scheduler_table.h
+ *   Bảng: (A, 5, 1), (B, 0, 1), (C, 0, 5)
+ *   → slot 0=A, 1=B, 2=C; SCH->order = [1, 2, 0]; MARKING = [1, 1, 0]
+ * ============================================================================
+ */
+void SCH_Init_Static_In(SCH_Instance_t *SCH, const SCH_Task_Table_t *TABLE) {
+    SCH_Init_In(SCH);
+    SCH_Admit_Table_Begin(SCH);
+
+    // Hàng đợi rỗng, chưa slot nào được cấp → dòng i nhận slot i
+    for (uint32_t i = 0; i < TABLE->Count; i++) {
+        const SCH_Task_Config_t *row = &TABLE->Tasks[i];
+        sch_index_t slot = SCH_Slot_Alloc(SCH, row->pTask, row->Period);
+
+        SCH_TASK_DELAY(slot) = QUEUE_KEY(row->Delay);
+        SCH_Set_Due(SCH, slot, SCH->tick_now + ((row->Delay > 0) ? row->Delay : 1));
+    }
+
+    // Thứ tự và MARKING tính sẵn lúc biên dịch
+    // (TIMEBASE_ABSOLUTE: Delay 0 và 1 cùng là tick kế tiếp → thứ tự vẫn đúng)
+    for (uint32_t k = 0; k < TABLE->Count; k++) {
+        SCH->order[k] = TABLE->Order[k];
+#if QUEUE_MARKING_ARRAY
+        SCH->marking[k] = TABLE->Marking[k];
+#endif
+    }
+    SCH->queue_len = TABLE->Count;
+#if !QUEUE_MARKING_ARRAY
+    SCH_Update_Marking(SCH);            // O(1): chỉ lưu Delay của task đầu
+#endif
+    SCH_Admit_Table_End(SCH);
+}
+
+/**
+ * ============================================================================
+ * HÀM: SCH_Queue_Insert (PRIVATE)
+ * ============================================================================
+ * MÔ TẢ: Chèn slot vào hàng đợi theo SCH_TASK_DELAY(slot)
+ *        (sau các task có cùng delay)
+ *
+ * VÍ DỤ: Hàng đợi hiện tại [Delay: 10, 20, 50, 100]
+ *        Thêm task mới có Delay=30
+ *
+ * BƯỚC 1: Tìm vị trí chèn
+ *   - 30 >= 10 ✅ → insert_index = 1
+ *   - 30 >= 20 ✅ → insert_index = 2
+ *   - 30 >= 50 ❌ → DỪNG
+ *   → insert_index = 2 (chèn giữa 20 và 50)
+ *
+ * BƯỚC 2: Dịch hàng đợi
+ *   [10, 20, 50, 100, ?]
+ *   [10, 20, _, 50, 100]  ← Dịch 50 và 100 sang phải
+ *
+ * BƯỚC 3: Chèn
+ *   [10, 20, 30, 50, 100]  ← Hàng đợi vẫn được sắp xếp!
+ *
+ * ĐỘ PHỨC TẠP: O(n), nhưng chỉ dịch index 1 byte thay vì cả struct
+ * ============================================================================
+ */
+static void SCH_Queue_Insert(SCH_Instance_t *SCH, sch_index_t slot) {
+    uint32_t delay = SCH_TASK_DELAY(slot);
+    uint32_t insert_index = 0;
+
+    // Tìm vị trí để DELAY được sắp xếp tăng dần
+    while (insert_index < SCH->queue_len && QUEUE_KEY_LE(QUEUE_DELAY(insert_index), delay)) {
+        insert_index++;  // Chèn sau task này
+    }
+
+    // Dịch chuyển các slot từ vị trí chèn sang phải 1 ô
+    for (uint32_t j = SCH->queue_len; j > insert_index; j--) {
+        SCH->order[j] = SCH->order[j - 1];
+    }
+
+    SCH->order[insert_index] = slot;
+    SCH->queue_len++;
+}
+
+/**
+ * ============================================================================
+ * HÀM: SCH_Queue_Remove_At (PRIVATE)
+ * ============================================================================
+ * MÔ TẢ: Bỏ mục ở vị trí pos khỏi hàng đợi (dịch trái phần phía sau)
+ *
+ * VÍ DỤ: Xóa mục ở vị trí 2
+ *   Trước: [A, B, C, D, E]
+ *                ↑ Xóa C
+ *   Sau:   [A, B, D, E, _]
+ * ============================================================================
+ */
+static void SCH_Queue_Remove_At(SCH_Instance_t *SCH, uint32_t pos) {
+    for (uint32_t k = pos; k + 1 < SCH->queue_len; k++) {
+        SCH->order[k] = SCH->order[k + 1];
+    }
+    SCH->queue_len--;
+    SCH->order[SCH->queue_len] = SCH_NO_SLOT;
+#if QUEUE_MARKING_ARRAY
+    SCH->marking[SCH->queue_len] = 0;
+#endif
+}
+
+#if SCH_PRIORITY
+/**
+ * ============================================================================
+ * HÀM: SCH_Queue_Pick (PRIVATE)
+ * ============================================================================
+ * MÔ TẢ: Trong các task SẴN SÀNG ở đầu hàng đợi, đưa task lớp cao nhất
+ *        (cùng lớp → task đứng trước) lên vị trí 0 - Dispatch gọi trước
+ *        MỖI task → task lớp cao vừa đến hạn được chọn ngay lần sau
+ *        Các task sẵn sàng đều đã đến hạn → đảo thứ tự giữa chúng không
+ *        làm hỏng phần còn lại của hàng đợi (task đầu được re-arm / bỏ ngay)
+ *
+ * VÍ DỤ: sẵn sàng [Display (BACKGROUND), Log (NORMAL), FSM (CRITICAL)], ...
+ *   → [FSM, Display, Log], ... → FSM chạy trước
+ * ============================================================================
+ */
+static void SCH_Queue_Pick(SCH_Instance_t *SCH) {
+    uint32_t best = 0;
+    uint8_t best_class = SCH_Task_Class(SCH, SCH->order[0]);
+
+    for (uint32_t pos = 1; pos < SCH->queue_len && best_class > SCH_CLASS_CRITICAL && QUEUE_READY(pos); pos++) {
+        uint8_t c = SCH_Task_Class(SCH, SCH->order[pos]);
+        if (c < best_class) {
+            best = pos;
+            best_class = c;
+        }
+    }
+
+    if (best > 0) {
+        sch_index_t slot = SCH->order[best];
+        for (uint32_t k = best; k > 0; k--) {
+            SCH->order[k] = SCH->order[k - 1];
+        }
+        SCH->order[0] = slot;
+    }
+}
+
+/**
+ * ============================================================================
+ * HÀM: SCH_Class_Changed (INTERNAL)
+ * ============================================================================
+ * MÔ TẢ: Mảng sắp xếp chọn theo lớp lúc Dispatch → không phải làm gì
+ * ============================================================================
+ */
+void SCH_Class_Changed(SCH_Instance_t *SCH, sch_index_t slot) {
+    (void)slot;
+}
+#endif
+
+/**
+ * ============================================================================
+ * HÀM: SCH_Purge_Deleted (PRIVATE)
+ * ============================================================================
+ * MÔ TẢ: Dọn các task đã bị Delete nhưng còn nằm trong hàng đợi và trả slot
+ *        Chỉ gọi khi hết slot trống (SCH_Add_Task) - O(n) một lần
+ * ============================================================================
+ */
+static void SCH_Purge_Deleted(SCH_Instance_t *SCH) {
+    uint32_t keep = 0;
+
+    for (uint32_t i = 0; i < SCH->queue_len; i++) {
+        sch_index_t slot = SCH->order[i];
+        if (SCH_TASK_FN(slot) == 0x0000) {
+            SCH_Slot_Release(SCH, slot);
+        } else {
+            SCH->order[keep++] = slot;
+        }
+    }
+    for (uint32_t i = keep; i < SCH->queue_len; i++) {
+        SCH->order[i] = SCH_NO_SLOT;
+#if QUEUE_MARKING_ARRAY
+        SCH->marking[i] = 0;
+#endif
+    }
+    SCH->queue_len = keep;
+    SCH_Update_Marking(SCH);
+}
+
+/**
+ * ============================================================================
+ * HÀM: SCH_Add_Task_In
+ * ============================================================================
+ * MÔ TẢ: Thêm task vào scheduler (hàng đợi luôn được sắp xếp theo Delay)
+ *
+ * THAM SỐ:
+ *   - pFunction: Con trỏ tới hàm cần gọi (kiểu void function(void))
+ *   - DELAY: Số tick chờ trước khi chạy lần đầu
+ *   - PERIOD: Số tick giữa các lần chạy (0 = chỉ chạy 1 lần)
+ *
+ * TRẢ VỀ: Handle của task (dùng để delete/reschedule sau này),
+ *         SCH_INVALID_HANDLE nếu thất bại
+ *
+ * ĐỘ PHỨC TẠP: O(n) do phải tìm vị trí chèn và dịch hàng đợi
+ *
+ * VÍ DỤ 1 - Task chạy ngay và lặp lại:
+ *   SCH_Add_Task(LED_Toggle, 0, 100);
+ *   → LED_Toggle chạy ngay, sau đó lặp mỗi 100 tick (1 giây nếu tick=10ms)
+ *
+ * VÍ DỤ 2 - Task chờ rồi lặp:
+ *   SCH_Add_Task(Read_Sensor, 50, 200);
+ *   → Chờ 50 tick (500ms), sau đó chạy và lặp mỗi 200 tick (2 giây)
+ *
+ * VÍ DỤ 3 - Task chạy 1 lần (one-shot):
+ *   SCH_Add_Task(Send_Alert, 300, 0);
+ *   → Chờ 300 tick (3 giây), chạy 1 lần rồi tự động xóa
+ *
+ * VÍ DỤ 4 - Lưu handle để xóa sau:
+ *   SCH_Handle_t id = SCH_Add_Task(Buzzer, 0, 50);
+ *   // Sau đó có thể xóa:
+ *   SCH_Delete_Task(id);
+ * ============================================================================
+ */
+SCH_Handle_t SCH_Add_Task_In(SCH_Instance_t *SCH, void (*pFunction)(), uint32_t DELAY, uint32_t PERIOD) {
+
+    if (pFunction == 0x0000 || !SCH_Ticks_Check(SCH, DELAY, PERIOD) || !SCH_Admit(SCH, DELAY, PERIOD)) {
+        return SCH_INVALID_HANDLE;
+    }
+
+    // Hết slot trống nhưng hàng đợi còn task đã Delete → dọn trước
+    if (SCH->queue_len >= SCH_MAX_TASKS && SCH->queue_len > SCH->task_count) {
+        SCH_Purge_Deleted(SCH);
+    }
+
+    sch_index_t slot = SCH_Slot_Alloc(SCH, pFunction, PERIOD);
+    if (slot == SCH_NO_SLOT) {
+        // Không thể thêm task nữa (Error_code_G đã được đặt)
+        return SCH_INVALID_HANDLE;
+    }
+    SCH_TASK_DELAY(slot) = QUEUE_KEY(DELAY);
+    SCH_Set_Due(SCH, slot, SCH->tick_now + ((DELAY > 0) ? DELAY : 1));
+
+    /* ========== CASE 1: TASK ĐẦU TIÊN (HÀNG ĐỢI RỖNG) ========== */
+    if (SCH->queue_len == 0) {
+        SCH->order[0] = slot;
+#if SCH_TIMEBASE == SCH_TIMEBASE_RELATIVE
+        SCH->elapsed_time = 0;
+#endif
+        SCH->queue_len = 1;
+        SCH_Update_Marking(SCH);           // Đánh dấu là task đầu
+        return SCH_TASK_ID(slot);
+    }
+
+    /* ========== CASE 2: CHÈN VÀO ĐÚNG VỊ TRÍ (INSERTION SORT) ========== */
+    SCH_Queue_Insert(SCH, slot);
+
+    // Cập nhật mảng MARKING (đánh dấu task nào có cùng delay với task đầu)
+    SCH_Update_Marking(SCH);
+
+    return SCH_TASK_ID(slot);
+}
+
+/**
+ * ============================================================================
+ * HÀM: SCH_Delete_Task_In
+ * ============================================================================
+ * MÔ TẢ: Xóa task khỏi scheduler
+ *
+ * THAM SỐ:
+ *   - TASK_HANDLE: Handle trả về từ SCH_Add_Task
+ *
+ * TRẢ VỀ:
+ *   - RETURN_NORMAL: Xóa thành công
+ *   - RETURN_ERROR: Lỗi (handle sai hoặc task đã bị xóa trước đó)
+ *
+ * ĐỘ PHỨC TẠP: O(1) - XÓA "LƯỜI"
+ *   - Task bị đánh dấu đã xóa (pTask = 0) → handle hết hiệu lực ngay
+ *   - Mục trong hàng đợi được bỏ đi khi tới đầu hàng đợi (Dispatch)
+ *     hoặc khi SCH_Add_Task cần slot (SCH_Purge_Deleted)
+ *
+ * VÍ DỤ:
+ *   SCH_Handle_t buzzer_id = SCH_Add_Task(Buzzer, 0, 100);
+ *   // ... sau một thời gian
+ *   SCH_Delete_Task(buzzer_id);  // Tắt buzzer
+ *   SCH_Delete_Task(buzzer_id);  // → RETURN_ERROR (handle cũ bị từ chối)
+ * ============================================================================
+ */
+uint8_t SCH_Delete_Task_In(SCH_Instance_t *SCH, const SCH_Handle_t TASK_HANDLE) {
+
+#if SCH_FAST_LANE
+    if (SCH_FAST_HANDLE(TASK_HANDLE)) {
+        return SCH_Fast_Delete(SCH, TASK_HANDLE);
+    }
+#endif
+#if SCH_PIPELINE
+    if (SCH_STAGE_HANDLE(TASK_HANDLE)) {
+        return SCH_Stage_Delete(SCH, TASK_HANDLE);
+    }
+#endif
+
+    sch_index_t slot = SCH_Handle_To_Slot(SCH, TASK_HANDLE);
+
+    // Kiểm tra handle có hợp lệ không
+    if (slot == SCH_NO_SLOT) {
+        SCH->error_code = ERROR_SCH_CANNOT_DELETE_TASK;
+        return RETURN_ERROR;
+    }
+
+    SCH_Slot_Kill(SCH, slot);
+    return RETURN_NORMAL;
+}
+
+/**
+ * ============================================================================
+ * HÀM: SCH_Reschedule_Task_In
+ * ============================================================================
+ * MÔ TẢ: Đổi Delay/Period của task mà KHÔNG đổi handle
+ *
+ * ĐỘ PHỨC TẠP: O(n) - phải tìm vị trí cũ rồi chèn lại cho đúng thứ tự
+ *
+ * VÍ DỤ - Kéo dài timeout:
+ *   SCH_Reschedule_Task(timeout_id, 300, 0);  // Chạy sau 3 giây kể từ bây giờ
+ * ============================================================================
+ */
+uint8_t SCH_Reschedule_Task_In(SCH_Instance_t *SCH, const SCH_Handle_t TASK_HANDLE, uint32_t DELAY, uint32_t PERIOD) {
+
+#if SCH_FAST_LANE
+    if (SCH_FAST_HANDLE(TASK_HANDLE)) {
+        return SCH_Fast_Reschedule(SCH, TASK_HANDLE, DELAY, PERIOD);
+    }
+#endif
+
+    sch_index_t slot = SCH_Handle_To_Slot(SCH, TASK_HANDLE);
+    if (slot == SCH_NO_SLOT) {
+        SCH->error_code = ERROR_SCH_CANNOT_DELETE_TASK;
+        return RETURN_ERROR;
+    }
+    if (!SCH_Ticks_Check(SCH, DELAY, PERIOD) || !SCH_Admit_Reschedule(SCH, slot, DELAY, PERIOD)) {
+        return RETURN_ERROR;
+    }
+
+    // Task đang chạy tự Reschedule → Dispatch không re-arm nó nữa
+    if (slot == SCH->running_slot) {
+        SCH->running_slot = SCH_NO_SLOT;
+    }
+
+    // Tìm và bỏ mục cũ của slot khỏi hàng đợi
+    for (uint32_t pos = 0; pos < SCH->queue_len; pos++) {
+        if (SCH->order[pos] == slot) {
+            SCH_Queue_Remove_At(SCH, pos);
+            break;
+        }
+    }
+
+    SCH_TASK_DELAY(slot) = QUEUE_KEY(DELAY);
+    SCH_TASK_PERIOD(slot) = PERIOD;
+    SCH_TASK_RUNME(slot) = 0;
+    SCH_Set_Due(SCH, slot, SCH->tick_now + ((DELAY > 0) ? DELAY : 1));
+
+#if SCH_TIMEBASE == SCH_TIMEBASE_RELATIVE
+    if (SCH->queue_len == 0) {
+        SCH->elapsed_time = 0;
+    }
+#endif
+    SCH_Queue_Insert(SCH, slot);
+    SCH_Update_Marking(SCH);
+
+    return RETURN_NORMAL;
+}
+
+/**
+ * ============================================================================
+ * HÀM: SCH_Update_Marking (PRIVATE)
+ * ============================================================================
+ * MÔ TẢ: Cập nhật mảng MARKING - đánh dấu task nào có cùng delay với task[0]
+ *
+ * TẠI SAO CẦN MARKING?
+ *   - Để biết những task nào sẽ "sẵn sàng chạy cùng lúc"
+ *   - Giúp cập nhật hàng loạt trong Dispatch
+ *
+ * VÍ DỤ:
+ *   Task[0]: Delay=10  → MARKING[0]=1 ✅
+ *   Task[1]: Delay=10  → MARKING[1]=1 ✅ (cùng delay với task[0])
+ *   Task[2]: Delay=20  → MARKING[2]=0 ❌
+ *   Task[3]: Delay=30  → MARKING[3]=0 ❌
+ *
+ *   Kết quả: MARKING = [1, 1, 0, 0]
+ *   → 2 task đầu sẽ sẵn sàng cùng lúc!
+ *
+ * SCH_COMPACT: không có mảng MARKING, chỉ lưu mark_delay = 10 - O(1)
+ *   (QUEUE_MARKED so Delay từng task với mark_delay lúc Dispatch)
+ * SCH_TIMEBASE_ABSOLUTE: không cần đánh dấu → hàm rỗng
+ * ============================================================================
+ */
+static void SCH_Update_Marking(SCH_Instance_t *SCH) {
+    if (SCH->queue_len == 0) return;
+
+#if SCH_TIMEBASE == SCH_TIMEBASE_ABSOLUTE
+    // Dispatch tự so tick đến hạn của từng task với SCH->tick_now
+#elif SCH_COMPACT
+    SCH->mark_delay = QUEUE_DELAY(0);
+#else
+    // Lấy delay của task đầu tiên làm chuẩn
+    uint32_t first_delay = QUEUE_DELAY(0);
+
+    // Duyệt tất cả task và đánh dấu
+    for (uint32_t n = 0; n < SCH->queue_len; n++) {
+        if (QUEUE_DELAY(n) == first_delay) {
+            SCH->marking[n] = 1; // ✅ Đánh dấu: cùng delay với task đầu
+        } else {
+            SCH->marking[n] = 0; // ❌ Không đánh dấu: delay khác
+        }
+    }
+#endif
+}
+
+/**
+ * ============================================================================
+ * HÀM: SCH_Rearm_Head (PRIVATE)
+ * ============================================================================
+ * MÔ TẢ: Đặt lại task periodic ở đầu mảng (vừa chạy xong) vào vị trí mới
+ *        với Delay = tới lần phát hành kế tiếp (SCH_Rearm_Due, thường là
+ *        Period) - KHÔNG xóa rồi thêm lại
+ *
+ * SO VỚI Delete(0) + Add():
+ *   - Delete(0): dịch TOÀN BỘ mảng sang trái + 1 lần SCH_Update_Marking
+ *   - Add():     tìm vị trí + dịch mảng sang phải + 1 lần SCH_Update_Marking
+ *   - Rearm:     chỉ dịch các slot nằm TRƯỚC vị trí mới sang trái 1 ô
+ *                → số thao tác = số task có Delay <= Period (thường rất ít)
+ *   - MARKING được cập nhật 1 lần ở cuối SCH_Dispatch_Tasks()
+ *
+ * GIỮ NGUYÊN: slot, pTask, Period, TaskID (handle vẫn hợp lệ)
+ *
+ * VÍ DỤ: Task A (Period=5) vừa chạy
+ *   Trước: [A:0, B:2, C:5, D:9]
+ *   Sau:   [B:2, C:5, A:5, D:9]   ← chỉ B, C dịch trái; D không bị đụng tới
+ * ============================================================================
+ */
+static void SCH_Rearm_Head(SCH_Instance_t *SCH) {
+    sch_index_t slot = SCH->order[0];
+    uint32_t ticks = SCH_Rearm_Due(SCH, slot) - SCH->tick_now;
+    uint32_t new_delay = QUEUE_KEY(ticks);
+    uint32_t pos = 0;
+
+    // Tìm vị trí mới (sau các task có cùng delay - giống SCH_Add_Task)
+    // đồng thời dịch các slot đứng trước vị trí đó sang trái 1 ô
+    while (pos + 1 < SCH->queue_len && QUEUE_KEY_LE(QUEUE_DELAY(pos + 1), new_delay)) {
+        SCH->order[pos] = SCH->order[pos + 1];
+        pos++;
+    }
+
+    // Đặt slot vào vị trí mới (RunMe = 0 giống như khi Add lại)
+    SCH_TASK_DELAY(slot) = new_delay;
+    SCH_TASK_RUNME(slot) = 0;
+    SCH->order[pos] = slot;
+}
+
+/**
+ * ============================================================================
+ * HÀM: SCH_Update_In
+ * ============================================================================
+ * MÔ TẢ: Hàm cập nhật - GỌI TRONG INTERRUPT TIMER
+ *
+ * ĐỘ PHỨC TẠP: O(1) ⚡ - KEY OPTIMIZATION!
+ *
+ * CÁCH HOẠT ĐỘNG:
+ *   1. CHỈ giảm delay của task đầu tiên (task sớm nhất)
+ *   2. Tăng bộ đếm thời gian đã trôi qua
+ *   3. Nếu task đầu đã đến giờ → đặt cờ RunMe
+ *
+ * TẠI SAO CHỈ CẬP NHẬT TASK ĐẦU?
+ *   - Mảng đã được sắp xếp theo delay
+ *   - Task[0] LUÔN là task sớm nhất
+ *   - Các task khác sẽ được cập nhật trong Dispatch
+ *   → Tiết kiệm thời gian trong interrupt!
+ *
+ * GỌI TỪ ĐÂU:
+ *   void HAL_TIM_PeriodElapsedCallback(TIM_HandleTypeDef *htim) {
+ *       if (htim->Instance == TIM2) {
+ *           SCH_Update();  // ← Gọi ở đây
+ *       }
+ *   }
+ *
+ * VÍ DỤ TIMELINE (Tick = 10ms):
+ *   Ban đầu:
+ *     Task[0]: Delay=3
+ *     Task[1]: Delay=5
+ *     elapsed_time = 0
+ *
+ *   Tick 1 (10ms):
+ *     Task[0]: Delay=2  ← Giảm
+ *     elapsed_time = 1
+ *
+ *   Tick 2 (20ms):
+ *     Task[0]: Delay=1
+ *     elapsed_time = 2
+ *
+ *   Tick 3 (30ms):
+ *     Task[0]: Delay=0, RunMe=1  ← ĐẾN GIỜ! Đặt cờ
+ *     elapsed_time = 3
+ *
+ * SCH_TIMEBASE_ABSOLUTE: không giảm gì cả, chỉ so tick đến hạn của task
+ *   đầu với SCH->tick_now (Task[0].Delay = 103 → đặt cờ ở tick 103)
+ * ============================================================================
+ */
+void SCH_Update_In(SCH_Instance_t *SCH) {
+    SCH->tick_now++;
+    SCH_TICK_STAMP();
+    SCH_TRACE_RECORD(SCH_TRACE_TICK, SCH->tick_now, 0);
+
+#if SCH_TIMEBASE == SCH_TIMEBASE_ABSOLUTE
+    if (SCH->queue_len > 0 && QUEUE_DUE(0)) {
+        sch_index_t head = SCH->order[0];
+
+        // Task đầu đã đến hạn → đặt cờ RunMe (bão hòa ở 255)
+        if (SCH_TASK_RUNME(head) < 0xFFu) {
+            SCH_TASK_RUNME(head)++;
+        } else {
+            SCH_RunMe_Saturated(SCH, head);
+        }
+    }
+#else
+    if (SCH->queue_len > 0) {
+        sch_index_t head = SCH->order[0];
+
+        // CHỈ giảm delay của task đầu tiên
+        if (SCH_TASK_DELAY(head) > 0) {
+            SCH_TASK_DELAY(head)--;
+        }
+
+        // Đếm thời gian đã trôi qua (dùng trong Dispatch)
+        SCH->elapsed_time++;
+
+        // Nếu task đầu tiên đã đến giờ → đặt cờ RunMe (bão hòa ở 255)
+        if (SCH_TASK_DELAY(head) == 0) {
+            if (SCH_TASK_RUNME(head) < 0xFFu) {
+                SCH_TASK_RUNME(head)++;
+            } else {
+                SCH_RunMe_Saturated(SCH, head);
+            }
+        }
+    }
+#endif
+}
+
+/**
+ * ============================================================================
+ * HÀM: SCH_Dispatch_Tasks_In
+ * ============================================================================
+ * MÔ TẢ: Thực thi các task đã sẵn sàng - GỌI TRONG MAIN LOOP
+ *
+ * ĐỘ PHỨC TẠP: O(n²) trong trường hợp xấu nhất
+ *
+ * CÁCH HOẠT ĐỘNG (2 BƯỚC):
+ *   (Trước tiên: thực hiện lệnh từ ngắt - SCH_Process_Commands,
+ *    rồi các task làn nhanh đã phát hành - SCH_Fast_Dispatch)
+ *
+ *   BƯỚC 1: CẬP NHẬT DELAY CHO TẤT CẢ TASK
+ *     - Những task có MARKING=1: Đặt Delay=0, RunMe=1
+ *     - Những task có MARKING=0: Trừ đi thời gian đã trôi qua
+ *
+ *   BƯỚC 2: THỰC THI CÁC TASK SẴN SÀNG
+ *     - SCH_PRIORITY: chọn task lớp cao nhất trong các task sẵn sàng
+ *       (SCH_Queue_Pick) trước MỖI task
+ *     - Kiểm tra trễ hạn (SCH_Deadline_Check) rồi gọi hàm task
+ *     - Task đã bị xóa (pTask=0): bỏ khỏi hàng đợi, trả slot, không chạy
+ *     - Nếu là one-shot (Period=0): Xóa task
+ *     - Nếu là periodic: Re-arm tại chỗ ở lần phát hành kế tiếp (SCH_Rearm_Head)
+ *       (REPLAY còn lần chạy bù → giữ ở đầu hàng đợi, chạy lại ngay)
+ *
+ * GỌI TỪ ĐÂU:
+ *   int main(void) {
+ *       SCH_Init();
+ *       SCH_Add_Task(...);
+ *
+ *       while(1) {
+ *           SCH_Dispatch_Tasks();  // ← Gọi ở đây
+ *       }
+ *   }
+ *
+ * VÍ DỤ CHI TIẾT:
+ *   Ban đầu (sau khi Update đặt cờ):
+ *     Task[0]: {LED_Toggle, Delay=0, Period=100, RunMe=1} MARKING=1
+ *     Task[1]: {Buzzer, Delay=0, Period=50, RunMe=0}      MARKING=1
+ *     Task[2]: {Sensor, Delay=50, Period=200, RunMe=0}    MARKING=0
+ *     elapsed_time = 100  ← Đã trôi qua 100 tick
+ *
+ *   BƯỚC 1: Sau khi Dispatch_Tasks - Cập nhật delay cho từng task
+ *     Task[0]: Delay=0, RunMe=1      (MARKING=1 → giữ nguyên)
+ *     Task[1]: Delay=0, RunMe=1      (MARKING=1 → đặt cờ!)
+ *     Task[2]: Delay=50-100=-50 → 0  (MARKING=0 → trừ đi 100)
+ *
+ *   BƯỚC 2: Thực thi
+ *     - Chạy LED_Toggle() → Re-arm với Delay=100
+ *     - Chạy Buzzer() → Re-arm với Delay=50
+ *     - Chạy Sensor() (nếu RunMe=1)
+ *
+ *   Kết quả:
+ *     Task[0]: {Buzzer, Delay=50, Period=50}
+ *     Task[1]: {LED_Toggle, Delay=100, Period=100}
+ *     Task[2]: {Sensor, Delay=200, Period=200}
+ *     elapsed_time = 0  ← Reset
+ *
+ * SCH_TIMEBASE_ABSOLUTE: KHÔNG có BƯỚC 1 - Delay là tick đến hạn tuyệt
+ *   đối, không phải trừ gì. BƯỚC 2 chạy lần lượt task đầu hàng đợi chừng
+ *   nào nó đã đến hạn → chỉ đụng tới các task thực sự chạy, O(1) mỗi task
+ *   (+ phần dịch của SCH_Rearm_Head)
+ * ============================================================================
+ */
+void SCH_Dispatch_Tasks_In(SCH_Instance_t *SCH) {
+
+    SCH_TRACE_RECORD(SCH_TRACE_DISPATCH_BEGIN, SCH->tick_now, 0);
+
+    // Thực hiện các lệnh thêm/xóa task do ngắt gửi tới
+    SCH_Process_Commands(SCH);
+
+#if SCH_FAST_LANE
+    // Làn nhanh (SysTick) trước: các task 1ms không phải chờ làn 10ms
+    SCH_Fast_Dispatch(SCH);
+#endif
+
+    // Kiểm tra có task nào sẵn sàng không
+    if (SCH->queue_len > 0 && QUEUE_READY(0)) {
+
+#if SCH_TIMEBASE == SCH_TIMEBASE_RELATIVE
+        /* ========== BƯỚC 1: CẬP NHẬT DELAY CHO TẤT CẢ TASK ========== */
+        for (uint32_t m = 0; m < SCH->queue_len; m++) {
+            sch_index_t slot = SCH->order[m];
+            if (!QUEUE_MARKED(m)) {
+                // Task có delay KHÁC với task đầu
+                // → Trừ đi thời gian đã trôi qua
+                if (SCH_TASK_DELAY(slot) >= SCH->elapsed_time) {
+                    SCH_TASK_DELAY(slot) -= SCH->elapsed_time;
+                } else {
+                    SCH_TASK_DELAY(slot) = 0;
+                }
+            } else {
+                // Task có CÙNG delay với task đầu
+                // → Cũng sẵn sàng chạy!
+                SCH_TASK_DELAY(slot) = 0;
+                SCH_TASK_RUNME(slot) = 1;
+            }
+        }
+#endif
+
+        /* ========== BƯỚC 2: VÒNG LẶP THỰC THI CÁC TASK SẴN SÀNG ========== */
+        while (SCH->queue_len > 0 && QUEUE_READY(0)) {
+#if SCH_PRIORITY
+            // Lớp cao nhất trong các task sẵn sàng lên đầu (gồm cả task
+            // vừa đến hạn trong lúc task trước chạy - TIMEBASE_ABSOLUTE)
+            SCH_Queue_Pick(SCH);
+#endif
+            sch_index_t slot = SCH->order[0];
+
+#if SCH_TIMEBASE == SCH_TIMEBASE_ABSOLUTE
+            // Đến hạn cùng tick với task đầu → SCH_Update chưa đặt cờ
+            if (SCH_TASK_RUNME(slot) == 0) {
+                SCH_TASK_RUNME(slot) = 1;
+            }
+#endif
+
+            // 0. TASK ĐÃ BỊ DELETE → bỏ khỏi hàng đợi, trả slot
+            if (SCH_TASK_FN(slot) == 0x0000) {
+                SCH_Queue_Remove_At(SCH, 0);
+                SCH_Slot_Release(SCH, slot);
+                continue;
+            }
+
+            // 1. KIỂM TRA TRỄ HẠN, CHẠY TASK (SKIP: lỡ chu kỳ → không chạy)
+            SCH->running_slot = slot;
+            if (SCH_Deadline_Check(SCH, slot)) {
+                SCH_Run_Task(SCH, slot); // Gọi hàm task! (có đo thời gian)
+            }
+
+            // Task tự Reschedule chính nó → đã được xếp lại, bỏ qua
+            if (SCH->running_slot == SCH_NO_SLOT) {
+                continue;
+            }
+            SCH->running_slot = SCH_NO_SLOT;
+
+            // 2. HẠ CỜ
+            SCH_TASK_RUNME(slot)--;
+
+            // 3. XỬ LÝ TASK DỰA VÀO PERIOD
+            if (SCH_TASK_FN(slot) == 0x0000) {
+                /* Task tự Delete chính nó trong lúc chạy */
+                SCH_Queue_Remove_At(SCH, 0);
+                SCH_Slot_Release(SCH, slot);
+            } else if (SCH_TASK_PERIOD(slot) == 0) {
+                /* ONE-SHOT TASK: Chỉ chạy 1 lần → XÓA */
+                SCH_Slot_Kill(SCH, slot);
+                SCH_Queue_Remove_At(SCH, 0);
+                SCH_Slot_Release(SCH, slot);
+            } else if (SCH_Replay_Pending(SCH, slot)) {
+                /* REPLAY: còn lần chạy bù → giữ ở đầu hàng đợi, chạy lại ngay */
+                SCH_TASK_RUNME(slot) = 1;
+            } else {
+                /* PERIODIC TASK: Lặp lại → RE-ARM TẠI CHỖ */
+                // VÍ DỤ: Period=100 → chạy lại 100 tick sau lần phát hành vừa rồi
+                SCH_Rearm_Head(SCH);
+            }
+        }
+
+        // Cập nhật MARKING 1 lần cho cả đợt dispatch
+        SCH_Update_Marking(SCH);
+
+#if SCH_TIMEBASE == SCH_TIMEBASE_RELATIVE
+        // Reset bộ đếm thời gian
+        SCH->elapsed_time = 0;
+#endif
+    }
+
+    // Báo cáo lỗi (trễ hạn, RunMe bão hòa, ...)
+    // SCH_Go_To_Sleep() được gọi trong main loop, sau Dispatch
+    SCH_Report_Status_In(SCH);
+
+    SCH_TRACE_RECORD(SCH_TRACE_DISPATCH_END, SCH->tick_now, 0);
+}
+
+/**
+ * ============================================================================
+ * HÀM: SCH_Idle_Ticks / SCH_Skip_Ticks (INTERNAL - TICKLESS IDLE)
+ * ============================================================================
+ * MÔ TẢ:
+ *   - Idle_Ticks: số tick cho tới khi task đầu hàng đợi đến giờ
+ *                 = Delay của task đầu (Delay = 0 → tick kế tiếp)
+ *   - Skip_Ticks: bù các tick đã ngủ qua mà SCH_Update() không được gọi
+ *                 → trừ vào Delay của task đầu + cộng vào elapsed_time
+ *                 và SCH->tick_now,
+ *                 y như SCH_Update() đã chạy TICKS lần
+ *
+ * VÍ DỤ: Task đầu Delay=30 → ngủ 30 tick
+ *   Khi thức: Skip_Ticks(29) → Delay=1, elapsed_time += 29
+ *   Ngắt TIM2 (tick thứ 30) → SCH_Update() → Delay=0, RunMe=1
+ *
+ * SCH_TIMEBASE_ABSOLUTE: Idle = tick đến hạn - SCH->tick_now,
+ *   Skip chỉ cộng SCH->tick_now (hạn tuyệt đối không đổi)
+ * ============================================================================
+ */
+uint32_t SCH_Idle_Ticks(SCH_Instance_t *SCH) {
+    if (SCH->queue_len == 0) {
+        return SCH_IDLE_FOREVER;
+    }
+    if (QUEUE_READY(0)) {
+        return 0;
+    }
+#if SCH_TIMEBASE == SCH_TIMEBASE_ABSOLUTE
+    return (uint32_t)QUEUE_DELAY(0) - SCH->tick_now;
+#else
+    return (QUEUE_DELAY(0) > 0) ? QUEUE_DELAY(0) : 1;
+#endif
+}
+
+void SCH_Skip_Ticks(SCH_Instance_t *SCH, uint32_t TICKS) {
+    SCH->tick_now += TICKS;
+#if SCH_TIMEBASE == SCH_TIMEBASE_RELATIVE
+    if (SCH->queue_len == 0 || TICKS == 0) return;
+
+    sch_index_t head = SCH->order[0];
+    SCH_TASK_DELAY(head) = (SCH_TASK_DELAY(head) > TICKS) ? (SCH_TASK_DELAY(head) - TICKS) : 0;
+    SCH->elapsed_time += TICKS;
+#endif
+}
+
+#endif /* SCH_BACKEND == SCH_BACKEND_SORTED_ARRAY */
+
+/**
+ * ============================================================================
+ * HÀM: SCH_Report_Status_In
+ * ============================================================================
+ * MÔ TẢ: Báo cáo trạng thái hệ thống - gọi ở cuối SCH_Dispatch_Tasks()
+ *
+ * CÁCH HOẠT ĐỘNG:
+ *   - Error_code_G thay đổi → gọi SCH_Error_Hook(mã lỗi mới)
+ *   - Không có lỗi mới trong SCH_ERROR_HOLD_TICKS tick → xóa Error_code_G
+ *     và gọi SCH_Error_Hook(0)
+ *   → Lỗi thoáng qua vẫn được giữ đủ lâu để kịp nhìn thấy
+ *
+ * CÁCH SỬ DỤNG: override SCH_Error_Hook() để
+ *   - Hiển thị mã lỗi trên LED
+ *   - Gửi qua UART để debug
+ *   - Lưu vào log
+ * ============================================================================
+ */
+void SCH_Report_Status_In(SCH_Instance_t *SCH) {
+    uint8_t code = SCH->error_code;
+
+    if (code != SCH->last_error_code) {
+        // Có lỗi mới (hoặc lỗi đã được xóa)
+        SCH->last_error_code = code;
+        SCH->error_tick = SCH->tick_now;
+        SCH_TRACE_RECORD(SCH_TRACE_ERROR, 0, code);
+        SCH_Error_Hook(code);
+    } else if (code != 0 && (SCH->tick_now - SCH->error_tick) >= SCH_ERROR_HOLD_TICKS) {
+        // Lỗi không lặp lại trong SCH_ERROR_HOLD_TICKS → xóa
+        SCH->error_code = 0;
+        SCH->last_error_code = 0;
+        SCH_TRACE_RECORD(SCH_TRACE_ERROR, 0, 0);
+        SCH_Error_Hook(0);
+    }
+}
+
+/**
+ * ============================================================================
+ * HÀM: SCH_Error_Hook (WEAK)
+ * ============================================================================
+ * MÔ TẢ: Mặc định không làm gì - định nghĩa lại trong ứng dụng
+ *
+ * VÍ DỤ:
+ *   void SCH_Error_Hook(uint8_t ERROR_CODE) {
+ *       // HAL_GPIO_WritePort(ERROR_PORT, ERROR_CODE);
+ *   }
+ * ============================================================================
+ */
+__weak void SCH_Error_Hook(uint8_t ERROR_CODE) {
+    (void)ERROR_CODE;
+}
+
+/**
+ * ============================================================================
+ * HÀM: SCH_Get_Current_Size_In
+ * ============================================================================
+ * MÔ TẢ: Lấy số lượng task hiện tại
+ *
+ * VÍ DỤ:
+ *   uint32_t num_tasks = SCH_Get_Current_Size();
+ *   printf("Có %d tasks đang chạy\n", num_tasks);
+ * ============================================================================
+ */
+uint32_t SCH_Get_Current_Size_In(SCH_Instance_t *SCH) {
+    return SCH->task_count;
+}
+
+/**
+ * ============================================================================
+ * HÀM: SCH_Get_Tick_In
+ * ============================================================================
+ * MÔ TẢ: Số tick kể từ SCH_Init (tính cả các tick đã ngủ qua khi tickless)
+ *
+ * VÍ DỤ - Đo khoảng thời gian (đúng cả khi bộ đếm tràn):
+ *   uint32_t start = SCH_Get_Tick();
+ *   ...
+ *   uint32_t ms = (SCH_Get_Tick() - start) * TIMER_TICK_MS;
+ * ============================================================================
+ */
+uint32_t SCH_Get_Tick_In(SCH_Instance_t *SCH) {
+    return SCH->tick_now;
+}
+
+/**
+ * ============================================================================
+ * HÀM: SCH_Get_Task_Profile_In
+ * ============================================================================
+ * MÔ TẢ: Lấy thời gian chạy của 1 task (min / max / trung bình / tổng)
+ *        Đơn vị: chu kỳ CPU trên target (8 chu kỳ = 1us ở 8MHz),
+ *                nano giây trên host (SCH_HOST_SIM)
+ *
+ * TRẢ VỀ:
+ *   - RETURN_NORMAL: PROFILE đã được ghi
+ *   - RETURN_ERROR: handle sai / task đã bị xóa / SCH_PROFILE = 0
+ *
+ * VÍ DỤ - WCET của task hiển thị:
+ *   SCH_Task_Profile_t p;
+ *   if (SCH_Get_Task_Profile(display_id, &p) == RETURN_NORMAL) {
+ *       // p.Max_Cycles / 8 = thời gian chạy lâu nhất (us)
+ *       // p.Mean_Cycles / 8 = thời gian chạy trung bình (us)
+ *   }
+ * ============================================================================
+ */
+uint8_t SCH_Get_Task_Profile_In(SCH_Instance_t *SCH, const SCH_Handle_t TASK_HANDLE, SCH_Task_Profile_t *PROFILE) {
+#if SCH_PROFILE
+    sch_index_t slot = SCH_Handle_To_Slot(SCH, TASK_HANDLE);
+
+    if (slot == SCH_NO_SLOT || PROFILE == 0x0000) {
+        return RETURN_ERROR;
+    }
+
+    *PROFILE = SCH->task_profile[slot];
+    if (PROFILE->Count == 0) {
+        PROFILE->Min_Cycles = 0;    // Chưa chạy lần nào
+    } else {
+        PROFILE->Mean_Cycles = (uint32_t)(PROFILE->Total_Cycles / PROFILE->Count);
+    }
+    return RETURN_NORMAL;
+#else
+    (void)TASK_HANDLE;
+    (void)PROFILE;
+    return RETURN_ERROR;
+#endif
+}
+
+/**
+ * ============================================================================
+ * HÀM: SCH_Reset_Task_Profiles_In
+ * ============================================================================
+ * MÔ TẢ: Xóa profile của tất cả task (VD: bỏ qua các lần chạy lúc khởi động)
+ * ============================================================================
+ */
+void SCH_Reset_Task_Profiles_In(SCH_Instance_t *SCH) {
+#if SCH_PROFILE
+    for (uint32_t i = 0; i < SCH_MAX_TASKS; i++) {
+        SCH_Profile_Clear(SCH, (sch_index_t)i);
+    }
+#endif
+}
+
+/**
+ * ============================================================================
+ * HÀM: SCH_Get_Task_Misses_In
+ * ============================================================================
+ * MÔ TẢ: Lấy thống kê trễ hạn của 1 task
+ *
+ * VÍ DỤ - FSM có giữ được nhịp 10ms không?
+ *   SCH_Task_Misses_t m;
+ *   SCH_Get_Task_Misses(fsm_id, &m);
+ *   // m.Missed_Periods > 0 → đã có lúc FSM không chạy đúng mỗi 10ms
+ *   // m.Phase_Error > 0    → nhịp của FSM đã lệch khỏi đồng hồ thật
+ * ============================================================================
+ */
+uint8_t SCH_Get_Task_Misses_In(SCH_Instance_t *SCH, const SCH_Handle_t TASK_HANDLE, SCH_Task_Misses_t *MISSES) {
+    sch_index_t slot = SCH_Handle_To_Slot(SCH, TASK_HANDLE);
+
+    if (slot == SCH_NO_SLOT || MISSES == 0x0000) {
+        return RETURN_ERROR;
+    }
+    *MISSES = SCH->task_misses[slot];
+    return RETURN_NORMAL;
+}
+
+#if SCH_PRIORITY
+
+/* ==================== LỚP ƯU TIÊN (SCH_PRIORITY) ==================== */
+
+/**
+ * ============================================================================
+ * HÀM: SCH_Task_Class (INTERNAL)
+ * ============================================================================
+ * MÔ TẢ: Lớp ưu tiên của task ở slot - Dispatch của các backend dùng để
+ *        chọn task chạy trước
+ * ============================================================================
+ */
+uint8_t SCH_Task_Class(SCH_Instance_t *SCH, sch_index_t slot) {
+    return SCH->task_class[slot];
+}
+
+/**
+ * ============================================================================
+ * HÀM: SCH_Latency_Record (PRIVATE)
+ * ============================================================================
+ * MÔ TẢ: Ghi độ trễ của 1 lần phát hành, ngay trước khi task chạy
+ *        Mốc phát hành = SCH_Update() của tick đến hạn:
+ *          độ trễ = (bây giờ - SCH->tick_cycles) + trễ (tick) x chu kỳ/tick
+ *        (tick đến hạn đã qua thì SCH->tick_cycles là của tick sau đó)
+ *
+ * VÍ DỤ (8MHz, 80000 chu kỳ/tick): FSM đến hạn ở tick hiện tại, chạy
+ *   sau Display 2400 chu kỳ → độ trễ 2400 + dispatch; trễ 1 tick → + 80000
+ * ============================================================================
+ */
+static void SCH_Latency_Record(SCH_Instance_t *SCH, sch_index_t slot, int32_t late) {
+    SCH_Class_Latency_t *c = &SCH->class_latency[SCH->task_class[slot]];
+    uint32_t cycles = SCH_Cycles_Now() - SCH->tick_cycles;
+
+    if (late > 0) {
+        cycles += (uint32_t)late * SCH_CYCLES_PER_TICK;
+    }
+
+    c->Count++;
+    c->Total_Cycles += cycles;
+    if (cycles > c->Max_Cycles) c->Max_Cycles = cycles;
+}
+
+/**
+ * ============================================================================
+ * HÀM: SCH_Set_Task_Class_In
+ * ============================================================================
+ * MÔ TẢ: Đặt lớp ưu tiên cho task (mặc định SCH_CLASS_NORMAL)
+ *        Nhiều task cùng sẵn sàng → lớp nhỏ hơn chạy trước
+ *        Task trong bảng SCH_TASK_TABLE: lấy handle bằng SCH_TABLE_HANDLE
+ *        Handle stage → lớp giảm tải của stage (SCH_Stage_Set_Class)
+ *
+ * VÍ DỤ - FSM không phải chờ Display:
+ *   SCH_Set_Task_Class(SCH_TABLE_HANDLE(0), SCH_CLASS_CRITICAL);  // FSM
+ *   SCH_Set_Task_Class(SCH_TABLE_HANDLE(1), SCH_CLASS_BACKGROUND);// Display
+ * ============================================================================
+ */
+uint8_t SCH_Set_Task_Class_In(SCH_Instance_t *SCH, const SCH_Handle_t TASK_HANDLE, uint8_t CLASS) {
+#if SCH_PIPELINE
+    if (SCH_STAGE_HANDLE(TASK_HANDLE)) {
+        return SCH_Stage_Set_Class(SCH, TASK_HANDLE, CLASS);
+    }
+#endif
+
+    sch_index_t slot = SCH_Handle_To_Slot(SCH, TASK_HANDLE);
+
+    if (slot == SCH_NO_SLOT || CLASS >= SCH_CLASSES) {
+        return RETURN_ERROR;
+    }
+    if (SCH->task_class[slot] != CLASS) {
+        SCH->task_class[slot] = CLASS;
+        SCH_Class_Changed(SCH, slot);
+    }
+    return RETURN_NORMAL;
+}
+
+/**
+ * ============================================================================
+ * HÀM: SCH_Get_Class_Latency_In
+ * ============================================================================
+ * MÔ TẢ: Độ trễ phát hành → bắt đầu chạy của 1 lớp (tệ nhất, trung bình)
+ *        và Blocking_Cycles = WCET đo được (SCH_PROFILE) lớn nhất của các
+ *        task lớp thấp hơn đang có - task lớp này chờ tối đa 1 task như vậy
+ *
+ * VÍ DỤ - Kiểm tra giới hạn của FSM:
+ *   SCH_Class_Latency_t l;
+ *   SCH_Get_Class_Latency(SCH_CLASS_CRITICAL, &l);
+ *   // l.Max_Cycles <= l.Blocking_Cycles + WCET các task CRITICAL khác
+ *   //                 + chi phí Dispatch
+ * ============================================================================
+ */
+uint8_t SCH_Get_Class_Latency_In(SCH_Instance_t *SCH, uint8_t CLASS, SCH_Class_Latency_t *LATENCY) {
+    if (CLASS >= SCH_CLASSES || LATENCY == 0x0000) {
+        return RETURN_ERROR;
+    }
+
+    *LATENCY = SCH->class_latency[CLASS];
+    if (LATENCY->Count > 0) {
+        LATENCY->Mean_Cycles = (uint32_t)(LATENCY->Total_Cycles / LATENCY->Count);
+    }
+
+    LATENCY->Blocking_Cycles = 0;
+#if SCH_PROFILE
+    for (uint32_t slot = 0; slot < SCH->fresh_slot; slot++) {
+        if (SCH_TASK_FN(slot) == 0x0000 || SCH->task_class[slot] <= CLASS) continue;
+        if (SCH->task_profile[slot].Max_Cycles > LATENCY->Blocking_Cycles) {
+            LATENCY->Blocking_Cycles = SCH->task_profile[slot].Max_Cycles;
+        }
+    }
+#endif
+    return RETURN_NORMAL;
+}
+
+#endif /* SCH_PRIORITY */
+
+#if SCH_UTIL
+
+/* ==================== TẢI CPU (SCH_UTIL) ==================== */
+
+/**
+ * ============================================================================
+ * HÀM: SCH_Util_Clear / SCH_Util_Advance (PRIVATE)
+ * ============================================================================
+ * MÔ TẢ:
+ *   - Clear:   xóa lịch sử tải (SCH_Init)
+ *   - Advance: đóng tick / giây đang đếm khi đã sang tick mới
+ *       tick xong  → cập nhật tick nặng nhất của giây
+ *       giây xong  → lưu (thời gian chạy, tick nặng nhất) vào lịch sử,
+ *                    các giây ngủ trọn (tickless) lưu 0
+ *   Giây thứ s = các tick [s * 100, s * 100 + 99] (tick 10ms)
+ *   SCH_SHED = 1: tải của tick vừa đóng (+ các tick không có task nào
+ *   chạy ở giữa) → SCH_Shed_Tick
+ * ============================================================================
+ */
+static void SCH_Util_Clear(SCH_Instance_t *SCH) {
+    SCH->util_head = 0;
+    SCH->util_seconds = 0;
+    SCH->util_second = 0;
+    SCH->util_second_busy = 0;
+    SCH->util_second_peak = 0;
+    SCH->util_tick = 0;
+    SCH->util_tick_busy = 0;
+}
+
+static void SCH_Util_Advance(SCH_Instance_t *SCH, uint32_t tick) {
+    if (tick == SCH->util_tick) {
+        return;
+    }
+
+    if (SCH->util_tick_busy > SCH->util_second_peak) {
+        SCH->util_second_peak = SCH->util_tick_busy;
+    }
+#if SCH_SHED
+    SCH_Shed_Tick(SCH, SCH->util_tick_busy, tick - SCH->util_tick - 1u);
+#endif
+    SCH->util_tick = tick;
+    SCH->util_tick_busy = 0;
+
+    uint32_t second = tick / UTIL_TICKS_PER_SECOND;
+    uint32_t gap = second - SCH->util_second;
+    if (gap == 0) {
+        return;
+    }
+    if (gap > UTIL_HISTORY) gap = UTIL_HISTORY;
+
+    for (uint32_t i = 0; i < gap; i++) {
+        SCH->util_busy[SCH->util_head] = SCH->util_second_busy;
+        SCH->util_peak[SCH->util_head] = SCH->util_second_peak;
+        SCH->util_head = (SCH->util_head + 1u == UTIL_HISTORY) ? 0 : SCH->util_head + 1u;
+        if (SCH->util_seconds < UTIL_HISTORY) SCH->util_seconds++;
+
+        SCH->util_second_busy = 0;
+        SCH->util_second_peak = 0;
+    }
+    SCH->util_second = second;
+}
+
+/**
+ * ============================================================================
+ * HÀM: SCH_Get_Utilization_In
+ * ============================================================================
+ * MÔ TẢ: Tải CPU (thời gian chạy task / thời gian thực) trong 1s, 10s,
+ *        60s vừa qua và tick nặng nhất trong 60s - đơn vị 0.01 %
+ *        Thời gian thực tính theo tick (ngủ cũng là rảnh) → đúng cả khi
+ *        tickless (DWT CYCCNT dừng khi MCU ngủ)
+ *        Chỉ tính các giây đã trọn; mới khởi động (< 60s) → cửa sổ ngắn hơn
+ *
+ * VÍ DỤ (Button 20us + FSM 40us mỗi tick, Display 300us mỗi 5 tick):
+ *   1 giây: 100 * 60us + 20 * 300us = 12ms → Load_1s = 120 (1.20 %)
+ *   Tick có Display: 360us / 10ms → Peak_Tick = 360 (3.60 %)
+ *
+ *   SCH_Utilization_t u;
+ *   SCH_Get_Utilization(&u);
+ *   // Còn (10000 - u.Load_60s) / 100 % CPU cho tính năng mới
+ * ============================================================================
+ */
+void SCH_Get_Utilization_In(SCH_Instance_t *SCH, SCH_Utilization_t *UTIL) {
+    static const uint32_t windows[3] = { 1, 10, 60 };
+    uint32_t load[3] = { 0, 0, 0 };
+    uint64_t busy = 0;
+    uint32_t peak = 0;
+    uint32_t w = 0;
+
+    if (UTIL == 0x0000) {
+        return;
+    }
+
+    SCH_Util_Advance(SCH, SCH->tick_now);
+
+    // Cộng dồn từ giây mới nhất về trước, chốt tải ở 1, 10, 60 giây
+    for (uint32_t i = 1; i <= SCH->util_seconds; i++) {
+        uint32_t idx = (SCH->util_head + UTIL_HISTORY - i) % UTIL_HISTORY;
+        busy += SCH->util_busy[idx];
+        if (SCH->util_peak[idx] > peak) peak = SCH->util_peak[idx];
+
+        while (w < 3 && (i == windows[w] || i == SCH->util_seconds)) {
+            load[w] = (uint32_t)(busy * 10000u / ((uint64_t)i * SCH_CYCLES_PER_SECOND));
+            w++;
+        }
+    }
+
+    uint64_t tick_cycles = (uint64_t)SCH_CYCLES_PER_SECOND / UTIL_TICKS_PER_SECOND;
+    uint64_t peak_load = (uint64_t)peak * 10000u / tick_cycles;
+
+    UTIL->Load_1s = (uint16_t)((load[0] < 10000u) ? load[0] : 10000u);
+    UTIL->Load_10s = (uint16_t)((load[1] < 10000u) ? load[1] : 10000u);
+    UTIL->Load_60s = (uint16_t)((load[2] < 10000u) ? load[2] : 10000u);
+    UTIL->Peak_Tick = (uint16_t)((peak_load < 10000u) ? peak_load : 10000u);
+    UTIL->Peak_Tick_Cycles = peak;
+    UTIL->Seconds = SCH->util_seconds;
+}
+
+#endif /* SCH_UTIL */
+
+#if SCH_SHED
+
+/* ==================== GIẢM TẢI KHI QUÁ TẢI (SCH_SHED) ==================== */
+
+// Ngưỡng tải của 1 tick (đơn vị profiler)
+#define SHED_HIGH_CYCLES    ((uint32_t)((uint64_t)SCH_CYCLES_PER_TICK * SCH_SHED_HIGH_PCT / 100u))
+#define SHED_LOW_CYCLES     ((uint32_t)((uint64_t)SCH_CYCLES_PER_TICK * SCH_SHED_LOW_PCT / 100u))
+
+/**
+ * ============================================================================
+ * HÀM: SCH_Shed_Tick (PRIVATE)
+ * ============================================================================
+ * MÔ TẢ: Cập nhật mức giảm tải sau mỗi tick đã đóng (SCH_Util_Advance)
+ *   - Tick > SCH_SHED_HIGH_PCT %: SCH_SHED_TRIGGER_TICKS tick liên tiếp
+ *     → tăng 1 mức (tối đa SCH_SHED_PAUSE)
+ *   - Tick < SCH_SHED_LOW_PCT % (kể cả tick ngủ / không có task chạy):
+ *     SCH_SHED_RECOVER_TICKS tick liên tiếp → giảm 1 mức
+ *   - Ở giữa 2 ngưỡng: đếm lại cả 2 (giữ nguyên mức)
+ *
+ * THAM SỐ:
+ *   - busy:       thời gian chạy task trong tick vừa đóng
+ *   - idle_ticks: số tick sau nó không có task nào chạy
+ *
+ * VÍ DỤ (80000 chu kỳ/tick): telemetry làm 3 tick liền > 64000 chu kỳ
+ *   → SCH_SHED_STRETCH: Display chạy mỗi 10 tick thay vì 5, FSM giữ 1 tick
+ *   → hết tải, 100 tick liền < 40000 → SCH_SHED_NONE, Display lại 5 tick
+ * ============================================================================
+ */
+static void SCH_Shed_Tick(SCH_Instance_t *SCH, uint32_t busy, uint32_t idle_ticks) {
+    uint8_t level = SCH->shed_stats.Level;
+
+    if (busy > SHED_HIGH_CYCLES) {
+        SCH->shed_stats.Overload_Ticks++;
+        SCH->shed_calm_ticks = 0;
+        if (++SCH->shed_hot_ticks >= SCH_SHED_TRIGGER_TICKS) {
+            SCH->shed_hot_ticks = 0;
+            if (SCH->shed_stats.Level < SCH_SHED_PAUSE) {
+                SCH->shed_stats.Level++;
+                SCH->shed_stats.Escalations++;
+            }
+        }
+    } else {
+        SCH->shed_hot_ticks = 0;
+        SCH->shed_calm_ticks = (busy < SHED_LOW_CYCLES) ? SCH->shed_calm_ticks + 1u : 0;
+    }
+
+    if (idle_ticks > 0) {
+        SCH->shed_hot_ticks = 0;
+        SCH->shed_calm_ticks += idle_ticks;
+    }
+    if (SCH->shed_calm_ticks >= SCH_SHED_RECOVER_TICKS && SCH->shed_stats.Level > SCH_SHED_NONE) {
+        SCH->shed_calm_ticks = 0;
+        SCH->shed_stats.Level--;
+    }
+
+    if (SCH->shed_stats.Level != level) {
+        if (SCH->shed_stats.Level > SCH->shed_stats.Max_Level) {
+            SCH->shed_stats.Max_Level = SCH->shed_stats.Level;
+        }
+        SCH_TRACE_RECORD(SCH_TRACE_SHED, 0, SCH->shed_stats.Level);
+    }
+}
+
+/**
+ * ============================================================================
+ * HÀM: SCH_Shed_Drop (INTERNAL)
+ * ============================================================================
+ * MÔ TẢ: Có bỏ lần chạy này của việc thuộc lớp CLASS không
+ *        (task: SCH_Shed_Skip, stage: SCH_Pipeline_Run)
+ *   - CRITICAL, SCH_SHED_NONE → không bao giờ
+ *   - Bị dừng (BACKGROUND ở SCH_SHED_PAUSE) → luôn bỏ
+ *   - Bị giãn (BACKGROUND ở STRETCH, NORMAL ở PAUSE) → chạy 1 lần trong
+ *     mỗi SCH_SHED_FACTOR lần (đếm bằng *COUNT)
+ *
+ * VÍ DỤ: Display (P=5, BACKGROUND), SCH_SHED_FACTOR = 2, mức STRETCH
+ *   phát hành ở tick 5, 10, 15, 20 → chạy ở 10, 20 (bỏ 5, 15)
+ * ============================================================================
+ */
+uint8_t SCH_Shed_Drop(SCH_Instance_t *SCH, uint8_t CLASS, uint8_t *COUNT) {
+    uint8_t level = SCH->shed_stats.Level;
+
+    if (level == SCH_SHED_NONE || CLASS == SCH_CLASS_CRITICAL) {
+        return 0;
+    }
+
+    if (CLASS == SCH_CLASS_BACKGROUND && level >= SCH_SHED_PAUSE) {
+        SCH->shed_stats.Shed_Releases++;
+        return 1;                               // Dừng
+    }
+    if (CLASS == SCH_CLASS_BACKGROUND || level >= SCH_SHED_PAUSE) {
+        if (++(*COUNT) < SCH_SHED_FACTOR) {
+            SCH->shed_stats.Shed_Releases++;
+            return 1;                           // Giãn: bỏ lần này
+        }
+        *COUNT = 0;
+    }
+    return 0;
+}
+
+/**
+ * ============================================================================
+ * HÀM: SCH_Shed_Skip (PRIVATE)
+ * ============================================================================
+ * MÔ TẢ: Có bỏ lần phát hành này của task không (SCH_Deadline_Check)
+ *        Task sự kiện → không bao giờ, còn lại theo lớp (SCH_Shed_Drop)
+ * ============================================================================
+ */
+static uint8_t SCH_Shed_Skip(SCH_Instance_t *SCH, sch_index_t slot) {
+    if (SCH->task_event[slot] != TASK_POLLED) {
+        return 0;
+    }
+    return SCH_Shed_Drop(SCH, SCH->task_class[slot], &SCH->task_shed_count[slot]);
+}
+
+/**
+ * ============================================================================
+ * HÀM: SCH_Get_Shed_Stats_In
+ * ============================================================================
+ * MÔ TẢ: Chép mức giảm tải hiện tại và các bộ đếm
+ *
+ * VÍ DỤ - báo quá tải bằng LED:
+ *   SCH_Shed_Stats_t s;
+ *   SCH_Get_Shed_Stats(&s);
+ *   if (s.Level != SCH_SHED_NONE) HAL_GPIO_WritePin(...);
  * ============================================================================
  */
+void SCH_Get_Shed_Stats_In(SCH_Instance_t *SCH, SCH_Shed_Stats_t *STATS) {
+    *STATS = SCH->shed_stats;
+}
 
-#include "scheduler.h"
-
-/* ==================== BIẾN TOÀN CỤC ==================== */
-
-// Mảng chứa tất cả các task (đã sắp xếp theo Delay tăng dần)
-sTask SCH_tasks_G[SCH_MAX_TASKS];
-
-// Mã lỗi hệ thống (0 = không có lỗi)
-uint8_t Error_code_G = 0;
-
-// Mảng đánh dấu: MARKING[i]=1 nếu task[i] có cùng delay với task[0]
-// VÍ DỤ: Nếu Task[0].Delay=10, Task[1].Delay=10, Task[2].Delay=20
-//        → MARKING = [1, 1, 0]
-uint8_t MARKING[SCH_MAX_TASKS];
-
-// Số lượng task hiện đang hoạt động
-uint32_t task_count = 0;
-
-// Đếm số tick đã trôi qua kể từ lần dispatch cuối
-// VÍ DỤ: Nếu elapsed_time=50 → đã qua 50 tick (500ms với tick=10ms)
-uint32_t elapsed_time = 0;
+#endif /* SCH_SHED */
 
-/* ==================== HÀM PRIVATE (INTERNAL) ==================== */
-static void SCH_Update_Marking(void);
+#if SCH_STAGGER
 
-/* ==================== IMPLEMENTATION ==================== */
+/* ==================== CÂN BẰNG TẢI (SCH_STAGGER) ==================== */
 
 /**
  * ============================================================================
- * HÀM: SCH_Init
+ * HÀM: SCH_Task_Cost (PRIVATE)
  * ============================================================================
- * MÔ TẢ: Khởi tạo scheduler - Xóa tất cả task và reset biến
- *
- * GỌI KHI NÀO: Trong main(), trước khi thêm bất kỳ task nào
- *
- * VÍ DỤ:
- *   int main(void) {
- *       HAL_Init();
- *       SCH_Init();  // ← Gọi ở đây
- *       SCH_Add_Task(Task1, 0, 100);
- *       ...
- *   }
+ * MÔ TẢ: Thời gian chạy dùng để tính tải của task ở slot
+ *   1. Đã đo (SCH_PROFILE = 1, đã chạy ít nhất 1 lần) → trung bình đo được
+ *   2. Đã khai báo (SCH_Add_Task_Staggered / SCH_Set_Task_Cost)
+ *   3. Không có → SCH_STAGGER_DEFAULT_COST
  * ============================================================================
  */
-void SCH_Init(void) {
-    // Xóa sạch tất cả các task trong mảng
-    for (uint32_t i = 0; i < SCH_MAX_TASKS; i++) {
-        SCH_tasks_G[i].pTask = 0x0000;    // Không có hàm nào
-        SCH_tasks_G[i].Delay = 0;         // Delay = 0
-        SCH_tasks_G[i].Period = 0;        // Period = 0
-        SCH_tasks_G[i].RunMe = 0;         // Chưa cần chạy
-        SCH_tasks_G[i].TaskID = 0;        // ID = 0
-        MARKING[i] = 0;                   // Không đánh dấu
+static uint32_t SCH_Task_Cost(SCH_Instance_t *SCH, sch_index_t slot) {
+#if SCH_PROFILE
+    if (SCH->task_profile[slot].Count > 0) {
+        return (uint32_t)(SCH->task_profile[slot].Total_Cycles / SCH->task_profile[slot].Count);
     }
-
-    // Reset các biến đếm
-    task_count = 0;        // Chưa có task nào
-    elapsed_time = 0;      // Chưa đếm thời gian
-    Error_code_G = 0;      // Không có lỗi
+#endif
+    return (SCH->task_cost[slot] > 0) ? SCH->task_cost[slot] : SCH_STAGGER_DEFAULT_COST;
 }
 
 /**
  * ============================================================================
- * HÀM: SCH_Add_Task
+ * HÀM: SCH_Load_Build (PRIVATE)
  * ============================================================================
- * MÔ TẢ: Thêm task vào scheduler (mảng luôn được sắp xếp theo Delay)
- *
- * THAM SỐ:
- *   - pFunction: Con trỏ tới hàm cần gọi (kiểu void function(void))
- *   - DELAY: Số tick chờ trước khi chạy lần đầu
- *   - PERIOD: Số tick giữa các lần chạy (0 = chỉ chạy 1 lần)
+ * MÔ TẢ: Tính tải của SCH_STAGGER_WINDOW tick kế tiếp vào stagger_load[]
+ *        stagger_load[i] = tổng thời gian chạy các task đến hạn ở tick
+ *        (SCH->tick_now + 1 + i), dựa trên tick đến hạn và Period
  *
- * TRẢ VỀ: Index của task trong mảng (dùng để delete sau này)
+ * TRẢ VỀ: tải lớn nhất (tick nặng nhất)
  *
- * ĐỘ PHỨC TẠP: O(n) do phải tìm vị trí chèn và dịch mảng
- *
- * VÍ DỤ 1 - Task chạy ngay và lặp lại:
- *   SCH_Add_Task(LED_Toggle, 0, 100);
- *   → LED_Toggle chạy ngay, sau đó lặp mỗi 100 tick (1 giây nếu tick=10ms)
- *
- * VÍ DỤ 2 - Task chờ rồi lặp:
- *   SCH_Add_Task(Read_Sensor, 50, 200);
- *   → Chờ 50 tick (500ms), sau đó chạy và lặp mỗi 200 tick (2 giây)
- *
- * VÍ DỤ 3 - Task chạy 1 lần (one-shot):
- *   SCH_Add_Task(Send_Alert, 300, 0);
- *   → Chờ 300 tick (3 giây), chạy 1 lần rồi tự động xóa
- *
- * VÍ DỤ 4 - Lưu ID để xóa sau:
- *   uint32_t id = SCH_Add_Task(Buzzer, 0, 50);
- *   // Sau đó có thể xóa:
- *   SCH_Delete_Task(id);
+ * VÍ DỤ: Button (P=1, cost 2), FSM (P=1, cost 3), Display (P=5, cost 10)
+ *   stagger_load = [15, 5, 5, 5, 5, 15, 5, 5, 5, 5, ...] → peak = 15
  * ============================================================================
  */
-uint32_t SCH_Add_Task(void (*pFunction)(), uint32_t DELAY, uint32_t PERIOD) {
+static uint32_t SCH_Load_Build(SCH_Instance_t *SCH) {
+    uint32_t first = SCH->tick_now + 1u;
+    uint32_t peak = 0;
 
-    /* ========== CASE 1: TASK ĐẦU TIÊN (MẢNG RỖNG) ========== */
-    if (task_count == 0) {
-        // Thêm task vào vị trí đầu tiên
-        SCH_tasks_G[0].pTask = pFunction;
-        SCH_tasks_G[0].Delay = DELAY;
-        SCH_tasks_G[0].Period = PERIOD;
-        SCH_tasks_G[0].RunMe = 0;
-        SCH_tasks_G[0].TaskID = 0;
-        MARKING[0] = 1;                    // Đánh dấu là task đầu
-        elapsed_time = 0;
-        task_count++;
-        return 0;
+    for (uint32_t i = 0; i < SCH_STAGGER_WINDOW; i++) {
+        SCH->stagger_load[i] = 0;
     }
 
-    /* ========== CASE 2: MẢNG ĐÃ ĐẦY ========== */
-    if (task_count >= SCH_MAX_TASKS) {
-        // Không thể thêm task nữa
-        Error_code_G = ERROR_SCH_TOO_MANY_TASKS;
-        return SCH_MAX_TASKS;
-    }
-
-    /* ========== CASE 3: TÌM VỊ TRÍ CHÈN (INSERTION SORT) ========== */
-    /*
-     * VÍ DỤ: Mảng hiện tại [Delay: 10, 20, 50, 100]
-     *        Thêm task mới có Delay=30
-     *
-     * BƯỚC 1: Tìm vị trí chèn
-     *   - 30 >= 10 ✅ → insert_index = 1
-     *   - 30 >= 20 ✅ → insert_index = 2
-     *   - 30 >= 50 ❌ → DỪNG
-     *   → insert_index = 2 (chèn giữa 20 và 50)
-     *
-     * BƯỚC 2: Dịch mảng
-     *   [10, 20, 50, 100, ?]
-     *   [10, 20, _, 50, 100]  ← Dịch 50 và 100 sang phải
-     *
-     * BƯỚC 3: Chèn
-     *   [10, 20, 30, 50, 100]  ← Mảng vẫn được sắp xếp!
-     */
+    for (uint32_t slot = 0; slot < SCH->fresh_slot; slot++) {
+        if (SCH_TASK_FN(slot) == 0x0000) continue;
 
-    uint32_t insert_index = 0;
+        uint32_t cost = SCH_Task_Cost(SCH, (sch_index_t)slot);
+        uint32_t p = SCH_TASK_PERIOD(slot);
+        int32_t at = (int32_t)(SCH->task_due[slot] - first);
 
-    // Tìm vị trí để DELAY được sắp xếp tăng dần
-    for (uint32_t i = 0; i < task_count; i++) {
-        if (DELAY >= SCH_tasks_G[i].Delay) {
-            insert_index = i + 1;  // Chèn sau task này
-        } else {
-            break;  // Dừng khi gặp task có delay lớn hơn
+        // Đã đến hạn nhưng chưa chạy → lần chạy kế tiếp
+        if (at < 0) {
+            at = (p > 0) ? (int32_t)((p - (uint32_t)(-at) % p) % p) : 0;
+        }
+
+        for (uint32_t i = (uint32_t)at; i < SCH_STAGGER_WINDOW; i += p) {
+            SCH->stagger_load[i] += cost;
+            if (p == 0) break;                      // One-shot: 1 lần
         }
     }
 
-    // Dịch chuyển các task từ vị trí chèn sang phải 1 ô
-    for (int32_t j = task_count; j > insert_index; j--) {
-        SCH_tasks_G[j] = SCH_tasks_G[j - 1];
+    for (uint32_t i = 0; i < SCH_STAGGER_WINDOW; i++) {
+        if (SCH->stagger_load[i] > peak) peak = SCH->stagger_load[i];
     }
+    return peak;
+}
+
+/**
+ * ============================================================================
+ * HÀM: SCH_Add_Task_Staggered_In
+ * ============================================================================
+ * MÔ TẢ: Thêm task định kỳ, tự chọn DELAY để task rơi vào các tick nhẹ nhất
+ *   1. Tính tải của cửa sổ (SCH_Load_Build)
+ *   2. Với mỗi DELAY d = 1..PERIOD: task chạy ở các tick d-1, d-1+P, ...
+ *      → tick nặng nhất mà task rơi vào
+ *   3. Chọn d cho tick nặng nhất đó nhẹ nhất (bằng nhau → d nhỏ nhất)
+ *   Độ phức tạp: O(n * W / P + W), W = SCH_STAGGER_WINDOW
+ *
+ * VÍ DỤ: Button (P=1), FSM (P=1), Display (P=5, DELAY 0) đã có
+ *   SCH_Add_Task_Staggered(Task_Log, 5, 0);
+ *   → DELAY = 2: Task_Log chạy ở tick 2, 7, 12, ... còn Display ở tick
+ *     1, 6, 11, ... → tick nặng nhất: 3 task thay vì 4
+ * ============================================================================
+ */
+SCH_Handle_t SCH_Add_Task_Staggered_In(SCH_Instance_t *SCH, void (*pFunction)(void), uint32_t PERIOD, uint32_t COST) {
+    uint32_t best_delay = 1;
+    uint32_t best_load = 0xFFFFFFFFu;
+    uint32_t last = (PERIOD < SCH_STAGGER_WINDOW) ? PERIOD : SCH_STAGGER_WINDOW;
 
-    // Chèn task mới vào vị trí đã tìm được
-    SCH_tasks_G[insert_index].pTask = pFunction;
-    SCH_tasks_G[insert_index].Delay = DELAY;
-    SCH_tasks_G[insert_index].Period = PERIOD;
-    SCH_tasks_G[insert_index].RunMe = 0;
-    SCH_tasks_G[insert_index].TaskID = insert_index;
+    if (pFunction == 0x0000 || PERIOD == 0) {
+        return SCH_INVALID_HANDLE;
+    }
 
-    task_count++;
+    SCH_Load_Build(SCH);
 
-    // Cập nhật mảng MARKING (đánh dấu task nào có cùng delay với task[0])
-    SCH_Update_Marking();
+    for (uint32_t d = 1; d <= last; d++) {
+        uint32_t worst = 0;
+        for (uint32_t i = d - 1u; i < SCH_STAGGER_WINDOW; i += PERIOD) {
+            if (SCH->stagger_load[i] > worst) worst = SCH->stagger_load[i];
+        }
+        if (worst < best_load) {
+            best_load = worst;
+            best_delay = d;
+        }
+    }
 
-    return insert_index;
+#if SCH_ADMISSION
+    return SCH_Add_Task_Wcet_In(SCH, pFunction, best_delay, PERIOD, COST);
+#else
+    SCH_Handle_t handle = SCH_Add_Task_In(SCH, pFunction, best_delay, PERIOD);
+    if (handle != SCH_INVALID_HANDLE) {
+        SCH->task_cost[SCH_HANDLE_SLOT(handle)] = COST;
+    }
+    return handle;
+#endif
 }
 
 /**
  * ============================================================================
- * HÀM: SCH_Delete_Task
+ * HÀM: SCH_Get_Load_Profile_In
  * ============================================================================
- * MÔ TẢ: Xóa task khỏi scheduler
- *
- * THAM SỐ:
- *   - TASK_INDEX: Vị trí của task trong mảng (ID trả về từ Add_Task)
- *
- * TRẢ VỀ:
- *   - RETURN_NORMAL: Xóa thành công
- *   - RETURN_ERROR: Lỗi (index không hợp lệ)
+ * MÔ TẢ: Xuất tải của từng tick trong SCH_STAGGER_WINDOW tick kế tiếp
  *
- * ĐỘ PHỨC TẠP: O(n) do phải dịch mảng sang trái
- *
- * VÍ DỤ:
- *   uint32_t buzzer_id = SCH_Add_Task(Buzzer, 0, 100);
- *   // ... sau một thời gian
- *   SCH_Delete_Task(buzzer_id);  // Tắt buzzer
+ * VÍ DỤ - Tick nặng nhất so với 1 tick (10ms = 80000 chu kỳ ở 8MHz):
+ *   uint32_t load[10];
+ *   uint32_t peak = SCH_Get_Load_Profile(load, 10);
+ *   // peak * 100 / 80000 = % của tick nặng nhất bị task chiếm
  * ============================================================================
  */
-uint8_t SCH_Delete_Task(const uint32_t TASK_INDEX) {
+uint32_t SCH_Get_Load_Profile_In(SCH_Instance_t *SCH, uint32_t *LOAD, uint32_t LEN) {
+    uint32_t peak = SCH_Load_Build(SCH);
 
-    // Kiểm tra index có hợp lệ không
-    if (TASK_INDEX >= task_count || task_count == 0) {
-        Error_code_G = ERROR_SCH_CANNOT_DELETE_TASK;
-        return RETURN_ERROR;
+    if (LOAD != 0x0000) {
+        for (uint32_t i = 0; i < LEN && i < SCH_STAGGER_WINDOW; i++) {
+            LOAD[i] = SCH->stagger_load[i];
+        }
     }
+    return peak;
+}
 
-    /* ========== CASE 1: CHỈ CÒN 1 TASK ========== */
-    if (task_count == 1) {
-        // Xóa sạch task duy nhất
-        SCH_tasks_G[0].pTask = 0x0000;
-        SCH_tasks_G[0].Delay = 0;
-        SCH_tasks_G[0].Period = 0;
-        SCH_tasks_G[0].RunMe = 0;
-        SCH_tasks_G[0].TaskID = 0;
-        MARKING[0] = 0;
-        task_count = 0;
-    }
-    /* ========== CASE 2: NHIỀU TASK → DỊCH TRÁI ========== */
-    else {
-        /*
-         * VÍ DỤ: Xóa task ở vị trí 2
-         * Trước: [A, B, C, D, E]
-         *              ↑ Xóa C
-         * Sau:  [A, B, D, E, _]
-         *              ↑ D dịch sang trái
-         */
-
-        // Dịch tất cả các task sau task bị xóa sang trái 1 vị trí
-        for (uint32_t k = TASK_INDEX; k < task_count - 1; k++) {
-            SCH_tasks_G[k] = SCH_tasks_G[k + 1];
-        }
+#endif /* SCH_STAGGER */
 
-        // Xóa sạch vị trí cuối cùng (đã không dùng nữa)
-        uint32_t last_pos = task_count - 1;
-        SCH_tasks_G[last_pos].pTask = 0x0000;
-        SCH_tasks_G[last_pos].Delay = 0;
-        SCH_tasks_G[last_pos].Period = 0;
-        SCH_tasks_G[last_pos].RunMe = 0;
-        SCH_tasks_G[last_pos].TaskID = 0;
-        MARKING[last_pos] = 0;
+#if SCH_STAGGER || SCH_ADMISSION
 
-        task_count--;
+/**
+ * ============================================================================
+ * HÀM: SCH_Set_Task_Cost_In
+ * ============================================================================
+ * MÔ TẢ: Khai báo thời gian chạy của task (cùng đơn vị với profiler)
+ *        VD: task thêm bằng SCH_Add_Task / bảng SCH_TASK_TABLE
+ *        SCH_STAGGER: chi phí khi chưa đo; SCH_ADMISSION: WCET tối thiểu
+ * ============================================================================
+ */
+uint8_t SCH_Set_Task_Cost_In(SCH_Instance_t *SCH, const SCH_Handle_t TASK_HANDLE, uint32_t COST) {
+    sch_index_t slot = SCH_Handle_To_Slot(SCH, TASK_HANDLE);
 
-        // Cập nhật lại mảng MARKING
-        if (task_count > 0) {
-            SCH_Update_Marking();
-        }
+    if (slot == SCH_NO_SLOT) {
+        return RETURN_ERROR;
     }
-
+    SCH->task_cost[slot] = COST;
     return RETURN_NORMAL;
 }
 
+#endif /* SCH_STAGGER || SCH_ADMISSION */
+
+#if SCH_ADMISSION
+
+/* ==================== KIỂM SOÁT NHẬN TASK (SCH_ADMISSION) ==================== */
+
+// WCET của task chưa khai báo, chưa đo (đơn vị profiler)
+#define ADMIT_DEFAULT_WCET  ((SCH_CYCLES_PER_SECOND / 1000000u) * SCH_ADMIT_DEFAULT_WCET_US)
+
+// 1 task định kỳ như SCH_Admit_Eval thấy
+typedef struct {
+    uint32_t Period;
+    uint32_t Phase;             // Tick chạy (tính từ tick kế tiếp) mod Period
+    uint32_t Wcet;
+    uint8_t Any_Tick;           // Task sự kiện: có thể chạy ở mọi tick
+} admit_task_t;
+
+// Task định kỳ của bước 2 (siêu chu kỳ ≤ SCH_ADMIT_MAX_HYPER → vừa 16 bit)
+#if SCH_ADMIT_MAX_HYPER > 65535
+#error "SCH_ADMIT_MAX_HYPER must not exceed 65535"
+#endif
+typedef struct {
+    uint16_t Period;
+    uint16_t Phase;
+    uint32_t Wcet;
+} admit_tick_t;
+
 /**
  * ============================================================================
- * HÀM: SCH_Update_Marking (PRIVATE)
+ * HÀM: SCH_Task_Wcet (PRIVATE)
  * ============================================================================
- * MÔ TẢ: Cập nhật mảng MARKING - đánh dấu task nào có cùng delay với task[0]
+ * MÔ TẢ: WCET dùng để kiểm tra nhận task = chi phí khai báo,
+ *        không có → mặc định
+ *        SCH_ADMIT_PROFILED = 1: lấy max với Max_Cycles đo được
  *
- * TẠI SAO CẦN MARKING?
- *   - Để biết những task nào sẽ "sẵn sàng chạy cùng lúc"
- *   - Giúp cập nhật hàng loạt trong Dispatch
- *
- * VÍ DỤ:
- *   Task[0]: Delay=10  → MARKING[0]=1 ✅
- *   Task[1]: Delay=10  → MARKING[1]=1 ✅ (cùng delay với task[0])
- *   Task[2]: Delay=20  → MARKING[2]=0 ❌
- *   Task[3]: Delay=30  → MARKING[3]=0 ❌
- *
- *   Kết quả: MARKING = [1, 1, 0, 0]
- *   → 2 task đầu sẽ sẵn sàng cùng lúc!
+ * LƯU Ý: Max_Cycles là thời gian thực (DWT) → gồm cả ngắt chen vào
+ *        task; 1 đợt ngắt dài làm WCET tăng mãi mãi, Add / Reschedule
+ *        sau đó có thể bị từ chối → mặc định không dùng
  * ============================================================================
  */
-static void SCH_Update_Marking(void) {
-    if (task_count == 0) return;
+static uint32_t SCH_Task_Wcet(SCH_Instance_t *SCH, sch_index_t slot) {
+    uint32_t wcet = SCH->task_cost[slot];
 
-    // Lấy delay của task đầu tiên làm chuẩn
-    uint32_t first_delay = SCH_tasks_G[0].Delay;
-
-    // Duyệt tất cả task và đánh dấu
-    for (uint32_t n = 0; n < task_count; n++) {
-        if (SCH_tasks_G[n].Delay == first_delay) {
-            MARKING[n] = 1;  // ✅ Đánh dấu: cùng delay với task đầu
-        } else {
-            MARKING[n] = 0;  // ❌ Không đánh dấu: delay khác
-        }
+#if SCH_PROFILE && SCH_ADMIT_PROFILED
+    if (SCH->task_profile[slot].Count > 0 && SCH->task_profile[slot].Max_Cycles > wcet) {
+        wcet = SCH->task_profile[slot].Max_Cycles;
     }
+#endif
+    return (wcet > 0) ? wcet : ADMIT_DEFAULT_WCET;
 }
 
 /**
  * ============================================================================
- * HÀM: SCH_Update
+ * HÀM: SCH_Admit_Get (PRIVATE)
  * ============================================================================
- * MÔ TẢ: Hàm cập nhật - GỌI TRONG INTERRUPT TIMER
- *
- * ĐỘ PHỨC TẠP: O(1) ⚡ - KEY OPTIMIZATION!
- *
- * CÁCH HOẠT ĐỘNG:
- *   1. CHỈ giảm delay của task đầu tiên (task sớm nhất)
- *   2. Tăng bộ đếm thời gian đã trôi qua
- *   3. Nếu task đầu đã đến giờ → đặt cờ RunMe
- *
- * TẠI SAO CHỈ CẬP NHẬT TASK ĐẦU?
- *   - Mảng đã được sắp xếp theo delay
- *   - Task[0] LUÔN là task sớm nhất
- *   - Các task khác sẽ được cập nhật trong Dispatch
- *   → Tiết kiệm thời gian trong interrupt!
- *
- * GỌI TỪ ĐÂU:
- *   void HAL_TIM_PeriodElapsedCallback(TIM_HandleTypeDef *htim) {
- *       if (htim->Instance == TIM2) {
- *           SCH_Update();  // ← Gọi ở đây
- *       }
- *   }
- *
- * VÍ DỤ TIMELINE (Tick = 10ms):
- *   Ban đầu:
- *     Task[0]: Delay=3
- *     Task[1]: Delay=5
- *     elapsed_time = 0
- *
- *   Tick 1 (10ms):
- *     Task[0]: Delay=2  ← Giảm
- *     elapsed_time = 1
+ * MÔ TẢ: Mục k của tập task: k < fresh_slot → slot k (bỏ slot trống,
+ *        one-shot: chạy 1 lần rồi hết, không làm tải lâu dài, và slot
+ *        REPLACE: task đang Reschedule, NEW là mục mới của nó),
+ *        k == fresh_slot → task đang xin vào (NEW, có thể là 0)
+ *        Pha tính như SCH_Load_Build: đã đến hạn mà chưa chạy → lần
+ *        chạy kế tiếp trên lưới của nó
  *
- *   Tick 2 (20ms):
- *     Task[0]: Delay=1
- *     elapsed_time = 2
- *
- *   Tick 3 (30ms):
- *     Task[0]: Delay=0, RunMe=1  ← ĐẾN GIỜ! Đặt cờ
- *     elapsed_time = 3
+ * TRẢ VỀ: 1 nếu có task ở mục k
  * ============================================================================
  */
-void SCH_Update(void) {
-    if (task_count > 0) {
-        // CHỈ giảm delay của task đầu tiên
-        if (SCH_tasks_G[0].Delay > 0) {
-            SCH_tasks_G[0].Delay--;
-        }
+static uint8_t SCH_Admit_Get(SCH_Instance_t *SCH, uint32_t k, const admit_task_t *NEW, uint32_t REPLACE, admit_task_t *task) {
+    if (k == SCH->fresh_slot) {
+        if (NEW == 0x0000) return 0;
+        *task = *NEW;
+        return 1;
+    }
+    uint32_t p = SCH_TASK_PERIOD(k);
+    if (SCH_TASK_FN(k) == 0x0000 || p == 0 || k == REPLACE) return 0;
 
-        // Đếm thời gian đã trôi qua (dùng trong Dispatch)
-        elapsed_time++;
+    int32_t at = (int32_t)(SCH->task_due[k] - (SCH->tick_now + 1u));
+    if (at < 0) {
+        at = (int32_t)((p - (uint32_t)(-at) % p) % p);
+    }
+    task->Period = p;
+    task->Phase = (uint32_t)at % p;
+    task->Wcet = SCH_Task_Wcet(SCH, (sch_index_t)k);
+    task->Any_Tick = (SCH->task_event[k] != TASK_POLLED);
+    return 1;
+}
 
-        // Nếu task đầu tiên đã đến giờ → đặt cờ RunMe
-        if (SCH_tasks_G[0].Delay == 0) {
-            SCH_tasks_G[0].RunMe++;
-        }
+static uint32_t admit_gcd(uint32_t a, uint32_t b) {
+    while (b != 0) {
+        uint32_t t = a % b;
+        a = b;
+        b = t;
     }
+    return a;
 }
 
 /**
  * ============================================================================
- * HÀM: SCH_Dispatch_Tasks
+ * HÀM: SCH_Admit_Eval (PRIVATE)
  * ============================================================================
- * MÔ TẢ: Thực thi các task đã sẵn sàng - GỌI TRONG MAIN LOOP
- *
- * ĐỘ PHỨC TẠP: O(n²) trong trường hợp xấu nhất
- *
- * CÁCH HOẠT ĐỘNG (2 BƯỚC):
- *
- *   BƯỚC 1: CẬP NHẬT DELAY CHO TẤT CẢ TASK
- *     - Những task có MARKING=1: Đặt Delay=0, RunMe=1
- *     - Những task có MARKING=0: Trừ đi thời gian đã trôi qua
- *
- *   BƯỚC 2: THỰC THI CÁC TASK SẴN SÀNG
- *     - Gọi hàm task
- *     - Nếu là one-shot (Period=0): Xóa task
- *     - Nếu là periodic: Xóa rồi thêm lại với delay mới
- *
- * GỌI TỪ ĐÂU:
- *   int main(void) {
- *       SCH_Init();
- *       SCH_Add_Task(...);
- *
- *       while(1) {
- *           SCH_Dispatch_Tasks();  // ← Gọi ở đây
- *       }
- *   }
- *
- * VÍ DỤ CHI TIẾT:
- *   Ban đầu (sau khi Update đặt cờ):
- *     Task[0]: {LED_Toggle, Delay=0, Period=100, RunMe=1} MARKING=1
- *     Task[1]: {Buzzer, Delay=0, Period=50, RunMe=0}      MARKING=1
- *     Task[2]: {Sensor, Delay=50, Period=200, RunMe=0}    MARKING=0
- *     elapsed_time = 100  ← Đã trôi qua 100 tick
- *
- *   BƯỚC 1: Sau khi Dispatch_Tasks - Cập nhật delay cho từng task
- *     Task[0]: Delay=0, RunMe=1      (MARKING=1 → giữ nguyên)
- *     Task[1]: Delay=0, RunMe=1      (MARKING=1 → đặt cờ!)
- *     Task[2]: Delay=50-100=-50 → 0  (MARKING=0 → trừ đi 100)
+ * MÔ TẢ: Kiểm tra tập task hiện tại (+ NEW nếu có)
+ *   1. Hệ số sử dụng U = Σ WCET / (Period x chu kỳ/tick)
+ *      (task sự kiện không có tần số → chỉ tính ở bước 2)
+ *   2. Siêu chu kỳ H = BCNN các Period; với từng tick 0..H-1: tổng WCET
+ *      các task chạy ở tick đó + WCET mọi task sự kiện
+ *      H > SCH_ADMIT_MAX_HYPER → không duyệt, coi mọi task cùng 1 tick
+ *   Độ phức tạp: O(H x n), tập task gom 1 lần vào mảng trên stack
+ *   (8 byte / task) → bước 2 không đọc lại bảng slot
  *
- *   BƯỚC 2: Thực thi
- *     - Chạy LED_Toggle() → Xóa → Thêm lại với Delay=100
- *     - Chạy Buzzer() → Xóa → Thêm lại với Delay=50
- *     - Chạy Sensor() (nếu RunMe=1)
+ * VÍ DỤ (8MHz, 80000 chu kỳ/tick, ngân sách 80% = 64000):
+ *   FSM (P=1, 4000), Display (P=5, 20000), thêm Log (P=5, DELAY 0, 45000)
+ *   → U = 5% + 5% + 11.25% = 21.25% ≤ 70% ✅
+ *   → tick 0: 4000 + 20000 + 45000 = 69000 > 64000 ❌ (từ chối)
+ *   Cùng Log với DELAY 2 → tick nặng nhất 49000 ✅
  *
- *   Kết quả:
- *     Task[0]: {Buzzer, Delay=50, Period=50}
- *     Task[1]: {LED_Toggle, Delay=100, Period=100}
- *     Task[2]: {Sensor, Delay=200, Period=200}
- *     elapsed_time = 0  ← Reset
+ * TRẢ VỀ: 1 nếu cả 2 giới hạn đều thỏa
  * ============================================================================
  */
-void SCH_Dispatch_Tasks(void) {
+static uint8_t SCH_Admit_Eval(SCH_Instance_t *SCH, const admit_task_t *NEW, uint32_t REPLACE, SCH_Admission_t *ADMISSION) {
+    admit_task_t task;
+    admit_tick_t polled[SCH_MAX_TASKS + 1u];    // Task định kỳ, gom 1 lần ở bước 1
+    uint32_t n = 0;
+    uint64_t util = 0;          // Σ WCET x 10000 / Period
+    uint32_t every_tick = 0;    // Σ WCET của task sự kiện
+    uint32_t all = 0;           // Σ WCET của mọi task được tính
+    uint32_t hyper = 1;
+    uint32_t worst = 0;
+    uint32_t budget = (uint32_t)((uint64_t)SCH_CYCLES_PER_TICK * SCH_ADMIT_TICK_PCT / 100u);
 
-    // Kiểm tra có task nào sẵn sàng không
-    if (task_count > 0 && SCH_tasks_G[0].RunMe > 0) {
+    // Bước 1: hệ số sử dụng và siêu chu kỳ
+    for (uint32_t k = 0; k <= SCH->fresh_slot; k++) {
+        if (!SCH_Admit_Get(SCH, k, NEW, REPLACE, &task)) continue;
 
-        /* ========== BƯỚC 1: CẬP NHẬT DELAY CHO TẤT CẢ TASK ========== */
-        for (uint32_t m = 0; m < task_count; m++) {
-            if (MARKING[m] == 0) {
-                // Task có delay KHÁC với task đầu
-                // → Trừ đi thời gian đã trôi qua
-                if (SCH_tasks_G[m].Delay >= elapsed_time) {
-                    SCH_tasks_G[m].Delay -= elapsed_time;
-                } else {
-                    SCH_tasks_G[m].Delay = 0;
-                }
-            } else {
-                // Task có CÙNG delay với task đầu
-                // → Cũng sẵn sàng chạy!
-                SCH_tasks_G[m].Delay = 0;
-                SCH_tasks_G[m].RunMe = 1;
+        all += task.Wcet;
+        if (task.Any_Tick) {
+            every_tick += task.Wcet;
+        } else {
+            util += (uint64_t)task.Wcet * 10000u / task.Period;
+            if (hyper <= SCH_ADMIT_MAX_HYPER) {
+                uint64_t lcm = (uint64_t)(hyper / admit_gcd(hyper, task.Period)) * task.Period;
+                hyper = (lcm > SCH_ADMIT_MAX_HYPER) ? SCH_ADMIT_MAX_HYPER + 1u : (uint32_t)lcm;
+            }
+            if (hyper <= SCH_ADMIT_MAX_HYPER) {
+                polled[n].Period = (uint16_t)task.Period;
+                polled[n].Phase = (uint16_t)task.Phase;
+                polled[n].Wcet = task.Wcet;
+                n++;
             }
         }
+    }
+    util /= SCH_CYCLES_PER_TICK;
 
-        /* ========== BƯỚC 2: VÒNG LẶP THỰC THI CÁC TASK SẴN SÀNG ========== */
-        while (task_count > 0 && SCH_tasks_G[0].RunMe > 0) {
+    // Bước 2: tick nặng nhất của siêu chu kỳ
+    if (hyper > SCH_ADMIT_MAX_HYPER) {
+        worst = all;
+        hyper = 0;
+    } else {
+        for (uint32_t i = 0; i < hyper; i++) {
+            uint32_t load = every_tick;
 
-            // 1. CHẠY TASK
-            if (SCH_tasks_G[0].pTask != 0x0000) {
-                (*SCH_tasks_G[0].pTask)();  // Gọi hàm task!
+            for (uint32_t j = 0; j < n; j++) {
+                if (i % polled[j].Period == polled[j].Phase) {
+                    load += polled[j].Wcet;
+                }
             }
+            if (load > worst) worst = load;
+        }
+    }
 
-            // 2. HẠ CỜ
-            SCH_tasks_G[0].RunMe--;
-
-            // 3. XỬ LÝ TASK DỰA VÀO PERIOD
-            if (SCH_tasks_G[0].Period == 0) {
-                /* ONE-SHOT TASK: Chỉ chạy 1 lần → XÓA */
-                SCH_Delete_Task(0);
-            } else {
-                /* PERIODIC TASK: Lặp lại → XÓA rồi THÊM LẠI */
+    if (ADMISSION != 0x0000) {
+        ADMISSION->Utilization = (uint32_t)util;
+        ADMISSION->Worst_Tick = worst;
+        ADMISSION->Tick_Budget = budget;
+        ADMISSION->Hyperperiod = hyper;
+    }
+    return (util <= SCH_ADMIT_UTIL_PCT * 100u) && (worst <= budget);
+}
 
-                // Lưu thông tin task
-                void (*temp_func)(void) = SCH_tasks_G[0].pTask;
-                uint32_t temp_period = SCH_tasks_G[0].Period;
+/**
+ * ============================================================================
+ * HÀM: SCH_Admit (INTERNAL)
+ * ============================================================================
+ * MÔ TẢ: Gọi bởi SCH_Add_Task của mọi backend trước khi lấy slot
+ *        Task mới chạy lần đầu ở tick (bây giờ + DELAY), DELAY 0 = 1
+ *        WCET: khai báo qua SCH_Add_Task_Wcet, không có → mặc định
+ *        One-shot (PERIOD = 0) luôn được nhận: việc 1 lần (VD từ
+ *        SCH_Add_Task_From_ISR) không bao giờ bị bỏ
+ *
+ * VÍ DỤ - cấu hình thêm task giám sát vượt tải 1 tick:
+ *   id = SCH_Add_Task(Task_Detector, 0, 1);
+ *   → id = SCH_INVALID_HANDLE, Error_code_G = ERROR_SCH_NOT_SCHEDULABLE
+ *     (SCH_Report_Status báo ngay lúc khởi động)
+ * ============================================================================
+ */
+uint8_t SCH_Admit(SCH_Instance_t *SCH, uint32_t DELAY, uint32_t PERIOD) {
+    admit_task_t task;
+    uint32_t at = ((DELAY > 0) ? DELAY : 1u) - 1u;
 
-                // Xóa task cũ
-                SCH_Delete_Task(0);
+    if (SCH->admit_table || PERIOD == 0) {
+        return 1;               // Dòng của SCH_Init_Static: kiểm tra cả bảng sau
+    }
 
-                // Thêm lại task với delay = period
-                // VÍ DỤ: Period=100 → Task sẽ chạy lại sau 100 tick
-                SCH_Add_Task(temp_func, temp_period, temp_period);
-            }
-        }
+    task.Period = PERIOD;
+    task.Phase = at % PERIOD;
+    task.Wcet = (SCH->admit_wcet > 0) ? SCH->admit_wcet : ADMIT_DEFAULT_WCET;
+    task.Any_Tick = SCH->admit_any_tick;
 
-        // Reset bộ đếm thời gian
-        elapsed_time = 0;
+    if (!SCH_Admit_Eval(SCH, &task, SCH_NO_SLOT, 0x0000)) {
+        SCH->error_code = ERROR_SCH_NOT_SCHEDULABLE;
+        return 0;
     }
-
-    // (Optional) Báo cáo lỗi và vào chế độ ngủ
-    // SCH_Report_Status();
-    // SCH_Go_To_Sleep();
+    return 1;
 }
 
 /**
  * ============================================================================
- * HÀM: SCH_Report_Status
+ * HÀM: SCH_Admit_Reschedule (INTERNAL)
  * ============================================================================
- * MÔ TẢ: Báo cáo trạng thái hệ thống (tùy chọn)
+ * MÔ TẢ: Gọi bởi SCH_Reschedule_Task của mọi backend trước khi đổi task
+ *        Kiểm tra tập task với mục của SLOT thay bằng (DELAY, PERIOD),
+ *        WCET giữ như cũ (SCH_Task_Wcet)
+ *        Bỏ qua khi:
+ *        - PERIOD = 0: one-shot không làm tải lâu dài (như SCH_Admit)
+ *        - Task sự kiện: luôn được tính ở mọi tick, DELAY / PERIOD không
+ *          đổi tải (VD SCH_Signal gọi Reschedule mỗi lần đánh thức)
  *
- * CÁCH SỬ DỤNG:
- *   - Hiển thị mã lỗi trên LED
- *   - Gửi qua UART để debug
- *   - Lưu vào log
+ * VÍ DỤ - one-shot được nhận rồi đổi thành định kỳ:
+ *   id = SCH_Add_Task_Wcet(Task_Log, 0, 0, 45000);   // Luôn nhận
+ *   SCH_Reschedule_Task(id, 0, 1);
+ *   → RETURN_ERROR, Error_code_G = ERROR_SCH_NOT_SCHEDULABLE,
+ *     task vẫn là one-shot như trước
  * ============================================================================
  */
-void SCH_Report_Status(void) {
-    // TODO: Implement error reporting
-    // VÍ DỤ: Hiển thị Error_code_G trên 8 LED
-    if (Error_code_G != 0) {
-        // Xử lý lỗi
-        // HAL_GPIO_WritePort(ERROR_PORT, Error_code_G);
+uint8_t SCH_Admit_Reschedule(SCH_Instance_t *SCH, uint32_t SLOT, uint32_t DELAY, uint32_t PERIOD) {
+    admit_task_t task;
+    uint32_t at = ((DELAY > 0) ? DELAY : 1u) - 1u;
+
+    if (PERIOD == 0 || SCH->task_event[SLOT] != TASK_POLLED) {
+        return 1;
+    }
+
+    task.Period = PERIOD;
+    task.Phase = at % PERIOD;
+    task.Wcet = SCH_Task_Wcet(SCH, (sch_index_t)SLOT);
+    task.Any_Tick = 0;
+
+    if (!SCH_Admit_Eval(SCH, &task, SLOT, 0x0000)) {
+        SCH->error_code = ERROR_SCH_NOT_SCHEDULABLE;
+        return 0;
+    }
+    return 1;
+}
+
+void SCH_Admit_Table_Begin(SCH_Instance_t *SCH) {
+    SCH->admit_table = 1;
+}
+
+void SCH_Admit_Table_End(SCH_Instance_t *SCH) {
+    SCH->admit_table = 0;
+    if (!SCH_Admit_Eval(SCH, 0x0000, SCH_NO_SLOT, 0x0000)) {
+        SCH->error_code = ERROR_SCH_NOT_SCHEDULABLE; // Bảng giữ nguyên, chỉ báo lỗi
     }
 }
 
 /**
  * ============================================================================
- * HÀM: SCH_Go_To_Sleep
+ * HÀM: SCH_Add_Task_Wcet_In
  * ============================================================================
- * MÔ TẢ: Đưa MCU vào chế độ tiết kiệm năng lượng (tùy chọn)
- *
- * CÁCH HOẠT ĐỘNG:
- *   - MCU vào chế độ SLEEP
- *   - Timer interrupt vẫn chạy → đánh thức MCU
- *   - Tiết kiệm ~50% năng lượng
+ * MÔ TẢ: SCH_Add_Task với WCET khai báo cho bước kiểm tra nhận task
+ *        WCET được giữ làm chi phí của task (như SCH_Set_Task_Cost)
  *
- * VÍ DỤ:
- *   HAL_PWR_EnterSLEEPMode(PWR_MAINREGULATOR_ON, PWR_SLEEPENTRY_WFI);
+ * VÍ DỤ - task gửi dữ liệu mỗi 1 giây, chạy tối đa 1.5ms (8MHz):
+ *   SCH_Add_Task_Wcet(Task_Telemetry, 0, 100, 12000);
  * ============================================================================
  */
-void SCH_Go_To_Sleep(void) {
-    // TODO: Implement sleep mode
-    // HAL_PWR_EnterSLEEPMode(PWR_MAINREGULATOR_ON, PWR_SLEEPENTRY_WFI);
+SCH_Handle_t SCH_Add_Task_Wcet_In(SCH_Instance_t *SCH, void (*pFunction)(void), uint32_t DELAY, uint32_t PERIOD, uint32_t WCET) {
+    SCH->admit_wcet = WCET;
+    SCH_Handle_t handle = SCH_Add_Task_In(SCH, pFunction, DELAY, PERIOD);
+    SCH->admit_wcet = 0;
+
+    if (handle != SCH_INVALID_HANDLE) {
+        SCH->task_cost[SCH_HANDLE_SLOT(handle)] = WCET;
+    }
+    return handle;
 }
 
 /**
  * ============================================================================
- * HÀM: SCH_Get_Current_Size
+ * HÀM: SCH_Get_Admission_In
  * ============================================================================
- * MÔ TẢ: Lấy số lượng task hiện tại
+ * MÔ TẢ: Chạy bước kiểm tra trên tập task hiện tại (WCET khai báo,
+ *        SCH_ADMIT_PROFILED = 1: cả Max_Cycles đo được mới nhất), VD sau
+ *        vài giây chạy để biết còn chỗ cho task mới không
  *
  * VÍ DỤ:
- *   uint32_t num_tasks = SCH_Get_Current_Size();
- *   printf("Có %d tasks đang chạy\n", num_tasks);
+ *   SCH_Admission_t a;
+ *   SCH_Get_Admission(&a);
+ *   // a.Tick_Budget - a.Worst_Tick = thời gian còn trống ở tick nặng nhất
  * ============================================================================
  */
-uint32_t SCH_Get_Current_Size(void) {
-    return task_count;
+uint8_t SCH_Get_Admission_In(SCH_Instance_t *SCH, SCH_Admission_t *ADMISSION) {
+    return SCH_Admit_Eval(SCH, 0x0000, SCH_NO_SLOT, ADMISSION) ? RETURN_NORMAL : RETURN_ERROR;
 }
+
+#endif /* SCH_ADMISSION */
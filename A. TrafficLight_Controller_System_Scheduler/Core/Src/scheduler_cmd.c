@@ -0,0 +1,226 @@
+/*
+ * ============================================================================
+ * COOPERATIVE SCHEDULER - HÀNG ĐỢI LỆNH TỪ NGẮT (ISR COMMAND RING)
+ * ============================================================================
+ * Mô tả: Cho phép ngắt (EXTI, UART, DMA, ...) thêm / xóa task an toàn
+ *
+ * VẤN ĐỀ:
+ * - SCH_Add_Task / SCH_Delete_Task sửa hàng đợi, MARKING, task_count
+ *   mà không có bảo vệ → gọi trong ngắt có thể phá hỏng hàng đợi
+ *   khi Dispatch (hoặc SCH_Update) đang làm việc trên đó
+ *
+ * GIẢI PHÁP: Ring buffer 1 người ghi / 1 người đọc (SPSC)
+ * - Ngắt (producer) chỉ ghi lệnh vào ô trống rồi tăng cmd_head
+ * - Dispatch (consumer) đọc lệnh, tăng cmd_tail, rồi mới thực hiện
+ * - Mỗi chỉ số chỉ do 1 bên ghi → không cần tắt ngắt, không cần khóa
+ *   → thời gian trong ngắt cố định (wait-free), vài chục chu kỳ
+ *
+ * TÍN HIỆU (SCH_Signal_From_ISR):
+ * - Mỗi slot có cờ "đã gửi": ngắt gửi lại nhiều lần trước khi Dispatch
+ *   xử lý → chỉ chiếm 1 ô trong ring (tín hiệu được gộp như SCH_Signal)
+ *
+ * GIỚI HẠN:
+ * - "1 producer": mọi ngắt gọi *_From_ISR phải cùng mức ưu tiên
+ *   (không ngắt lồng nhau khi đang ghi vào ring)
+ * - Ring đầy → lệnh bị bỏ, Error_code_G = ERROR_SCH_CMD_RING_FULL
+ * ============================================================================
+ */
+
+#include "scheduler.h"
+#include "scheduler_internal.h"
+
+/* ==================== CẤU HÌNH NỘI BỘ ==================== */
+
+#define CMD_RING_MASK       (SCH_CMD_RING_SIZE - 1u)
+
+#if (SCH_CMD_RING_SIZE & CMD_RING_MASK) != 0
+#error "SCH_CMD_RING_SIZE must be a power of 2"
+#endif
+
+// Loại lệnh
+#define CMD_ADD             0
+#define CMD_DELETE          1
+#define CMD_SIGNAL          2
+
+/* ==================== BIẾN NỘI BỘ ==================== */
+
+// Nằm trong SCH_Instance_t (mỗi instance 1 ring, 1 lệnh = sch_cmd_t):
+// - SCH->cmd_ring[SCH_CMD_RING_SIZE]
+// - SCH->cmd_head / cmd_tail: chỉ số chạy tự do (không quấn), số lệnh đang
+//   chờ = cmd_head - cmd_tail; cmd_head chỉ ngắt ghi, cmd_tail chỉ Dispatch ghi
+// - SCH->signal_posted[slot]: slot đã có lệnh CMD_SIGNAL nằm trong ring
+//   (ngắt đặt, Dispatch xóa)
+
+/* ==================== HÀM PRIVATE (INTERNAL) ==================== */
+
+/**
+ * ============================================================================
+ * HÀM: SCH_Post_Command (PRIVATE)
+ * ============================================================================
+ * MÔ TẢ: Ghi 1 lệnh vào ring (phía ngắt)
+ *   1. Ring đầy → báo lỗi, bỏ lệnh
+ *   2. Ghi nội dung lệnh vào ô cmd_head
+ *   3. Barrier → nội dung lệnh được ghi xong TRƯỚC khi cmd_head tăng
+ *   4. Tăng cmd_head → Dispatch mới thấy lệnh
+ * ============================================================================
+ */
+static uint8_t SCH_Post_Command(SCH_Instance_t *SCH, const sch_cmd_t *cmd) {
+    uint32_t head = SCH->cmd_head;
+
+    if (head - SCH->cmd_tail >= SCH_CMD_RING_SIZE) {
+        SCH->error_code = ERROR_SCH_CMD_RING_FULL;
+        return RETURN_ERROR;
+    }
+
+    SCH->cmd_ring[head & CMD_RING_MASK] = *cmd;
+    SCH_MEMORY_BARRIER();
+    SCH->cmd_head = head + 1u;
+
+    return RETURN_NORMAL;
+}
+
+/* ==================== IMPLEMENTATION ==================== */
+
+/**
+ * ============================================================================
+ * HÀM: SCH_Add_Task_From_ISR_In
+ * ============================================================================
+ * MÔ TẢ: Thêm task từ trong ngắt - task được thêm thật sự ở lần
+ *        SCH_Dispatch_Tasks() kế tiếp
+ *
+ * VÍ DỤ - Nút nhấn dùng EXTI, xử lý chống dội trong task sau 20ms:
+ *   void HAL_GPIO_EXTI_Callback(uint16_t GPIO_Pin) {
+ *       SCH_Add_Task_From_ISR(Debounce_Task, 2, 0, 0);
+ *   }
+ *
+ * VÍ DỤ - Lưu handle để hủy sau này:
+ *   static SCH_Handle_t timeout_id;
+ *   SCH_Add_Task_From_ISR(Uart_Timeout, 50, 0, &timeout_id);
+ *   // timeout_id = SCH_INVALID_HANDLE cho tới khi Dispatch xử lý lệnh
+ * ============================================================================
+ */
+uint8_t SCH_Add_Task_From_ISR_In(SCH_Instance_t *SCH, void (*pFunction)(void), uint32_t DELAY, uint32_t PERIOD,
+                              SCH_Handle_t *HANDLE_OUT) {
+    sch_cmd_t cmd;
+
+    if (pFunction == 0x0000) {
+        return RETURN_ERROR;
+    }
+    if (HANDLE_OUT != 0x0000) {
+        *HANDLE_OUT = SCH_INVALID_HANDLE;
+    }
+
+    cmd.Kind = CMD_ADD;
+    cmd.pTask = pFunction;
+    cmd.Delay = DELAY;
+    cmd.Period = PERIOD;
+    cmd.Handle = SCH_INVALID_HANDLE;
+    cmd.Result = HANDLE_OUT;
+
+    return SCH_Post_Command(SCH, &cmd);
+}
+
+/**
+ * ============================================================================
+ * HÀM: SCH_Delete_Task_From_ISR_In
+ * ============================================================================
+ * MÔ TẢ: Xóa task từ trong ngắt - task bị xóa ở lần Dispatch kế tiếp
+ *        (handle sai / đã bị xóa → Error_code_G như SCH_Delete_Task)
+ *
+ * VÍ DỤ - Nhận đủ dữ liệu UART → hủy timeout:
+ *   void HAL_UART_RxCpltCallback(UART_HandleTypeDef *huart) {
+ *       SCH_Delete_Task_From_ISR(timeout_id);
+ *   }
+ * ============================================================================
+ */
+uint8_t SCH_Delete_Task_From_ISR_In(SCH_Instance_t *SCH, const SCH_Handle_t TASK_HANDLE) {
+    sch_cmd_t cmd;
+
+    cmd.Kind = CMD_DELETE;
+    cmd.pTask = 0x0000;
+    cmd.Delay = 0;
+    cmd.Period = 0;
+    cmd.Handle = TASK_HANDLE;
+    cmd.Result = 0x0000;
+
+    return SCH_Post_Command(SCH, &cmd);
+}
+
+/**
+ * ============================================================================
+ * HÀM: SCH_Signal_From_ISR_In
+ * ============================================================================
+ * MÔ TẢ: Đánh thức task sự kiện từ trong ngắt - SCH_Signal() được gọi ở
+ *        lần Dispatch kế tiếp
+ *   - Slot đã có tín hiệu đang chờ trong ring → gộp, không chiếm ô mới
+ *   - Handle chỉ được kiểm tra đầy đủ lúc Dispatch xử lý lệnh
+ *
+ * VÍ DỤ - Nút nhấn dùng EXTI đánh thức task xử lý nút:
+ *   void HAL_GPIO_EXTI_Callback(uint16_t GPIO_Pin) {
+ *       SCH_Signal_From_ISR(button_id);
+ *   }
+ * ============================================================================
+ */
+uint8_t SCH_Signal_From_ISR_In(SCH_Instance_t *SCH, const SCH_Handle_t TASK_HANDLE) {
+    uint32_t slot = SCH_HANDLE_SLOT(TASK_HANDLE);
+    sch_cmd_t cmd;
+
+    if (TASK_HANDLE == SCH_INVALID_HANDLE || slot >= SCH_MAX_TASKS) {
+        return RETURN_ERROR;
+    }
+    if (SCH->signal_posted[slot]) {
+        return RETURN_NORMAL;
+    }
+
+    cmd.Kind = CMD_SIGNAL;
+    cmd.pTask = 0x0000;
+    cmd.Delay = 0;
+    cmd.Period = 0;
+    cmd.Handle = TASK_HANDLE;
+    cmd.Result = 0x0000;
+
+    SCH->signal_posted[slot] = 1;
+    if (SCH_Post_Command(SCH, &cmd) != RETURN_NORMAL) {
+        SCH->signal_posted[slot] = 0;
+        return RETURN_ERROR;
+    }
+    return RETURN_NORMAL;
+}
+
+/**
+ * ============================================================================
+ * HÀM: SCH_Process_Commands (INTERNAL)
+ * ============================================================================
+ * MÔ TẢ: Thực hiện các lệnh đang chờ (phía Dispatch), theo thứ tự gửi
+ *   1. Barrier → đọc nội dung lệnh SAU khi đã thấy cmd_head tăng
+ *   2. Chép lệnh ra, trả ô cho ngắt (tăng cmd_tail)
+ *   3. Gọi SCH_Add_Task / SCH_Delete_Task / SCH_Signal như bình thường
+ *      (tín hiệu: xóa cờ signal_posted TRƯỚC → ngắt đến sau đó gửi lệnh mới)
+ * ============================================================================
+ */
+void SCH_Process_Commands(SCH_Instance_t *SCH) {
+    uint32_t tail = SCH->cmd_tail;
+
+    while (tail != SCH->cmd_head) {
+        SCH_MEMORY_BARRIER();
+        sch_cmd_t cmd = SCH->cmd_ring[tail & CMD_RING_MASK];
+        SCH_MEMORY_BARRIER();
+        SCH->cmd_tail = ++tail;
+
+        if (cmd.Kind == CMD_ADD) {
+            SCH_Handle_t handle = SCH_Add_Task_In(SCH, cmd.pTask, cmd.Delay, cmd.Period);
+            if (cmd.Result != 0x0000) {
+                *cmd.Result = handle;
+            }
+        } else if (cmd.Kind == CMD_DELETE) {
+            SCH_Delete_Task_In(SCH, cmd.Handle);
+        } else {
+            SCH->signal_posted[SCH_HANDLE_SLOT(cmd.Handle)] = 0;
+            SCH_Signal_In(SCH, cmd.Handle);
+        }
+    }
+}
+
+uint8_t SCH_Commands_Pending(SCH_Instance_t *SCH) {
+    return (SCH->cmd_head != SCH->cmd_tail) ? 1 : 0;
+}
@@ -0,0 +1,735 @@
+/*
+ * ============================================================================
+ * COOPERATIVE SCHEDULER - BACKEND CYCLIC EXECUTIVE (BẢNG KHUNG)
+ * ============================================================================
+ * Mô tả: Backend thay thế, chọn bằng
+ *        #define SCH_BACKEND SCH_BACKEND_CYCLIC (scheduler.h)
+ *
+ * Ý TƯỞNG:
+ *   Với chu kỳ cố định, lịch chạy lặp lại sau mỗi siêu chu kỳ
+ *   (hyperperiod) H = BCNN(các chu kỳ). Lịch đó được tính 1 lần thành
+ *   bảng khung: khung f (0 .. H-1) = danh sách task chạy ở tick có
+ *   (tick mod H) == f. Mỗi tick, Dispatch chỉ đọc danh sách của khung
+ *   hiện tại - không so sánh, không sắp xếp, không cập nhật Delay.
+ *
+ * VÍ DỤ (ứng dụng đèn giao thông): Button P=1, FSM P=1, Display P=5
+ *   H = 5, 11 mục:
+ *     khung 0: Button, FSM, Display
+ *     khung 1: Button, FSM
+ *     ...
+ *     khung 4: Button, FSM
+ *   → Tải của từng khung biết trước (SCH_Get_Frame_Tasks), chứng minh
+ *     được "không bao giờ quá 3 task trong 1 tick"
+ *
+ * ĐỘ PHỨC TẠP:
+ * - SCH_Update()   O(1): ISR CHỈ đếm tick (giống timing wheel)
+ * - Mỗi tick       O(số task của khung) - không phụ thuộc tổng số task;
+ *                  danh sách phụ chỉ được duyệt (O(số task phụ)) ở tick
+ *                  đến hạn sớm nhất của nó, các tick khác O(1)
+ * - Add / Delete / Reschedule: O(n) để kiểm tra bảng còn chứa được,
+ *   bảng được dựng lại O(n + số mục) ở đầu tick kế tiếp
+ *
+ * GIỚI HẠN:
+ * - Chỉ task có chu kỳ 1 .. SCH_CYCLIC_MAX_FRAMES nằm trong bảng; phải
+ *   có H <= SCH_CYCLIC_MAX_FRAMES và tổng H / Pi <= SCH_CYCLIC_MAX_ENTRIES
+ * - Task one-shot (Period 0), chu kỳ dài hơn (vd. task sự kiện đang
+ *   "đỗ" SCH_EVENT_PARK_TICKS) và task làm bảng tràn nằm ngoài bảng
+ *   (danh sách phụ - liên kết đôi riêng, kèm tick đến hạn sớm nhất) -
+ *   vẫn chạy đúng chu kỳ, chỉ không có trong SCH_Get_Frame_Tasks
+ *
+ * VÍ DỤ: Button P=1, FSM P=1, Display P=5, thêm task 1 giây P=100
+ *   → H = 100, 100 + 100 + 20 + 1 = 221 mục > 200 → task 1 giây vào
+ *     danh sách phụ, bảng giữ H = 5, 11 mục
+ * - Task sự kiện: mỗi SCH_Signal là 1 Reschedule → bảng dựng lại 1 lần
+ *
+ * LƯU Ý:
+ * - Bảng slot và handle dùng chung với các backend khác (scheduler.c)
+ * - SCH_TASK_DELAY(i) lưu TICK ĐẾN HẠN TUYỆT ĐỐI của lần chạy kế tiếp
+ *   (theo SCH->tick_now); khung của task = Delay mod Period
+ * ============================================================================
+ */
+
+#include "scheduler.h"
+#include "scheduler_internal.h"
+
+#if SCH_BACKEND == SCH_BACKEND_CYCLIC
+
+/* ==================== CẤU HÌNH NỘI BỘ ==================== */
+
+// Chu kỳ có thể nằm trong bảng khung?
+#define CYCLIC_IN_TABLE(PERIOD) ((PERIOD) > 0 && (PERIOD) <= SCH_CYCLIC_MAX_FRAMES)
+
+// Task của slot nằm ngoài bảng (danh sách phụ)?
+#define CYCLIC_ON_SIDE(SLOT)    (SCH->on_side[SLOT])
+
+// side_due khi chưa biết task phụ nào: nửa vòng uint32_t sau tick hiện tại
+#define CYCLIC_SIDE_FAR         0x7FFFFFFFuL
+
+typedef sch_cyclic_entry_t cyclic_entry_t;
+
+/* ==================== BIẾN NỘI BỘ ==================== */
+
+// Nằm trong SCH_Instance_t:
+// - Bảng khung: các mục của khung f nằm ở
+//   SCH->frame_task[frame_start[f] .. frame_start[f+1])
+// - SCH->in_table[slot]: 1 = slot có mục trong bảng hiện tại
+//   (0 → mục cũ của slot được bỏ qua)
+// - SCH->hyperperiod: H (1 sau SCH_Init)
+// - SCH->frame:       khung của tick vừa xử lý = done_ticks mod H
+// - SCH->table_dirty: có Add/Delete/Reschedule → dựng lại bảng
+// - SCH->in_tick:     đang duyệt 1 khung → không dựng lại bảng giữa chừng
+// - SCH->on_side[slot]: 1 = task nằm ngoài bảng (one-shot, chu kỳ dài,
+//   bảng không chứa được), đặt lúc Add / Reschedule
+// - SCH->side_head, side_next / side_prev[slot]: danh sách phụ (liên kết
+//   đôi, kết thúc bằng SCH_NO_SLOT), thêm vào đầu
+// - SCH->side_cursor: slot kế tiếp khi đang duyệt danh sách phụ (gỡ slot
+//   này → con trỏ nhảy sang slot sau, việc duyệt không bị hỏng)
+// - SCH->side_due:    tick đến hạn sớm nhất của danh sách phụ (có thể
+//   sớm hơn thật sau Delete → lần duyệt đó không chạy gì và tính lại)
+// - SCH->done_ticks:  đếm tick - ISR chỉ tăng tick_now, Dispatch tăng done_ticks
+
+/* ==================== HÀM PRIVATE (INTERNAL) ==================== */
+static uint32_t cyclic_gcd(uint32_t a, uint32_t b);
+static uint8_t cyclic_fits(SCH_Instance_t *SCH, sch_index_t skip, uint32_t period);
+static uint8_t cyclic_side(SCH_Instance_t *SCH, sch_index_t skip, uint32_t period);
+static void cyclic_build(SCH_Instance_t *SCH);
+static void cyclic_side_due(SCH_Instance_t *SCH, uint32_t due);
+static void cyclic_side_link(SCH_Instance_t *SCH, sch_index_t slot);
+static void cyclic_side_unlink(SCH_Instance_t *SCH, sch_index_t slot);
+static void cyclic_arm(SCH_Instance_t *SCH, sch_index_t slot, uint32_t DELAY);
+static void cyclic_release(SCH_Instance_t *SCH, sch_index_t slot);
+static void cyclic_tick(SCH_Instance_t *SCH);
+
+static uint32_t cyclic_gcd(uint32_t a, uint32_t b) {
+    while (b != 0) {
+        uint32_t t = a % b;
+        a = b;
+        b = t;
+    }
+    return a;
+}
+
+/**
+ * ============================================================================
+ * HÀM: cyclic_fits (PRIVATE)
+ * ============================================================================
+ * MÔ TẢ: Bảng khung có chứa được các task đang ở trong bảng (trừ slot
+ *        `skip`) cộng thêm 1 task chu kỳ `period` không? - O(n)
+ *   H = BCNN các chu kỳ <= SCH_CYCLIC_MAX_FRAMES
+ *   Số mục = tổng H / Pi <= SCH_CYCLIC_MAX_ENTRIES
+ *
+ * VÍ DỤ: có P = 1, 1, 5 (H = 5, 11 mục), thêm P = 4
+ *   → H = 20, số mục = 20 + 20 + 4 + 5 = 49 → chứa được
+ * ============================================================================
+ */
+static uint8_t cyclic_fits(SCH_Instance_t *SCH, sch_index_t skip, uint32_t period) {
+    uint32_t h = 1;
+    uint32_t entries = 0;
+
+    if (!CYCLIC_IN_TABLE(period)) {
+        return 1;                       // Nằm ngoài bảng
+    }
+
+    // Lượt 1: siêu chu kỳ
+    for (uint32_t slot = 0; slot <= SCH_MAX_TASKS; slot++) {
+        uint32_t p = (slot == SCH_MAX_TASKS) ? period : SCH_TASK_PERIOD(slot);
+        if (slot < SCH_MAX_TASKS && (slot == skip || SCH_TASK_FN(slot) == 0x0000 ||
+                                     CYCLIC_ON_SIDE(slot))) continue;
+        if (!CYCLIC_IN_TABLE(p)) continue;
+
+        h = h / cyclic_gcd(h, p) * p;
+        if (h > SCH_CYCLIC_MAX_FRAMES) {
+            return 0;
+        }
+    }
+
+    // Lượt 2: số mục
+    for (uint32_t slot = 0; slot <= SCH_MAX_TASKS; slot++) {
+        uint32_t p = (slot == SCH_MAX_TASKS) ? period : SCH_TASK_PERIOD(slot);
+        if (slot < SCH_MAX_TASKS && (slot == skip || SCH_TASK_FN(slot) == 0x0000 ||
+                                     CYCLIC_ON_SIDE(slot))) continue;
+        if (!CYCLIC_IN_TABLE(p)) continue;
+
+        entries += h / p;
+        if (entries > SCH_CYCLIC_MAX_ENTRIES) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/**
+ * ============================================================================
+ * HÀM: cyclic_side (PRIVATE)
+ * ============================================================================
+ * MÔ TẢ: Task chu kỳ `period` (thay cho slot `skip`) phải nằm ngoài bảng?
+ *        One-shot, chu kỳ > SCH_CYCLIC_MAX_FRAMES, hoặc bảng không chứa
+ *        được → danh sách phụ thay vì từ chối task
+ * ============================================================================
+ */
+static uint8_t cyclic_side(SCH_Instance_t *SCH, sch_index_t skip, uint32_t period) {
+    return !CYCLIC_IN_TABLE(period) || !cyclic_fits(SCH, skip, period);
+}
+
+/**
+ * ============================================================================
+ * HÀM: cyclic_build (PRIVATE)
+ * ============================================================================
+ * MÔ TẢ: Dựng lại bảng khung từ bảng slot - O(n + số mục)
+ *   1. H = BCNN chu kỳ các task trong bảng
+ *   2. Đếm số mục của mỗi khung (task P, pha r = Delay mod P có mặt ở
+ *      các khung r, r + P, ..., r + H - P), cộng dồn → frame_start[]
+ *   3. Điền frame_task[] (thứ tự slot trong mỗi khung; SCH_PRIORITY:
+ *      theo lớp trước, cùng lớp theo slot → task CRITICAL chạy đầu khung)
+ *   Khung hiện tại được tính lại từ done_ticks (không lệch pha)
+ *
+ *   Add / Reschedule đã kiểm tra bằng cyclic_fits (task không vừa nằm
+ *   ngoài bảng) → luôn chứa được
+ * ============================================================================
+ */
+static void cyclic_build(SCH_Instance_t *SCH) {
+    uint32_t h = 1;
+
+    for (uint32_t slot = 0; slot < SCH_MAX_TASKS; slot++) {
+        uint32_t p = SCH_TASK_PERIOD(slot);
+        SCH->in_table[slot] = 0;
+        if (SCH_TASK_FN(slot) == 0x0000 || CYCLIC_ON_SIDE(slot)) continue;
+
+        h = h / cyclic_gcd(h, p) * p;
+    }
+
+    // Đếm mục của mỗi khung (frame_start[f + 1] = số mục của khung f)
+    for (uint32_t f = 0; f <= h; f++) {
+        SCH->frame_start[f] = 0;
+    }
+    for (uint32_t slot = 0; slot < SCH_MAX_TASKS; slot++) {
+        uint32_t p = SCH_TASK_PERIOD(slot);
+        if (SCH_TASK_FN(slot) == 0x0000 || CYCLIC_ON_SIDE(slot)) continue;
+
+        for (uint32_t f = SCH_TASK_DELAY(slot) % p; f < h; f += p) {
+            SCH->frame_start[f + 1u]++;
+        }
+    }
+    for (uint32_t f = 0; f < h; f++) {
+        SCH->frame_start[f + 1u] = (cyclic_entry_t)(SCH->frame_start[f + 1u] + SCH->frame_start[f]);
+    }
+
+    // Điền mục: frame_start[f] dùng làm con trỏ ghi rồi trả lại giá trị cũ
+    for (uint32_t c = 0; c < (SCH_PRIORITY ? SCH_CLASSES : 1u); c++) {
+        for (uint32_t slot = 0; slot < SCH_MAX_TASKS; slot++) {
+            uint32_t p = SCH_TASK_PERIOD(slot);
+            if (SCH_TASK_FN(slot) == 0x0000 || CYCLIC_ON_SIDE(slot)) continue;
+            if (SCH_PRIORITY && SCH_Task_Class(SCH, (sch_index_t)slot) != c) continue;
+
+            for (uint32_t f = SCH_TASK_DELAY(slot) % p; f < h; f += p) {
+                SCH->frame_task[SCH->frame_start[f]++] = (sch_index_t)slot;
+            }
+            SCH->in_table[slot] = 1;
+        }
+    }
+    for (uint32_t f = h; f > 0; f--) {
+        SCH->frame_start[f] = SCH->frame_start[f - 1u];
+    }
+    SCH->frame_start[0] = 0;
+
+    SCH->hyperperiod = h;
+    SCH->frame = SCH->done_ticks % h;
+    SCH->table_dirty = 0;
+}
+
+/**
+ * ============================================================================
+ * HÀM: cyclic_side_due / cyclic_side_link / cyclic_side_unlink (PRIVATE)
+ * ============================================================================
+ * MÔ TẢ: Danh sách phụ - O(1)
+ *   - Due:    kéo side_due về `due` nếu sớm hơn (so sánh an toàn khi tràn)
+ *   - Link:   thêm slot (đã đặt Delay) vào đầu danh sách; đang duyệt thì
+ *             slot mới không được duyệt trong tick này (chưa đến hạn)
+ *   - Unlink: gỡ slot, dời side_cursor nếu nó đang trỏ vào slot
+ * ============================================================================
+ */
+static void cyclic_side_due(SCH_Instance_t *SCH, uint32_t due) {
+    if ((int32_t)(due - SCH->side_due) < 0) {
+        SCH->side_due = due;
+    }
+}
+
+static void cyclic_side_link(SCH_Instance_t *SCH, sch_index_t slot) {
+    sch_index_t head = SCH->side_head;
+
+    if (head == SCH_NO_SLOT) {
+        SCH->side_due = SCH_TASK_DELAY(slot);
+    } else {
+        SCH->side_prev[head] = slot;
+        cyclic_side_due(SCH, SCH_TASK_DELAY(slot));
+    }
+    SCH->side_next[slot] = head;
+    SCH->side_prev[slot] = SCH_NO_SLOT;
+    SCH->side_head = slot;
+    SCH->on_side[slot] = 1;
+}
+
+static void cyclic_side_unlink(SCH_Instance_t *SCH, sch_index_t slot) {
+    sch_index_t next = SCH->side_next[slot];
+    sch_index_t prev = SCH->side_prev[slot];
+
+    if (!SCH->on_side[slot]) return;
+
+    if (prev == SCH_NO_SLOT) {
+        SCH->side_head = next;
+    } else {
+        SCH->side_next[prev] = next;
+    }
+    if (next != SCH_NO_SLOT) {
+        SCH->side_prev[next] = prev;
+    }
+    if (SCH->side_cursor == slot) {
+        SCH->side_cursor = next;
+    }
+    SCH->on_side[slot] = 0;
+}
+
+/**
+ * ============================================================================
+ * HÀM: cyclic_arm (PRIVATE)
+ * ============================================================================
+ * MÔ TẢ: Đặt tick đến hạn (cùng ngữ nghĩa DELAY với mảng sắp xếp:
+ *        0 hoặc 1 → tick kế tiếp), gỡ task khỏi bảng hiện tại và
+ *        đánh dấu dựng lại bảng
+ * ============================================================================
+ */
+static void cyclic_arm(SCH_Instance_t *SCH, sch_index_t slot, uint32_t DELAY) {
+    if (DELAY == 0) DELAY = 1;
+
+    SCH_TASK_DELAY(slot) = SCH->done_ticks + DELAY;
+    SCH_TASK_RUNME(slot) = 0;
+    SCH_Set_Due(SCH, slot, SCH_TASK_DELAY(slot));
+
+    SCH->in_table[slot] = 0;
+    SCH->table_dirty = 1;
+}
+
+#if SCH_PRIORITY
+/**
+ * ============================================================================
+ * HÀM: SCH_Class_Changed (INTERNAL)
+ * ============================================================================
+ * MÔ TẢ: Thứ tự trong khung theo lớp → dựng lại bảng ở tick kế tiếp
+ * ============================================================================
+ */
+void SCH_Class_Changed(SCH_Instance_t *SCH, sch_index_t slot) {
+    if (SCH->in_table[slot]) {
+        SCH->table_dirty = 1;
+    }
+}
+#endif
+
+/**
+ * ============================================================================
+ * HÀM: cyclic_release (PRIVATE)
+ * ============================================================================
+ * MÔ TẢ: Chạy 1 task đã đến hạn
+ *   - Kiểm tra trễ hạn (SCH_Deadline_Check), REPLAY chạy bù liền
+ *   - One-shot: trả slot
+ *   - Periodic: tick đến hạn kế tiếp = lần đầu tiên SAU SCH->tick_now,
+ *     cùng pha (Delay + k * Period) → task không đổi khung, và khi
+ *     Dispatch bị trễ, các khung chạy bù không gọi task thêm lần nữa
+ *
+ * VÍ DỤ: P = 5, Delay = 10, Dispatch trễ tới tick 23
+ *   → chạy 1 lần (COALESCE), Delay = 25 (vẫn khung 0 mod 5)
+ * ============================================================================
+ */
+static void cyclic_release(SCH_Instance_t *SCH, sch_index_t slot) {
+    SCH_Handle_t id = SCH_TASK_ID(slot);
+    uint32_t due = SCH_TASK_DELAY(slot);
+
+    if (SCH_Deadline_Check(SCH, slot)) {
+        SCH_Run_Task(SCH, slot);
+        while (SCH_TASK_ID(slot) == id && SCH_TASK_DELAY(slot) == due && SCH_Replay_Pending(SCH, slot)) {
+            SCH_Deadline_Check(SCH, slot);
+            SCH_Run_Task(SCH, slot);
+        }
+    }
+
+    // Task đã tự Delete hoặc tự Reschedule (Delay đã được đặt lại)
+    if (SCH_TASK_ID(slot) != id || SCH_TASK_FN(slot) == 0x0000 || SCH_TASK_DELAY(slot) != due) {
+        return;
+    }
+
+    if (SCH_TASK_PERIOD(slot) == 0) {
+        cyclic_side_unlink(SCH, slot);
+        SCH_Slot_Kill(SCH, slot);
+        SCH_Slot_Release(SCH, slot);
+    } else {
+        SCH_TASK_DELAY(slot) = SCH_Rearm_Due(SCH, slot);
+    }
+}
+
+/**
+ * ============================================================================
+ * HÀM: cyclic_tick (PRIVATE)
+ * ============================================================================
+ * MÔ TẢ: Xử lý tick kế tiếp: sang khung kế tiếp (quay về 0 sau H khung),
+ *        dựng lại bảng nếu cần, chạy các task của khung (đã đến hạn,
+ *        còn trong bảng), rồi các task ngoài bảng đã đến hạn
+ *
+ *   Danh sách phụ chỉ được duyệt khi tới side_due; lúc duyệt side_due
+ *   được tính lại từ các task còn trong danh sách
+ *
+ * VÍ DỤ: Button P=1, FSM P=1, Display P=5, task 1 giây P=100 (phụ)
+ *   → 99 tick / 100 chỉ so sánh tick với side_due, không duyệt gì thêm
+ * ============================================================================
+ */
+static void cyclic_tick(SCH_Instance_t *SCH) {
+    uint32_t tick = ++SCH->done_ticks;
+
+    SCH->frame = (SCH->frame + 1u == SCH->hyperperiod) ? 0 : SCH->frame + 1u;
+    if (SCH->table_dirty) {
+        cyclic_build(SCH);
+    }
+    SCH->in_tick = 1;
+
+    cyclic_entry_t end = SCH->frame_start[SCH->frame + 1u];
+    for (cyclic_entry_t e = SCH->frame_start[SCH->frame]; e < end; e++) {
+        sch_index_t slot = SCH->frame_task[e];
+
+        // Mục cũ (task đã xóa / đổi lịch) hoặc chưa tới lần chạy đầu tiên
+        if (!SCH->in_table[slot] || (int32_t)(tick - SCH_TASK_DELAY(slot)) < 0) {
+            continue;
+        }
+        cyclic_release(SCH, slot);
+    }
+
+    if (SCH->side_head != SCH_NO_SLOT && (int32_t)(tick - SCH->side_due) >= 0) {
+        sch_index_t slot = SCH->side_head;
+
+        // Task thêm vào trong lúc duyệt kéo side_due về qua cyclic_side_link
+        SCH->side_due = tick + CYCLIC_SIDE_FAR;
+        while (slot != SCH_NO_SLOT) {
+            SCH->side_cursor = SCH->side_next[slot];
+            if ((int32_t)(tick - SCH_TASK_DELAY(slot)) >= 0) {
+                cyclic_release(SCH, slot);
+            }
+            if (CYCLIC_ON_SIDE(slot)) {
+                cyclic_side_due(SCH, SCH_TASK_DELAY(slot));
+            }
+            slot = SCH->side_cursor;
+        }
+        SCH->side_cursor = SCH_NO_SLOT;
+    }
+
+    SCH->in_tick = 0;
+}
+
+/* ==================== IMPLEMENTATION ==================== */
+
+/**
+ * ============================================================================
+ * HÀM: SCH_Init_In (CYCLIC EXECUTIVE)
+ * ============================================================================
+ * MÔ TẢ: Xóa bảng slot, bảng khung rỗng (H = 1, 0 mục)
+ * ============================================================================
+ */
+void SCH_Init_In(SCH_Instance_t *SCH) {
+    SCH_Slots_Init(SCH);
+
+    for (uint32_t i = 0; i < SCH_MAX_TASKS; i++) {
+        SCH_TASK_FN(i) = 0x0000;
+        SCH->in_table[i] = 0;
+        SCH->on_side[i] = 0;
+    }
+    SCH->frame_start[0] = 0;
+    SCH->frame_start[1] = 0;
+
+    SCH->hyperperiod = 1;
+    SCH->frame = 0;
+    SCH->table_dirty = 0;
+    SCH->in_tick = 0;
+    SCH->side_head = SCH_NO_SLOT;
+    SCH->side_cursor = SCH_NO_SLOT;
+    SCH->side_due = 0;
+    SCH->done_ticks = SCH->tick_now;
+    SCH->error_code = 0;
+}
+
+/**
+ * ============================================================================
+ * HÀM: SCH_Init_Static_In (CYCLIC EXECUTIVE)
+ * ============================================================================
+ * MÔ TẢ: Khởi tạo rồi thêm từng dòng của bảng const; bảng khung được
+ *        dựng 1 lần ở tick đầu tiên
+ * ============================================================================
+ */
+void SCH_Init_Static_In(SCH_Instance_t *SCH, const SCH_Task_Table_t *TABLE) {
+    SCH_Init_In(SCH);
+
+    SCH_Admit_Table_Begin(SCH);
+    for (uint32_t i = 0; i < TABLE->Count; i++) {
+        SCH_Add_Task_In(SCH, TABLE->Tasks[i].pTask, TABLE->Tasks[i].Delay, TABLE->Tasks[i].Period);
+    }
+    SCH_Admit_Table_End(SCH);
+}
+
+/**
+ * ============================================================================
+ * HÀM: SCH_Add_Task_In (CYCLIC EXECUTIVE)
+ * ============================================================================
+ * MÔ TẢ: Lấy slot, đặt tick đến hạn; task vào bảng khung nếu bảng còn
+ *        chứa được, nếu không vào danh sách phụ - bảng được dựng lại ở
+ *        đầu tick kế tiếp
+ *
+ * TRẢ VỀ: Handle của task, SCH_INVALID_HANDLE nếu đầy
+ *         (bảng slot: ERROR_SCH_TOO_MANY_TASKS,
+ *          quá tải: ERROR_SCH_NOT_SCHEDULABLE)
+ * ============================================================================
+ */
+SCH_Handle_t SCH_Add_Task_In(SCH_Instance_t *SCH, void (*pFunction)(), uint32_t DELAY, uint32_t PERIOD) {
+
+    if (pFunction == 0x0000 || !SCH_Ticks_Check(SCH, DELAY, PERIOD) || !SCH_Admit(SCH, DELAY, PERIOD)) {
+        return SCH_INVALID_HANDLE;
+    }
+
+    uint8_t side = cyclic_side(SCH, SCH_NO_SLOT, PERIOD);
+
+    sch_index_t slot = SCH_Slot_Alloc(SCH, pFunction, PERIOD);
+    if (slot == SCH_NO_SLOT) {
+        return SCH_INVALID_HANDLE;
+    }
+
+    SCH->on_side[slot] = 0;
+    cyclic_arm(SCH, slot, DELAY);
+    if (side) {
+        cyclic_side_link(SCH, slot);
+    }
+
+    return SCH_TASK_ID(slot);
+}
+
+/**
+ * ============================================================================
+ * HÀM: SCH_Delete_Task_In (CYCLIC EXECUTIVE)
+ * ============================================================================
+ * MÔ TẢ: Trả slot ngay - O(1); mục của task trong bảng bị bỏ qua
+ *        (in_table = 0) cho tới khi bảng được dựng lại
+ * ============================================================================
+ */
+uint8_t SCH_Delete_Task_In(SCH_Instance_t *SCH, const SCH_Handle_t TASK_HANDLE) {
+
+#if SCH_FAST_LANE
+    if (SCH_FAST_HANDLE(TASK_HANDLE)) {
+        return SCH_Fast_Delete(SCH, TASK_HANDLE);
+    }
+#endif
+#if SCH_PIPELINE
+    if (SCH_STAGE_HANDLE(TASK_HANDLE)) {
+        return SCH_Stage_Delete(SCH, TASK_HANDLE);
+    }
+#endif
+
+    sch_index_t slot = SCH_Handle_To_Slot(SCH, TASK_HANDLE);
+    if (slot == SCH_NO_SLOT) {
+        SCH->error_code = ERROR_SCH_CANNOT_DELETE_TASK;
+        return RETURN_ERROR;
+    }
+
+    SCH->in_table[slot] = 0;
+    SCH->table_dirty = 1;
+    cyclic_side_unlink(SCH, slot);
+    SCH_Slot_Kill(SCH, slot);
+    SCH_Slot_Release(SCH, slot);
+
+    return RETURN_NORMAL;
+}
+
+/**
+ * ============================================================================
+ * HÀM: SCH_Reschedule_Task_In (CYCLIC EXECUTIVE)
+ * ============================================================================
+ * MÔ TẢ: Đổi tick đến hạn / chu kỳ, handle không đổi
+ *        Chu kỳ mới không vừa bảng khung → task chuyển ra danh sách phụ
+ * ============================================================================
+ */
+uint8_t SCH_Reschedule_Task_In(SCH_Instance_t *SCH, const SCH_Handle_t TASK_HANDLE, uint32_t DELAY, uint32_t PERIOD) {
+
+#if SCH_FAST_LANE
+    if (SCH_FAST_HANDLE(TASK_HANDLE)) {
+        return SCH_Fast_Reschedule(SCH, TASK_HANDLE, DELAY, PERIOD);
+    }
+#endif
+
+    sch_index_t slot = SCH_Handle_To_Slot(SCH, TASK_HANDLE);
+    if (slot == SCH_NO_SLOT) {
+        SCH->error_code = ERROR_SCH_CANNOT_DELETE_TASK;
+        return RETURN_ERROR;
+    }
+    if (!SCH_Ticks_Check(SCH, DELAY, PERIOD) || !SCH_Admit_Reschedule(SCH, slot, DELAY, PERIOD)) {
+        return RETURN_ERROR;
+    }
+
+    uint8_t side = cyclic_side(SCH, slot, PERIOD);
+
+    cyclic_side_unlink(SCH, slot);
+    SCH_TASK_PERIOD(slot) = PERIOD;
+    cyclic_arm(SCH, slot, DELAY);
+    if (side) {
+        cyclic_side_link(SCH, slot);
+    }
+
+    return RETURN_NORMAL;
+}
+
+/**
+ * ============================================================================
+ * HÀM: SCH_Update_In (CYCLIC EXECUTIVE) - GỌI TRONG INTERRUPT TIMER
+ * ============================================================================
+ * ĐỘ PHỨC TẠP: O(1) - chỉ tăng bộ đếm tick
+ * ============================================================================
+ */
+void SCH_Update_In(SCH_Instance_t *SCH) {
+    SCH->tick_now++;
+    SCH_TICK_STAMP();
+    SCH_TRACE_RECORD(SCH_TRACE_TICK, SCH->tick_now, 0);
+}
+
+/**
+ * ============================================================================
+ * HÀM: SCH_Dispatch_Tasks_In (CYCLIC EXECUTIVE)
+ * ============================================================================
+ * CÁCH HOẠT ĐỘNG:
+ *   (Trước tiên: thực hiện lệnh từ ngắt - SCH_Process_Commands,
+ *    rồi các task làn nhanh đã phát hành - SCH_Fast_Dispatch)
+ *   Với mỗi tick ISR đã đếm: sang khung kế tiếp, dựng lại bảng nếu cần,
+ *   chạy các task của khung
+ * ============================================================================
+ */
+void SCH_Dispatch_Tasks_In(SCH_Instance_t *SCH) {
+
+    SCH_TRACE_RECORD(SCH_TRACE_DISPATCH_BEGIN, SCH->tick_now, 0);
+
+    // Thực hiện các lệnh thêm/xóa task do ngắt gửi tới
+    SCH_Process_Commands(SCH);
+
+#if SCH_FAST_LANE
+    // Làn nhanh (SysTick) trước: các task 1ms không phải chờ làn 10ms
+    SCH_Fast_Dispatch(SCH);
+#endif
+
+    while (SCH->done_ticks != SCH->tick_now) {
+        cyclic_tick(SCH);
+    }
+
+    // Báo cáo lỗi (trễ hạn, bảng khung đầy, ...)
+    SCH_Report_Status_In(SCH);
+
+    SCH_TRACE_RECORD(SCH_TRACE_DISPATCH_END, SCH->tick_now, 0);
+}
+
+/**
+ * ============================================================================
+ * HÀM: SCH_Idle_Ticks / SCH_Skip_Ticks (INTERNAL - TICKLESS IDLE)
+ * ============================================================================
+ * MÔ TẢ:
+ *   - Idle_Ticks: duyệt tối đa H khung kể từ tick kế tiếp → khung đầu
+ *                 tiên có task đã đến hạn; so với side_due của danh
+ *                 sách phụ - O(1)
+ *   - Skip_Ticks: tiến SCH->tick_now, done_ticks và khung hiện tại
+ *                 (các khung bị bỏ qua không có task nào đến hạn)
+ * ============================================================================
+ */
+uint32_t SCH_Idle_Ticks(SCH_Instance_t *SCH) {
+    uint32_t best = SCH_IDLE_FOREVER;
+
+    if (SCH->tick_now != SCH->done_ticks) {
+        return 0;
+    }
+    if (SCH->table_dirty) {
+        return 1;           // Dựng lại bảng ở tick kế tiếp rồi tính lại
+    }
+
+    uint32_t f = SCH->frame;
+    for (uint32_t ticks = 1; ticks <= SCH->hyperperiod && best == SCH_IDLE_FOREVER; ticks++) {
+        uint32_t tick = SCH->done_ticks + ticks;
+        f = (f + 1u == SCH->hyperperiod) ? 0 : f + 1u;
+        for (cyclic_entry_t e = SCH->frame_start[f]; e < SCH->frame_start[f + 1u]; e++) {
+            sch_index_t slot = SCH->frame_task[e];
+            if (SCH->in_table[slot] && (int32_t)(tick - SCH_TASK_DELAY(slot)) >= 0) {
+                best = ticks;
+                break;
+            }
+        }
+    }
+
+    if (SCH->side_head != SCH_NO_SLOT) {
+        int32_t left = (int32_t)(SCH->side_due - SCH->done_ticks);
+        uint32_t ticks = (left > 0) ? (uint32_t)left : 1u;
+        if (ticks < best) best = ticks;
+    }
+
+    // Task trong bảng chưa tới lần chạy đầu tiên (DELAY > H): thức sau H tick
+    if (best == SCH_IDLE_FOREVER && SCH->frame_start[SCH->hyperperiod] > 0) {
+        best = SCH->hyperperiod;
+    }
+    return best;
+}
+
+void SCH_Skip_Ticks(SCH_Instance_t *SCH, uint32_t TICKS) {
+    SCH->tick_now += TICKS;
+    SCH->done_ticks += TICKS;
+    SCH->frame = (SCH->frame + TICKS) % SCH->hyperperiod;
+}
+
+/* ==================== BÁO CÁO BẢNG KHUNG ==================== */
+
+/**
+ * ============================================================================
+ * HÀM: SCH_Get_Hyperperiod_In
+ * ============================================================================
+ * MÔ TẢ: Số khung của bảng = BCNN chu kỳ các task trong bảng
+ *        (dựng lại bảng nếu vừa có thay đổi; gọi trong task → bảng
+ *        của tick hiện tại, thay đổi có hiệu lực từ tick kế tiếp)
+ * ============================================================================
+ */
+uint32_t SCH_Get_Hyperperiod_In(SCH_Instance_t *SCH) {
+    if (SCH->table_dirty && !SCH->in_tick) {
+        cyclic_build(SCH);
+    }
+    return SCH->hyperperiod;
+}
+
+/**
+ * ============================================================================
+ * HÀM: SCH_Get_Frame_Tasks_In
+ * ============================================================================
+ * MÔ TẢ: Các task chạy trong khung FRAME (mod H), theo thứ tự chạy
+ *
+ * VÍ DỤ - In toàn bộ lịch lúc khởi động:
+ *   SCH_Handle_t ids[8];
+ *   for (uint32_t f = 0; f < SCH_Get_Hyperperiod(); f++) {
+ *       uint32_t n = SCH_Get_Frame_Tasks(f, ids, 8);
+ *       printf("khung %lu: %lu task\n", f, n);
+ *   }
+ *
+ * TRẢ VỀ: Số task của khung (có thể > MAX, chỉ MAX handle đầu được ghi)
+ * ============================================================================
+ */
+uint32_t SCH_Get_Frame_Tasks_In(SCH_Instance_t *SCH, uint32_t FRAME, SCH_Handle_t *HANDLES, uint32_t MAX) {
+    uint32_t count = 0;
+
+    if (SCH->table_dirty && !SCH->in_tick) {
+        cyclic_build(SCH);
+    }
+
+    FRAME %= SCH->hyperperiod;
+    for (cyclic_entry_t e = SCH->frame_start[FRAME]; e < SCH->frame_start[FRAME + 1u]; e++) {
+        sch_index_t slot = SCH->frame_task[e];
+        if (!SCH->in_table[slot]) continue;
+
+        if (HANDLES != 0 && count < MAX) {
+            HANDLES[count] = SCH_TASK_ID(slot);
+        }
+        count++;
+    }
+    return count;
+}
+
+#endif /* SCH_BACKEND == SCH_BACKEND_CYCLIC */
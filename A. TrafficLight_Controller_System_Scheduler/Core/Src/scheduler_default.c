@@ -0,0 +1,194 @@
+/*
+ * ============================================================================
+ * COOPERATIVE SCHEDULER - INSTANCE MẶC ĐỊNH (API CŨ)
+ * ============================================================================
+ * Mô tả: SCH_default và các hàm SCH_xxx() quen thuộc
+ *
+ * INSTANCE:
+ * - Toàn bộ trạng thái của 1 scheduler nằm trong 1 SCH_Instance_t,
+ *   mọi hàm có bản SCH_xxx_In(SCH, ...) làm việc trên instance SCH
+ * - Các hàm SCH_xxx() trong file này chỉ chuyển tiếp sang SCH_default
+ *   → code cũ (main.c, Tasks.c, ngắt TIM2 / SysTick) không phải sửa
+ *
+ * VÍ DỤ:
+ *   SCH_Add_Task(Task_LED, 0, 50);
+ *   // giống hệt
+ *   SCH_Add_Task_In(&SCH_default, Task_LED, 0, 50);
+ *
+ * LƯU Ý:
+ * - SCH_default là biến toàn cục → bằng 0 lúc khởi động, đúng điều kiện
+ *   của 1 instance trước SCH_Init_In
+ * - Các tên cũ SCH_tasks_G, Error_code_G, SCH_order_G, MARKING, ...
+ *   (scheduler.h) trỏ vào các trường của SCH_default
+ * ============================================================================
+ */
+
+#include "scheduler.h"
+
+/* ==================== BIẾN TOÀN CỤC ==================== */
+
+// Instance của API SCH_xxx()
+SCH_Instance_t SCH_default;
+
+/* ==================== API CŨ → SCH_default ==================== */
+
+void SCH_Init(void) {
+    SCH_Init_In(&SCH_default);
+}
+
+void SCH_Init_Static(const SCH_Task_Table_t *TABLE) {
+    SCH_Init_Static_In(&SCH_default, TABLE);
+}
+
+void SCH_Update(void) {
+    SCH_Update_In(&SCH_default);
+}
+
+void SCH_Dispatch_Tasks(void) {
+    SCH_Dispatch_Tasks_In(&SCH_default);
+}
+
+SCH_Handle_t SCH_Add_Task(void (*pFunction)(), uint32_t DELAY, uint32_t PERIOD) {
+    return SCH_Add_Task_In(&SCH_default, pFunction, DELAY, PERIOD);
+}
+
+SCH_Handle_t SCH_Add_Lane_Task(uint8_t LANE, void (*pFunction)(), uint32_t DELAY, uint32_t PERIOD) {
+    return SCH_Add_Lane_Task_In(&SCH_default, LANE, pFunction, DELAY, PERIOD);
+}
+
+void SCH_Fast_Update(void) {
+    SCH_Fast_Update_In(&SCH_default);
+}
+
+#if SCH_PIPELINE
+SCH_Handle_t SCH_Add_Stage(SCH_Stage_t STAGE, SCH_Handle_t PREDECESSOR, void *OUT) {
+    return SCH_Add_Stage_In(&SCH_default, STAGE, PREDECESSOR, OUT);
+}
+
+uint8_t SCH_Set_Task_Output(const SCH_Handle_t TASK_HANDLE, void *OUT) {
+    return SCH_Set_Task_Output_In(&SCH_default, TASK_HANDLE, OUT);
+}
+#endif
+
+uint8_t SCH_Delete_Task(const SCH_Handle_t TASK_HANDLE) {
+    return SCH_Delete_Task_In(&SCH_default, TASK_HANDLE);
+}
+
+uint8_t SCH_Reschedule_Task(const SCH_Handle_t TASK_HANDLE, uint32_t DELAY, uint32_t PERIOD) {
+    return SCH_Reschedule_Task_In(&SCH_default, TASK_HANDLE, DELAY, PERIOD);
+}
+
+const sTask *SCH_Get_Task(const SCH_Handle_t TASK_HANDLE) {
+    return SCH_Get_Task_In(&SCH_default, TASK_HANDLE);
+}
+
+uint8_t SCH_Add_Task_From_ISR(void (*pFunction)(void), uint32_t DELAY, uint32_t PERIOD,
+                              SCH_Handle_t *HANDLE_OUT) {
+    return SCH_Add_Task_From_ISR_In(&SCH_default, pFunction, DELAY, PERIOD, HANDLE_OUT);
+}
+
+uint8_t SCH_Delete_Task_From_ISR(const SCH_Handle_t TASK_HANDLE) {
+    return SCH_Delete_Task_From_ISR_In(&SCH_default, TASK_HANDLE);
+}
+
+SCH_Handle_t SCH_Add_Event_Task(void (*pFunction)(void), uint32_t TIMEOUT) {
+    return SCH_Add_Event_Task_In(&SCH_default, pFunction, TIMEOUT);
+}
+
+uint8_t SCH_Signal(const SCH_Handle_t TASK_HANDLE) {
+    return SCH_Signal_In(&SCH_default, TASK_HANDLE);
+}
+
+uint8_t SCH_Signal_From_ISR(const SCH_Handle_t TASK_HANDLE) {
+    return SCH_Signal_From_ISR_In(&SCH_default, TASK_HANDLE);
+}
+
+void SCH_Report_Status(void) {
+    SCH_Report_Status_In(&SCH_default);
+}
+
+void SCH_Go_To_Sleep(void) {
+    SCH_Go_To_Sleep_In(&SCH_default);
+}
+
+void SCH_Get_Idle_Stats(SCH_Idle_Stats_t *STATS) {
+    SCH_Get_Idle_Stats_In(&SCH_default, STATS);
+}
+
+uint32_t SCH_Get_Current_Size(void) {
+    return SCH_Get_Current_Size_In(&SCH_default);
+}
+
+uint32_t SCH_Get_Tick(void) {
+    return SCH_Get_Tick_In(&SCH_default);
+}
+
+uint8_t SCH_Get_Task_Profile(const SCH_Handle_t TASK_HANDLE, SCH_Task_Profile_t *PROFILE) {
+    return SCH_Get_Task_Profile_In(&SCH_default, TASK_HANDLE, PROFILE);
+}
+
+void SCH_Reset_Task_Profiles(void) {
+    SCH_Reset_Task_Profiles_In(&SCH_default);
+}
+
+uint8_t SCH_Get_Task_Misses(const SCH_Handle_t TASK_HANDLE, SCH_Task_Misses_t *MISSES) {
+    return SCH_Get_Task_Misses_In(&SCH_default, TASK_HANDLE, MISSES);
+}
+
+#if SCH_PRIORITY
+uint8_t SCH_Set_Task_Class(const SCH_Handle_t TASK_HANDLE, uint8_t CLASS) {
+    return SCH_Set_Task_Class_In(&SCH_default, TASK_HANDLE, CLASS);
+}
+
+uint8_t SCH_Get_Class_Latency(uint8_t CLASS, SCH_Class_Latency_t *LATENCY) {
+    return SCH_Get_Class_Latency_In(&SCH_default, CLASS, LATENCY);
+}
+#endif
+
+#if SCH_SHED
+void SCH_Get_Shed_Stats(SCH_Shed_Stats_t *STATS) {
+    SCH_Get_Shed_Stats_In(&SCH_default, STATS);
+}
+#endif
+
+#if SCH_UTIL
+void SCH_Get_Utilization(SCH_Utilization_t *UTIL) {
+    SCH_Get_Utilization_In(&SCH_default, UTIL);
+}
+#endif
+
+#if SCH_ADMISSION
+SCH_Handle_t SCH_Add_Task_Wcet(void (*pFunction)(void), uint32_t DELAY, uint32_t PERIOD, uint32_t WCET) {
+    return SCH_Add_Task_Wcet_In(&SCH_default, pFunction, DELAY, PERIOD, WCET);
+}
+
+uint8_t SCH_Get_Admission(SCH_Admission_t *ADMISSION) {
+    return SCH_Get_Admission_In(&SCH_default, ADMISSION);
+}
+#endif
+
+#if SCH_STAGGER || SCH_ADMISSION
+uint8_t SCH_Set_Task_Cost(const SCH_Handle_t TASK_HANDLE, uint32_t COST) {
+    return SCH_Set_Task_Cost_In(&SCH_default, TASK_HANDLE, COST);
+}
+#endif
+
+#if SCH_STAGGER
+SCH_Handle_t SCH_Add_Task_Staggered(void (*pFunction)(void), uint32_t PERIOD, uint32_t COST) {
+    return SCH_Add_Task_Staggered_In(&SCH_default, pFunction, PERIOD, COST);
+}
+
+uint32_t SCH_Get_Load_Profile(uint32_t *LOAD, uint32_t LEN) {
+    return SCH_Get_Load_Profile_In(&SCH_default, LOAD, LEN);
+}
+#endif
+
+#if SCH_BACKEND == SCH_BACKEND_CYCLIC
+uint32_t SCH_Get_Hyperperiod(void) {
+    return SCH_Get_Hyperperiod_In(&SCH_default);
+}
+
+uint32_t SCH_Get_Frame_Tasks(uint32_t FRAME, SCH_Handle_t *HANDLES, uint32_t MAX) {
+    return SCH_Get_Frame_Tasks_In(&SCH_default, FRAME, HANDLES, MAX);
+}
+#endif
@@ -0,0 +1,286 @@
+/*
+ * ============================================================================
+ * COOPERATIVE SCHEDULER - LÀN NHANH 1ms (SYSTICK)
+ * ============================================================================
+ * Mô tả: Làn thứ 2 của scheduler, chạy theo SysTick (1ms) thay vì TIM2
+ *        (10ms) - cho các việc cần mịn hơn 1 tick: quét nút, quét LED
+ *        Dùng chung cho mọi backend (làn 10ms vẫn là backend đã chọn)
+ *
+ * 2 LÀN, 1 API:
+ *   SCH_Add_Lane_Task(SCH_LANE_TICK, f, d, p)  = SCH_Add_Task(f, d, p), tick 10ms
+ *   SCH_Add_Lane_Task(SCH_LANE_FAST, f, d, p)  → làn nhanh, DELAY/PERIOD tính bằng ms
+ *   SCH_Delete_Task / SCH_Reschedule_Task nhận handle của cả 2 làn
+ *   (handle làn nhanh có bit SCH_FAST_HANDLE_BIT trong phần slot)
+ *
+ * HÀNG ĐỢI RIÊNG:
+ * - Bảng nhỏ SCH_FAST_MAX_TASKS ô, SysTick_Handler gọi SCH_Fast_Update():
+ *   đếm lùi Delay của từng ô, hết → Released++ và nạp lại Period
+ * - SCH_Dispatch_Tasks() chạy các task làn nhanh đã phát hành TRƯỚC
+ *   các task 10ms
+ * - Released chỉ do ngắt ghi, Done chỉ do Dispatch ghi → số lần chờ
+ *   = Released - Done, không cần tắt ngắt (giống ring lệnh từ ngắt)
+ *
+ * GIỚI HẠN:
+ * - Nhiều lần phát hành dồn lại (Dispatch bận) → chạy 1 lần (gộp)
+ * - Không có profile / tải CPU / thống kê trễ hạn cho task làn nhanh
+ * - Còn task làn nhanh → SCH_Go_To_Sleep() không tắt SysTick, không
+ *   kéo dài TIM2 (MCU vẫn ngủ WFI giữa 2 ngắt)
+ * ============================================================================
+ */
+
+#include "scheduler.h"
+#include "scheduler_internal.h"
+
+#if SCH_FAST_LANE
+
+#if SCH_MAX_TASKS > SCH_FAST_HANDLE_BIT
+#error "SCH_FAST_LANE needs SCH_MAX_TASKS <= 0x8000 (bit 15 marks fast lane handles)"
+#endif
+
+#if SCH_FAST_MAX_TASKS > 0xFF
+#error "SCH_FAST_MAX_TASKS must be below 256"
+#endif
+
+/* ==================== BIẾN NỘI BỘ ==================== */
+
+// Nằm trong SCH_Instance_t:
+// - SCH->fast_tasks[]: các ô của làn nhanh (sch_fast_t); ô trống: pTask = 0
+//   Released chỉ ngắt ghi, Done chỉ Dispatch ghi
+// - SCH->fast_count: số ô đang dùng
+
+/* ==================== HÀM PRIVATE ==================== */
+
+/**
+ * ============================================================================
+ * HÀM: fast_lookup (PRIVATE)
+ * ============================================================================
+ * MÔ TẢ: Kiểm tra handle làn nhanh và trả về ô - O(1)
+ * TRẢ VỀ: Ô, hoặc 0 nếu handle sai / task đã bị xóa
+ * ============================================================================
+ */
+static sch_fast_t *fast_lookup(SCH_Instance_t *SCH, SCH_Handle_t handle) {
+    uint32_t i = SCH_HANDLE_SLOT(handle) & ~SCH_FAST_HANDLE_BIT;
+
+    if (!SCH_FAST_HANDLE(handle) || i >= SCH_FAST_MAX_TASKS) {
+        return 0;
+    }
+    sch_fast_t *t = &SCH->fast_tasks[i];
+    if (t->pTask == 0x0000 || t->Gen != SCH_HANDLE_GEN(handle)) {
+        return 0;
+    }
+    return t;
+}
+
+/**
+ * ============================================================================
+ * HÀM: fast_arm (PRIVATE)
+ * ============================================================================
+ * MÔ TẢ: Ghi thời gian của ô rồi mới ghi pTask → ngắt chỉ thấy ô khi đã
+ *        đầy đủ (DELAY = 0 hoặc 1 → phát hành ở ms kế tiếp)
+ *        Bỏ các lần phát hành còn chờ (Done = Released)
+ * ============================================================================
+ */
+static void fast_arm(SCH_Instance_t *SCH, sch_fast_t *t, void (*pFunction)(void), uint32_t DELAY, uint32_t PERIOD) {
+    t->pTask = 0x0000;
+    SCH_MEMORY_BARRIER();
+
+    t->Delay = (uint16_t)((DELAY > 0) ? DELAY : 1u);
+    t->Period = (uint16_t)PERIOD;
+    t->Done = t->Released;
+
+    SCH_MEMORY_BARRIER();
+    t->pTask = pFunction;
+}
+
+/* ==================== IMPLEMENTATION ==================== */
+
+/**
+ * ============================================================================
+ * HÀM: SCH_Fast_Init (INTERNAL)
+ * ============================================================================
+ * MÔ TẢ: Làm rỗng làn nhanh - gọi trong SCH_Init
+ *        Gen được giữ → handle cấp trước SCH_Init vẫn bị từ chối
+ * ============================================================================
+ */
+void SCH_Fast_Init(SCH_Instance_t *SCH) {
+    for (uint32_t i = 0; i < SCH_FAST_MAX_TASKS; i++) {
+        SCH->fast_tasks[i].pTask = 0x0000;
+    }
+    SCH->fast_count = 0;
+}
+
+/**
+ * ============================================================================
+ * HÀM: SCH_Fast_Update_In - GỌI TRONG SysTick_Handler (1ms)
+ * ============================================================================
+ * ĐỘ PHỨC TẠP: O(SCH_FAST_MAX_TASKS) - duyệt bảng nhỏ, không sắp xếp
+ *
+ * VÍ DỤ: Button_Scan Period = 5
+ *   Delay 5 → 4 → 3 → 2 → 1 → 0: Released++, Delay = 5
+ * ============================================================================
+ */
+void SCH_Fast_Update_In(SCH_Instance_t *SCH) {
+    for (uint32_t i = 0; i < SCH_FAST_MAX_TASKS; i++) {
+        sch_fast_t *t = &SCH->fast_tasks[i];
+
+        if (t->pTask == 0x0000 || t->Delay == 0) {
+            continue;
+        }
+        if (--t->Delay == 0) {
+            // Chưa xử lý 255 lần → giữ nguyên (Dispatch gộp lại thành 1 lần)
+            if ((uint8_t)(t->Released - t->Done) != 0xFFu) {
+                t->Released++;
+            }
+            t->Delay = t->Period;
+        }
+    }
+}
+
+/**
+ * ============================================================================
+ * HÀM: SCH_Fast_Dispatch (INTERNAL)
+ * ============================================================================
+ * MÔ TẢ: Chạy mỗi task làn nhanh đã phát hành 1 lần - đầu
+ *        SCH_Dispatch_Tasks() của mọi backend
+ *        One-shot: trả ô sau khi chạy
+ * ============================================================================
+ */
+void SCH_Fast_Dispatch(SCH_Instance_t *SCH) {
+    for (uint32_t i = 0; i < SCH_FAST_MAX_TASKS; i++) {
+        sch_fast_t *t = &SCH->fast_tasks[i];
+        void (*task)(void) = t->pTask;
+        uint8_t released = t->Released;
+
+        if (task == 0x0000 || released == t->Done) {
+            continue;
+        }
+        t->Done = released;
+
+        SCH_TRACE_RECORD(SCH_TRACE_TASK_BEGIN, SCH_FAST_HANDLE_BIT | i, 1);
+        (*task)();
+        SCH_TRACE_RECORD(SCH_TRACE_TASK_END, SCH_FAST_HANDLE_BIT | i, 0);
+
+        // One-shot chưa tự Reschedule / Delete trong lúc chạy → trả ô
+        if (t->pTask == task && t->Period == 0 && t->Delay == 0) {
+            t->pTask = 0x0000;
+            SCH->fast_count--;
+        }
+    }
+}
+
+/**
+ * ============================================================================
+ * HÀM: SCH_Fast_Pending / SCH_Fast_Active (INTERNAL)
+ * ============================================================================
+ * MÔ TẢ: Cho SCH_Go_To_Sleep()
+ *   - Pending: có task làn nhanh đã phát hành, chưa chạy → không ngủ
+ *   - Active:  có task làn nhanh → giữ SysTick, không kéo dài TIM2
+ * ============================================================================
+ */
+uint8_t SCH_Fast_Pending(SCH_Instance_t *SCH) {
+    for (uint32_t i = 0; i < SCH_FAST_MAX_TASKS; i++) {
+        if (SCH->fast_tasks[i].pTask != 0x0000 && SCH->fast_tasks[i].Released != SCH->fast_tasks[i].Done) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+uint8_t SCH_Fast_Active(SCH_Instance_t *SCH) {
+    return SCH->fast_count > 0;
+}
+
+/**
+ * ============================================================================
+ * HÀM: SCH_Add_Lane_Task_In
+ * ============================================================================
+ * MÔ TẢ: Thêm task vào làn LANE - 1 API cho cả 2 làn
+ *   - SCH_LANE_TICK: giống hệt SCH_Add_Task (DELAY/PERIOD tính bằng tick)
+ *   - SCH_LANE_FAST: DELAY/PERIOD tính bằng ms (tối đa 65535)
+ *
+ * VÍ DỤ:
+ *   SCH_Add_Lane_Task(SCH_LANE_FAST, Task_Button_Scan, 0, 5);    // mỗi 5ms
+ *   SCH_Add_Lane_Task(SCH_LANE_TICK, Task_Traffic_FSM, 0, 1);    // mỗi 10ms
+ *
+ * TRẢ VỀ: Handle của task, SCH_INVALID_HANDLE nếu lỗi
+ *         (đầy: ERROR_SCH_TOO_MANY_TASKS, quá dài: ERROR_SCH_PERIOD_TOO_LONG)
+ * ============================================================================
+ */
+SCH_Handle_t SCH_Add_Lane_Task_In(SCH_Instance_t *SCH, uint8_t LANE, void (*pFunction)(), uint32_t DELAY, uint32_t PERIOD) {
+    if (LANE != SCH_LANE_FAST) {
+        return SCH_Add_Task_In(SCH, pFunction, DELAY, PERIOD);
+    }
+    if (pFunction == 0x0000) {
+        return SCH_INVALID_HANDLE;
+    }
+    if (DELAY > 0xFFFFu || PERIOD > 0xFFFFu) {
+        SCH->error_code = ERROR_SCH_PERIOD_TOO_LONG;
+        return SCH_INVALID_HANDLE;
+    }
+
+    for (uint32_t i = 0; i < SCH_FAST_MAX_TASKS; i++) {
+        sch_fast_t *t = &SCH->fast_tasks[i];
+        if (t->pTask != 0x0000) {
+            continue;
+        }
+        t->Gen++;
+        fast_arm(SCH, t, pFunction, DELAY, PERIOD);
+        SCH->fast_count++;
+        return ((uint32_t)t->Gen << 16) | SCH_FAST_HANDLE_BIT | i;
+    }
+
+    SCH->error_code = ERROR_SCH_TOO_MANY_TASKS;
+    return SCH_INVALID_HANDLE;
+}
+
+/**
+ * ============================================================================
+ * HÀM: SCH_Fast_Delete / SCH_Fast_Reschedule (INTERNAL)
+ * ============================================================================
+ * MÔ TẢ: SCH_Delete_Task / SCH_Reschedule_Task của backend chuyển handle
+ *        làn nhanh (SCH_FAST_HANDLE) sang đây - O(1)
+ *        Reschedule: DELAY/PERIOD tính bằng ms, bỏ lần phát hành đang chờ
+ * ============================================================================
+ */
+uint8_t SCH_Fast_Delete(SCH_Instance_t *SCH, SCH_Handle_t TASK_HANDLE) {
+    sch_fast_t *t = fast_lookup(SCH, TASK_HANDLE);
+    if (t == 0) {
+        SCH->error_code = ERROR_SCH_CANNOT_DELETE_TASK;
+        return RETURN_ERROR;
+    }
+    t->pTask = 0x0000;
+    SCH->fast_count--;
+    return RETURN_NORMAL;
+}
+
+uint8_t SCH_Fast_Reschedule(SCH_Instance_t *SCH, SCH_Handle_t TASK_HANDLE, uint32_t DELAY, uint32_t PERIOD) {
+    sch_fast_t *t = fast_lookup(SCH, TASK_HANDLE);
+    if (t == 0) {
+        SCH->error_code = ERROR_SCH_CANNOT_DELETE_TASK;
+        return RETURN_ERROR;
+    }
+    if (DELAY > 0xFFFFu || PERIOD > 0xFFFFu) {
+        SCH->error_code = ERROR_SCH_PERIOD_TOO_LONG;
+        return RETURN_ERROR;
+    }
+    fast_arm(SCH, t, t->pTask, DELAY, PERIOD);
+    return RETURN_NORMAL;
+}
+
+#else
+
+void SCH_Fast_Init(SCH_Instance_t *SCH) {
+}
+
+void SCH_Fast_Update_In(SCH_Instance_t *SCH) {
+}
+
+SCH_Handle_t SCH_Add_Lane_Task_In(SCH_Instance_t *SCH, uint8_t LANE, void (*pFunction)(), uint32_t DELAY, uint32_t PERIOD) {
+    if (LANE != SCH_LANE_FAST) {
+        return SCH_Add_Task_In(SCH, pFunction, DELAY, PERIOD);
+    }
+    SCH->error_code = ERROR_SCH_TOO_MANY_TASKS;
+    return SCH_INVALID_HANDLE;
+}
+
+#endif /* SCH_FAST_LANE */
@@ -0,0 +1,398 @@
+/*
+ * ============================================================================
+ * COOPERATIVE SCHEDULER - PIPELINE (CHUỖI STAGE TRONG CÙNG 1 TICK)
+ * ============================================================================
+ * Mô tả: Stage = hàm chạy NGAY SAU 1 task (hoặc 1 stage khác) mỗi lần
+ *        task đó chạy, trong cùng lần Dispatch - không phụ thuộc thứ tự
+ *        hàng đợi của backend. Dùng chung cho mọi backend.
+ *
+ * VÍ DỤ: FSM → Display
+ *   SCH_Set_Task_Output(fsm_id, &view);            // FSM ghi bản chụp view
+ *   SCH_Add_Stage(Stage_Update_Display, fsm_id, 0); // Display(IN = &view, 0)
+ *   → tick nào FSM chạy, Display chạy ngay sau, với view của đúng tick đó
+ *
+ * THỨ TỰ CHẠY (SCH_Pipeline_Run, gọi từ SCH_Run_Task):
+ * - Theo độ sâu: mọi stage sau task (sâu 1), rồi các stage sau chúng
+ *   (sâu 2), ... - stage luôn chạy sau predecessor của nó
+ * - Cùng độ sâu: theo thứ tự ô trong bảng
+ * - Stage chỉ chạy nếu predecessor của nó đã chạy trong lượt này
+ *
+ * DỮ LIỆU: stage được gọi với IN = OUT của predecessor (task: OUT đặt
+ *   bằng SCH_Set_Task_Output, không có → 0) và ghi OUT của chính nó
+ *   → mỗi stage chỉ đọc bản chụp của stage trước, không đọc biến toàn cục
+ *
+ * BẢNG RIÊNG:
+ * - SCH_PIPE_MAX_STAGES ô stage + SCH_PIPE_MAX_STAGES ô OUT của task
+ *   (task không có stage thì OUT cũng không dùng)
+ * - Handle stage có bit SCH_STAGE_HANDLE_BIT trong phần slot
+ *   → SCH_Delete_Task của backend chuyển sang SCH_Stage_Delete
+ * - Xóa stage → xóa luôn các stage sau nó
+ * - Task bị xóa → stage của nó không còn chạy (handle task khác),
+ *   ô được thu hồi ở lần SCH_Add_Stage / SCH_Set_Task_Output sau
+ *
+ * LỚP (SCH_PRIORITY): stage chạy khi task chạy, không có thứ tự riêng.
+ *   SCH_Set_Task_Class(stage, lớp) chỉ dùng cho giảm tải (SCH_SHED):
+ *   lớp thấp hơn lớp của task → stage bị giảm tải riêng như 1 task lớp
+ *   đó (bỏ stage → các stage sau nó cũng không chạy lượt này)
+ *   Mặc định CRITICAL → chạy mỗi lần task chạy
+ *
+ * VÍ DỤ: FSM (CRITICAL) → Display (BACKGROUND), quá tải mức STRETCH
+ *   → FSM vẫn chạy mỗi tick, Display chạy 1 lần trong SCH_SHED_FACTOR
+ *
+ * GIỚI HẠN:
+ * - Stage không có profile / trace riêng: thời gian của cả chuỗi tính
+ *   cho task (profile, tải CPU, WCET của admission)
+ * - Task làn nhanh không có stage
+ * ============================================================================
+ */
+
+#include "scheduler.h"
+#include "scheduler_internal.h"
+
+#if SCH_PIPELINE
+
+#if SCH_MAX_TASKS > SCH_STAGE_HANDLE_BIT
+#error "SCH_PIPELINE needs SCH_MAX_TASKS <= 0x4000 (bit 14 marks stage handles)"
+#endif
+
+#if SCH_PIPE_MAX_STAGES > 32
+#error "SCH_PIPE_MAX_STAGES must be 32 or less (one bit per stage while a pipeline runs)"
+#endif
+
+/* ==================== BIẾN NỘI BỘ ==================== */
+
+// Predecessor của stage là chính task (không phải 1 stage)
+#define PIPE_FROM_TASK          0xFFu
+
+// Nằm trong SCH_Instance_t:
+// - SCH->pipe_stages[]: các ô stage (sch_stage_t); ô trống: pStage = 0
+// - SCH->pipe_outs[]: OUT của các task đầu chuỗi (SCH_Set_Task_Output);
+//   ô trống: Head = 0
+// - SCH->pipe_count / pipe_depth: số ô stage đang dùng, độ sâu lớn nhất từng có
+
+/* ==================== HÀM PRIVATE ==================== */
+
+#if SCH_PRIORITY
+/**
+ * ============================================================================
+ * HÀM: pipe_shed (PRIVATE)
+ * ============================================================================
+ * MÔ TẢ: Có bỏ stage lượt này không - chỉ khi lớp của stage thấp hơn
+ *        lớp của task HEAD_CLASS (cùng lớp: task đã được giảm tải rồi)
+ * ============================================================================
+ */
+static uint8_t pipe_shed(SCH_Instance_t *SCH, sch_stage_t *s, uint8_t HEAD_CLASS) {
+#if SCH_SHED
+    if (s->Class > HEAD_CLASS) {
+        return SCH_Shed_Drop(SCH, s->Class, &s->Shed_Count);
+    }
+#endif
+    return 0;
+}
+#endif
+
+/**
+ * ============================================================================
+ * HÀM: pipe_lookup (PRIVATE)
+ * ============================================================================
+ * MÔ TẢ: Kiểm tra handle stage và trả về ô - O(1)
+ * TRẢ VỀ: Ô, hoặc SCH_PIPE_MAX_STAGES nếu handle sai / stage đã bị xóa
+ * ============================================================================
+ */
+static uint32_t pipe_lookup(SCH_Instance_t *SCH, SCH_Handle_t handle) {
+    uint32_t i = SCH_HANDLE_SLOT(handle) & ~SCH_STAGE_HANDLE_BIT;
+
+    if (!SCH_STAGE_HANDLE(handle) || i >= SCH_PIPE_MAX_STAGES) {
+        return SCH_PIPE_MAX_STAGES;
+    }
+    if (SCH->pipe_stages[i].pStage == 0x0000 || SCH->pipe_stages[i].Gen != SCH_HANDLE_GEN(handle)) {
+        return SCH_PIPE_MAX_STAGES;
+    }
+    return i;
+}
+
+/**
+ * ============================================================================
+ * HÀM: pipe_kill (PRIVATE)
+ * ============================================================================
+ * MÔ TẢ: Xóa stage ở ô i và mọi stage sau nó - O(n²), n <= 32
+ *        Stage sau luôn sâu hơn → 1 lượt theo độ sâu là đủ
+ * ============================================================================
+ */
+static void pipe_kill(SCH_Instance_t *SCH, uint32_t i) {
+    uint32_t dead = 1u << i;
+
+    SCH->pipe_stages[i].pStage = 0x0000;
+    SCH->pipe_count--;
+
+    for (uint32_t d = SCH->pipe_stages[i].Depth + 1u; d <= SCH->pipe_depth; d++) {
+        for (uint32_t j = 0; j < SCH_PIPE_MAX_STAGES; j++) {
+            sch_stage_t *s = &SCH->pipe_stages[j];
+            if (s->pStage == 0x0000 || s->Depth != d || s->Pred == PIPE_FROM_TASK) continue;
+            if (dead & (1u << s->Pred)) {
+                s->pStage = 0x0000;
+                SCH->pipe_count--;
+                dead |= 1u << j;
+            }
+        }
+    }
+}
+
+/**
+ * ============================================================================
+ * HÀM: pipe_reclaim (PRIVATE)
+ * ============================================================================
+ * MÔ TẢ: Thu hồi ô stage / ô OUT của các task đã bị xóa - O(n)
+ *        (gọi trước khi cần ô trống, không tốn gì lúc Dispatch)
+ * ============================================================================
+ */
+static void pipe_reclaim(SCH_Instance_t *SCH) {
+    for (uint32_t i = 0; i < SCH_PIPE_MAX_STAGES; i++) {
+        if (SCH->pipe_stages[i].pStage != 0x0000 && SCH->pipe_stages[i].Pred == PIPE_FROM_TASK &&
+            SCH_Handle_To_Slot(SCH, SCH->pipe_stages[i].Head) == SCH_NO_SLOT) {
+            pipe_kill(SCH, i);
+        }
+        if (SCH->pipe_outs[i].Head != SCH_INVALID_HANDLE &&
+            SCH_Handle_To_Slot(SCH, SCH->pipe_outs[i].Head) == SCH_NO_SLOT) {
+            SCH->pipe_outs[i].Head = SCH_INVALID_HANDLE;
+        }
+    }
+}
+
+/* ==================== IMPLEMENTATION ==================== */
+
+/**
+ * ============================================================================
+ * HÀM: SCH_Pipe_Init (INTERNAL)
+ * ============================================================================
+ * MÔ TẢ: Xóa mọi stage và OUT - gọi trong SCH_Init
+ *        Gen được giữ → handle stage cấp trước SCH_Init vẫn bị từ chối
+ * ============================================================================
+ */
+void SCH_Pipe_Init(SCH_Instance_t *SCH) {
+    for (uint32_t i = 0; i < SCH_PIPE_MAX_STAGES; i++) {
+        SCH->pipe_stages[i].pStage = 0x0000;
+        SCH->pipe_outs[i].Head = SCH_INVALID_HANDLE;
+    }
+    SCH->pipe_count = 0;
+    SCH->pipe_depth = 0;
+}
+
+/**
+ * ============================================================================
+ * HÀM: SCH_Pipeline_Run (INTERNAL)
+ * ============================================================================
+ * MÔ TẢ: Chạy các stage sau task HEAD vừa chạy - gọi trong SCH_Run_Task
+ *        Không có stage nào → trả về ngay
+ *
+ * VÍ DỤ: FSM → Display → Log (Log sau Display)
+ *   sâu 1: Display(IN = OUT của FSM, OUT = d)
+ *   sâu 2: Log(IN = d, ...)
+ *
+ * LƯU Ý: Stage thêm trong lúc chuỗi đang chạy có thể chạy ngay lượt này
+ *        (nếu predecessor của nó đã chạy); stage bị xóa thì không chạy
+ *        Stage bị giảm tải (pipe_shed) → như chưa chạy
+ * ============================================================================
+ */
+void SCH_Pipeline_Run(SCH_Instance_t *SCH, SCH_Handle_t HEAD) {
+    if (SCH->pipe_count == 0) {
+        return;
+    }
+
+    void *head_out = 0;
+    for (uint32_t i = 0; i < SCH_PIPE_MAX_STAGES; i++) {
+        if (SCH->pipe_outs[i].Head == HEAD) {
+            head_out = SCH->pipe_outs[i].Out;
+            break;
+        }
+    }
+
+#if SCH_PRIORITY
+    sch_index_t slot = SCH_Handle_To_Slot(SCH, HEAD);
+    uint8_t head_class = (slot != SCH_NO_SLOT) ? SCH_Task_Class(SCH, slot) : SCH_CLASS_CRITICAL;
+#endif
+
+    uint32_t ran = 0;
+    for (uint32_t d = 1; d <= SCH->pipe_depth; d++) {
+        for (uint32_t i = 0; i < SCH_PIPE_MAX_STAGES; i++) {
+            sch_stage_t *s = &SCH->pipe_stages[i];
+            if (s->pStage == 0x0000 || s->Head != HEAD || s->Depth != d) continue;
+
+            const void *in;
+            if (s->Pred == PIPE_FROM_TASK) {
+                in = head_out;
+            } else if (ran & (1u << s->Pred)) {
+                in = SCH->pipe_stages[s->Pred].Out;
+            } else {
+                continue;
+            }
+#if SCH_PRIORITY
+            if (pipe_shed(SCH, s, head_class)) {
+                continue;
+            }
+#endif
+            ran |= 1u << i;
+            (*s->pStage)(in, s->Out);
+        }
+    }
+}
+
+/**
+ * ============================================================================
+ * HÀM: SCH_Add_Stage_In
+ * ============================================================================
+ * MÔ TẢ: Thêm STAGE chạy ngay sau PREDECESSOR (task làn tick hoặc stage)
+ *
+ * VÍ DỤ:
+ *   SCH_Handle_t fsm = SCH_Add_Task(Task_Traffic_FSM, 0, 1);
+ *   SCH_Set_Task_Output(fsm, &traffic_view);
+ *   SCH_Add_Stage(Stage_Update_Display, fsm, 0);
+ *
+ * TRẢ VỀ: Handle stage, SCH_INVALID_HANDLE nếu lỗi
+ *         (predecessor sai / đã xóa: ERROR_SCH_BAD_PREDECESSOR,
+ *          hết ô: ERROR_SCH_TOO_MANY_TASKS)
+ * ============================================================================
+ */
+SCH_Handle_t SCH_Add_Stage_In(SCH_Instance_t *SCH, SCH_Stage_t STAGE, SCH_Handle_t PREDECESSOR, void *OUT) {
+    SCH_Handle_t head;
+    uint8_t pred;
+    uint8_t depth;
+
+    if (STAGE == 0x0000) {
+        return SCH_INVALID_HANDLE;
+    }
+
+    uint32_t p = pipe_lookup(SCH, PREDECESSOR);
+    if (p < SCH_PIPE_MAX_STAGES) {
+        head = SCH->pipe_stages[p].Head;
+        pred = (uint8_t)p;
+        depth = (uint8_t)(SCH->pipe_stages[p].Depth + 1u);
+    } else if (SCH_Handle_To_Slot(SCH, PREDECESSOR) != SCH_NO_SLOT) {
+        head = PREDECESSOR;
+        pred = PIPE_FROM_TASK;
+        depth = 1;
+    } else {
+        SCH->error_code = ERROR_SCH_BAD_PREDECESSOR;
+        return SCH_INVALID_HANDLE;
+    }
+
+    pipe_reclaim(SCH);
+    if (pred != PIPE_FROM_TASK && SCH->pipe_stages[pred].pStage == 0x0000) {
+        SCH->error_code = ERROR_SCH_BAD_PREDECESSOR; // Task đầu chuỗi đã bị xóa
+        return SCH_INVALID_HANDLE;
+    }
+
+    for (uint32_t i = 0; i < SCH_PIPE_MAX_STAGES; i++) {
+        sch_stage_t *s = &SCH->pipe_stages[i];
+        if (s->pStage != 0x0000) {
+            continue;
+        }
+        s->pStage = STAGE;
+        s->Out = OUT;
+        s->Head = head;
+        s->Pred = pred;
+        s->Depth = depth;
+#if SCH_PRIORITY
+        s->Class = SCH_CLASS_CRITICAL;
+        s->Shed_Count = 0;
+#endif
+        s->Gen++;
+        SCH->pipe_count++;
+        if (depth > SCH->pipe_depth) SCH->pipe_depth = depth;
+        return ((uint32_t)s->Gen << 16) | SCH_STAGE_HANDLE_BIT | i;
+    }
+
+    SCH->error_code = ERROR_SCH_TOO_MANY_TASKS;
+    return SCH_INVALID_HANDLE;
+}
+
+/**
+ * ============================================================================
+ * HÀM: SCH_Set_Task_Output_In
+ * ============================================================================
+ * MÔ TẢ: Đặt bản chụp OUT mà task ghi mỗi lần chạy - các stage ngay sau
+ *        task nhận nó làm IN. Gọi lại → thay OUT, OUT = 0 → bỏ
+ *
+ * TRẢ VỀ: RETURN_NORMAL, RETURN_ERROR nếu handle sai / hết ô
+ * ============================================================================
+ */
+uint8_t SCH_Set_Task_Output_In(SCH_Instance_t *SCH, const SCH_Handle_t TASK_HANDLE, void *OUT) {
+    if (SCH_Handle_To_Slot(SCH, TASK_HANDLE) == SCH_NO_SLOT) {
+        SCH->error_code = ERROR_SCH_CANNOT_DELETE_TASK;
+        return RETURN_ERROR;
+    }
+
+    pipe_reclaim(SCH);
+    sch_pipe_out_t *free_out = 0;
+    for (uint32_t i = 0; i < SCH_PIPE_MAX_STAGES; i++) {
+        if (SCH->pipe_outs[i].Head == TASK_HANDLE) {
+            free_out = &SCH->pipe_outs[i];
+            break;
+        }
+        if (free_out == 0 && SCH->pipe_outs[i].Head == SCH_INVALID_HANDLE) {
+            free_out = &SCH->pipe_outs[i];
+        }
+    }
+
+    if (OUT == 0) {
+        if (free_out != 0 && free_out->Head == TASK_HANDLE) {
+            free_out->Head = SCH_INVALID_HANDLE;
+        }
+        return RETURN_NORMAL;
+    }
+    if (free_out == 0) {
+        SCH->error_code = ERROR_SCH_TOO_MANY_TASKS;
+        return RETURN_ERROR;
+    }
+    free_out->Head = TASK_HANDLE;
+    free_out->Out = OUT;
+    return RETURN_NORMAL;
+}
+
+/**
+ * ============================================================================
+ * HÀM: SCH_Stage_Delete (INTERNAL)
+ * ============================================================================
+ * MÔ TẢ: SCH_Delete_Task của backend chuyển handle stage
+ *        (SCH_STAGE_HANDLE) sang đây - xóa stage và các stage sau nó
+ * ============================================================================
+ */
+uint8_t SCH_Stage_Delete(SCH_Instance_t *SCH, SCH_Handle_t TASK_HANDLE) {
+    uint32_t i = pipe_lookup(SCH, TASK_HANDLE);
+    if (i >= SCH_PIPE_MAX_STAGES) {
+        SCH->error_code = ERROR_SCH_CANNOT_DELETE_TASK;
+        return RETURN_ERROR;
+    }
+    pipe_kill(SCH, i);
+    return RETURN_NORMAL;
+}
+
+#if SCH_PRIORITY
+/**
+ * ============================================================================
+ * HÀM: SCH_Stage_Set_Class (INTERNAL)
+ * ============================================================================
+ * MÔ TẢ: SCH_Set_Task_Class của handle stage - đặt lớp giảm tải
+ *
+ * VÍ DỤ - Display không được giữ theo lớp CRITICAL của FSM:
+ *   SCH_Set_Task_Class(SCH_Add_Stage(Stage_Update_Display, fsm, 0),
+ *                      SCH_CLASS_BACKGROUND);
+ * ============================================================================
+ */
+uint8_t SCH_Stage_Set_Class(SCH_Instance_t *SCH, SCH_Handle_t TASK_HANDLE, uint8_t CLASS) {
+    uint32_t i = pipe_lookup(SCH, TASK_HANDLE);
+    if (i >= SCH_PIPE_MAX_STAGES || CLASS >= SCH_CLASSES) {
+        return RETURN_ERROR;
+    }
+    SCH->pipe_stages[i].Class = CLASS;
+    SCH->pipe_stages[i].Shed_Count = 0;
+    return RETURN_NORMAL;
+}
+#endif
+
+#else
+
+void SCH_Pipe_Init(SCH_Instance_t *SCH) {
+}
+
+#endif /* SCH_PIPELINE */
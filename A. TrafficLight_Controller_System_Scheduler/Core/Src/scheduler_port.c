@@ -0,0 +1,266 @@
+/*
+ * ============================================================================
+ * COOPERATIVE SCHEDULER - PHẦN PHỤ THUỘC PHẦN CỨNG (PORT)
+ * ============================================================================
+ * Mô tả: Các hàm của scheduler đụng tới phần cứng (TIM2, WFI, SysTick)
+ *        Dùng chung cho cả 2 backend (scheduler.c, scheduler_wheel.c)
+ *
+ * TICKLESS IDLE (SCH_TICKLESS = 1):
+ * - Không có task nào đến giờ → kéo dài chu kỳ TIM2 tới deadline kế tiếp
+ * - Tắt SysTick, vào WFI → MCU ngủ suốt khoảng thời gian rảnh
+ * - Thức dậy → bù các tick đã ngủ qua (SCH_Skip_Ticks), trả TIM2 về 10ms
+ * → Số lần ngắt/thức giảm từ 1 lần/tick xuống 1 lần/deadline
+ *
+ * PROFILER (SCH_PROFILE = 1):
+ * - Bộ đếm chu kỳ DWT CYCCNT của Cortex-M3 (target)
+ * - Đồng hồ monotonic của hệ điều hành, đơn vị ns (host)
+ *
+ * HOST SIMULATION (SCH_HOST_SIM):
+ * - Không có phần cứng: SCH_Go_To_Sleep() tự "chạy" đồng hồ giả lập
+ *   (gọi SCH_Skip_Ticks + SCH_Update) và đếm số lần thức / số tick rảnh
+ * - Dùng để đo mức tiết kiệm trên máy tính, so sánh SCH_TICKLESS = 0 / 1
+ * ============================================================================
+ */
+
+#include "scheduler.h"
+#include "scheduler_internal.h"
+
+#ifdef SCH_HOST_SIM
+#include <time.h>
+#endif
+
+/* ==================== BIẾN NỘI BỘ ==================== */
+
+// Thống kê ngủ: SCH->idle_stats của từng instance (đọc qua SCH_Get_Idle_Stats)
+
+#ifndef SCH_HOST_SIM
+// Timer tạo tick cho scheduler (khai báo trong main.c)
+extern TIM_HandleTypeDef htim2;
+#endif
+
+/* ==================== HÀM PRIVATE (INTERNAL) ==================== */
+
+/**
+ * ============================================================================
+ * HÀM: SCH_Count_Sleep (PRIVATE)
+ * ============================================================================
+ * MÔ TẢ: Ghi nhận 1 lần thức dậy sau khi ngủ TICKS tick
+ * ============================================================================
+ */
+static void SCH_Count_Sleep(SCH_Instance_t *SCH, uint32_t TICKS) {
+    SCH->idle_stats.Wakeups++;
+    SCH->idle_stats.Idle_Ticks += TICKS;
+    if (TICKS > SCH->idle_stats.Longest_Sleep) {
+        SCH->idle_stats.Longest_Sleep = TICKS;
+    }
+}
+
+/* ==================== IMPLEMENTATION ==================== */
+
+/**
+ * ============================================================================
+ * HÀM: SCH_Cycle_Counter_Init / SCH_Cycles_Now (INTERNAL - PROFILER)
+ * ============================================================================
+ * MÔ TẢ:
+ *   - Target: bật khối trace (DEMCR.TRCENA) rồi bật DWT CYCCNT
+ *             → đếm mỗi chu kỳ CPU, tràn sau 2^32 chu kỳ (~9 phút ở 8MHz)
+ *   - Host:   đọc CLOCK_MONOTONIC, lấy 32 bit thấp của số ns
+ *   Cả 2 đều tràn → chỉ dùng hiệu 2 lần đọc (phép trừ uint32_t vẫn đúng)
+ * ============================================================================
+ */
+void SCH_Cycle_Counter_Init(void) {
+#ifndef SCH_HOST_SIM
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+#endif
+}
+
+uint32_t SCH_Cycles_Now(void) {
+#ifdef SCH_HOST_SIM
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32_t)((uint64_t)ts.tv_sec * 1000000000uLL + (uint64_t)ts.tv_nsec);
+#else
+    return DWT->CYCCNT;
+#endif
+}
+
+#ifdef SCH_HOST_SIM
+
+/**
+ * ============================================================================
+ * HÀM: SCH_Go_To_Sleep_In (HOST SIMULATION)
+ * ============================================================================
+ * MÔ TẢ: "Ngủ" tới deadline kế tiếp bằng cách tự chạy đồng hồ giả lập
+ *   - SCH_TICKLESS = 1: nhảy thẳng tới deadline → 1 lần thức
+ *   - SCH_TICKLESS = 0: chỉ 1 tick → 1 lần thức mỗi tick
+ *
+ * VÍ DỤ (vòng lặp giả lập, thời gian chỉ trôi khi ngủ):
+ *   while (sim_ticks < 100000) {
+ *       SCH_Dispatch_Tasks();
+ *       SCH_Go_To_Sleep();
+ *   }
+ *   SCH_Get_Idle_Stats(&stats);   // stats.Wakeups, stats.Idle_Ticks
+ * ============================================================================
+ */
+void SCH_Go_To_Sleep_In(SCH_Instance_t *SCH) {
+    uint32_t ticks = SCH_Commands_Pending(SCH) ? 0 : SCH_Idle_Ticks(SCH);
+
+    if (ticks == 0) {
+        return;     // Có task / lệnh từ ngắt đang chờ → không ngủ
+    }
+
+#if SCH_TICKLESS
+    if (ticks > SCH_TICKLESS_MAX_TICKS) {
+        ticks = SCH_TICKLESS_MAX_TICKS;
+    }
+#else
+    ticks = 1;
+#endif
+
+    // Các tick ngủ qua + tick cuối đánh thức MCU (ngắt TIM2)
+    SCH_Skip_Ticks(SCH, ticks - 1u);
+    SCH_Update_In(SCH);
+
+    SCH_Count_Sleep(SCH, ticks);
+}
+
+#else /* SCH_HOST_SIM */
+
+/**
+ * ============================================================================
+ * HÀM: SCH_Go_To_Sleep_In
+ * ============================================================================
+ * MÔ TẢ: Đưa MCU vào chế độ SLEEP cho tới deadline kế tiếp
+ *
+ * CÁCH HOẠT ĐỘNG (SCH_TICKLESS = 1), với ticks = số tick rảnh:
+ *   1. Tắt ngắt, hỏi backend còn bao nhiêu tick rảnh
+ *      (0 hoặc còn lệnh từ ngắt chưa xử lý → không ngủ)
+ *      Cờ update của TIM2 đã bật (tràn sau khi tắt ngắt, tick_now chưa
+ *      tăng) → không ngủ: ngắt TIM2 đang chờ chạy ngay khi bật lại ngắt.
+ *      Nếu ngủ, WFI trả về ngay và bước 4 tưởng đã ngủ đủ → bù thừa
+ *      tới (ticks - 1) tick chưa hề trôi qua
+ *   2. ticks > 1: ARR = ticks * (Period + 1) - 1
+ *      → TIM2 đếm tiếp từ giá trị hiện tại, ngắt đúng lúc deadline
+ *   3. Tắt SysTick, WFI (ngắt đang tắt vẫn đánh thức được MCU)
+ *   4. Thức dậy:
+ *      - Cờ update của TIM2 đã bật → ngủ đủ: bù (ticks - 1) tick,
+ *        tick cuối do ngắt TIM2 gọi SCH_Update() như bình thường
+ *      - Chưa bật → bị ngắt khác đánh thức sớm: bù số tick đã trọn vẹn,
+ *        giữ phần lẻ trong CNT
+ *   5. Trả ARR về 1 tick, bù uwTick cho HAL, bật SysTick và ngắt
+ *   Còn task làn nhanh (SCH_FAST_LANE): không kéo dài TIM2, không tắt
+ *   SysTick → ngủ tới ngắt kế tiếp (SysTick, <= 1ms), không đếm tick rảnh
+ *
+ * VÍ DỤ (Period = 9 → 10 count/tick), task kế tiếp sau 30 tick:
+ *   ARR = 299 → ngủ 300ms, thức 1 lần thay vì 30 lần ngắt TIM2
+ *   (và 300 lần ngắt SysTick)
+ *
+ * GỌI TỪ ĐÂU:
+ *   while (1) {
+ *       SCH_Dispatch_Tasks();
+ *       SCH_Go_To_Sleep();     // ← Gọi ở đây
+ *   }
+ * ============================================================================
+ */
+void SCH_Go_To_Sleep_In(SCH_Instance_t *SCH) {
+    __disable_irq();
+
+    if (__HAL_TIM_GET_FLAG(&htim2, TIM_FLAG_UPDATE)) {
+        __enable_irq();
+        return;     // Tick đã tràn nhưng SCH_Update() chưa chạy → không ngủ
+    }
+
+    uint32_t ticks = SCH_Commands_Pending(SCH) ? 0 : SCH_Idle_Ticks(SCH);
+#if SCH_FAST_LANE
+    // Còn task làn nhanh → SysTick phải chạy, chỉ ngủ tới ngắt kế tiếp (<= 1ms)
+    uint8_t fast = SCH_Fast_Active(SCH);
+    if (SCH_Fast_Pending(SCH)) ticks = 0;
+#else
+    uint8_t fast = 0;
+#endif
+    if (ticks == 0) {
+        __enable_irq();
+        return;     // Có task / lệnh từ ngắt đang chờ → không ngủ
+    }
+
+#if SCH_TICKLESS
+    uint32_t counts = __HAL_TIM_GET_AUTORELOAD(&htim2) + 1u;   // Count mỗi tick
+    uint32_t max_ticks = 0x10000uL / counts;                    // ARR 16-bit
+
+    if (max_ticks > SCH_TICKLESS_MAX_TICKS) max_ticks = SCH_TICKLESS_MAX_TICKS;
+    if (fast) max_ticks = 1;
+    if (ticks > max_ticks) ticks = max_ticks;
+
+    if (ticks > 1) {
+        // TIM2 đang ở giữa tick hiện tại → chỉ kéo dài điểm tràn
+        __HAL_TIM_SET_AUTORELOAD(&htim2, ticks * counts - 1u);
+
+        // Tràn ngay trước khi ARR đổi → trả ARR về 1 tick, không ngủ
+        if (__HAL_TIM_GET_FLAG(&htim2, TIM_FLAG_UPDATE)) {
+            __HAL_TIM_SET_AUTORELOAD(&htim2, counts - 1u);
+            __enable_irq();
+            return;
+        }
+    }
+#else
+    ticks = 1;
+#endif
+
+    if (!fast) HAL_SuspendTick();
+    __DSB();
+    __WFI();
+    if (!fast) HAL_ResumeTick();
+
+#if SCH_TICKLESS
+    uint32_t slept = ticks;
+
+    if (ticks > 1) {
+        uint32_t cnt = __HAL_TIM_GET_COUNTER(&htim2);
+        // Ngủ đủ: bù (ticks - 1), ngắt TIM2 đang chờ sẽ gọi SCH_Update() cho tick cuối
+        uint32_t skipped = ticks - 1u;
+
+        if (!__HAL_TIM_GET_FLAG(&htim2, TIM_FLAG_UPDATE)) {
+            // Thức sớm: chỉ bù các tick trọn vẹn, phần lẻ giữ lại trong CNT
+            skipped = cnt / counts;
+            slept = skipped;
+            __HAL_TIM_SET_COUNTER(&htim2, cnt % counts);
+        }
+        SCH_Skip_Ticks(SCH, skipped);
+        __HAL_TIM_SET_AUTORELOAD(&htim2, counts - 1u);
+
+        // SysTick bị tắt lúc ngủ → bù cho HAL_GetTick()
+        uwTick += skipped * TIMER_TICK_MS;
+    }
+#else
+    uint32_t slept = 1;
+#endif
+
+    // Làn nhanh: SysTick đánh thức mỗi 1ms, không phải mỗi tick
+    if (fast) slept = 0;
+
+    SCH_Count_Sleep(SCH, slept);
+
+    __enable_irq();
+}
+
+#endif /* SCH_HOST_SIM */
+
+/**
+ * ============================================================================
+ * HÀM: SCH_Get_Idle_Stats_In
+ * ============================================================================
+ * MÔ TẢ: Sao chép thống kê ngủ
+ *
+ * VÍ DỤ - Tỉ lệ thời gian rảnh và số lần thức trung bình:
+ *   SCH_Idle_Stats_t s;
+ *   SCH_Get_Idle_Stats(&s);
+ *   // s.Idle_Ticks / tổng số tick → % thời gian ngủ
+ *   // s.Idle_Ticks / s.Wakeups   → số tick trung bình mỗi lần ngủ
+ * ============================================================================
+ */
+void SCH_Get_Idle_Stats_In(SCH_Instance_t *SCH, SCH_Idle_Stats_t *STATS) {
+    if (STATS == 0x0000) return;
+    *STATS = SCH->idle_stats;
+}
@@ -0,0 +1,129 @@
+/*
+ * ============================================================================
+ * COOPERATIVE SCHEDULER - BỘ GHI TRACE (RING BUFFER NHỊ PHÂN)
+ * ============================================================================
+ * Mô tả: Ghi lại scheduler đã làm gì, theo thời gian, vào 1 vòng đệm RAM
+ *        cố định (SCH_trace_G) - dùng chung cho mọi backend
+ *
+ * SỰ KIỆN (mỗi bản ghi 8 byte: thời điểm, loại, 2 trường dữ liệu):
+ *   TICK            SCH_Update()                      Data = tick
+ *   DISPATCH_BEGIN  / DISPATCH_END  SCH_Dispatch_Tasks()
+ *   TASK_BEGIN      / TASK_END      mỗi lần chạy task  Data = slot, Value = RunMe
+ *   ISR_BEGIN       / ISR_END       SCH_TRACE_ISR_ENTER/EXIT  Data = IRQn
+ *   ERROR           Error_code_G thay đổi              Value = mã lỗi mới
+ *
+ * ĐỌC TRACE:
+ * - Trên máy: SCH_Trace_Read() (cũ nhất trước)
+ * - Máy đang chạy ngoài hiện trường: dừng bằng debugger, dump nguyên
+ *   biến SCH_trace_G (header + bản ghi), trên PC:
+ *     (gdb) dump binary value trace.bin SCH_trace_G
+ *     $ Host/sch_trace trace.bin > trace.json
+ *   rồi mở trace.json bằng chrome://tracing hoặc ui.perfetto.dev
+ *
+ * CHI PHÍ: đọc DWT CYCCNT + 2 lệnh ghi, ngắt bị chặn trong lúc ghi
+ *          (ISR và Dispatch cùng ghi vào 1 vòng đệm)
+ * ============================================================================
+ */
+
+#include "scheduler.h"
+#include "scheduler_internal.h"
+
+#if SCH_TRACE
+
+#if (SCH_TRACE_SIZE & (SCH_TRACE_SIZE - 1)) != 0 || SCH_TRACE_SIZE > 0xFFFF
+#error "SCH_TRACE_SIZE must be a power of 2 below 65536"
+#endif
+
+/* ==================== BIẾN TOÀN CỤC ==================== */
+
+// Vòng đệm trace: header cố định + SCH_TRACE_SIZE bản ghi
+// Bản ghi thứ n (tính từ SCH_Init đầu tiên) nằm ở Records[n % SCH_TRACE_SIZE]
+SCH_Trace_Buffer_t SCH_trace_G;
+
+/* ==================== IMPLEMENTATION ==================== */
+
+/**
+ * ============================================================================
+ * HÀM: SCH_Trace_Init (INTERNAL)
+ * ============================================================================
+ * MÔ TẢ: Làm rỗng vòng đệm, ghi header để bản dump tự mô tả được
+ *        (đơn vị thời gian, kích thước) - gọi 1 lần, ở SCH_Init_In
+ *        đầu tiên (trace dùng chung mọi instance)
+ * ============================================================================
+ */
+void SCH_Trace_Init(void) {
+    SCH_trace_G.Magic = SCH_TRACE_MAGIC;
+    SCH_trace_G.Clock_Hz = SCH_CYCLES_PER_SECOND;
+    SCH_trace_G.Count = 0;
+    SCH_trace_G.Size = SCH_TRACE_SIZE;
+    SCH_trace_G.Tick_Ms = TIMER_TICK_MS;
+}
+
+/**
+ * ============================================================================
+ * HÀM: SCH_Trace_Event
+ * ============================================================================
+ * MÔ TẢ: Ghi 1 bản ghi, đè lên bản ghi cũ nhất khi đầy - O(1)
+ *        Gọi được trong ngắt: chặn ngắt (lưu/khôi phục PRIMASK) trong
+ *        lúc lấy chỗ và ghi → thứ tự bản ghi = thứ tự thời gian
+ *
+ * VÍ DỤ - Đánh dấu của ứng dụng (Event >= 16):
+ *   SCH_Trace_Event(16, new_state, 0);   // FSM đổi trạng thái
+ * ============================================================================
+ */
+void SCH_Trace_Event(uint8_t EVENT, uint16_t DATA, uint8_t VALUE) {
+#ifdef SCH_HOST_SIM
+    uint32_t n = __sync_fetch_and_add(&SCH_trace_G.Count, 1u);
+    SCH_Trace_Record_t *r = &SCH_trace_G.Records[n & (SCH_TRACE_SIZE - 1u)];
+
+    r->Time = SCH_Cycles_Now();
+    r->Data = DATA;
+    r->Event = EVENT;
+    r->Value = VALUE;
+#else
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+
+    SCH_Trace_Record_t *r = &SCH_trace_G.Records[SCH_trace_G.Count & (SCH_TRACE_SIZE - 1u)];
+    SCH_trace_G.Count++;
+    r->Time = DWT->CYCCNT;
+    r->Data = DATA;
+    r->Event = EVENT;
+    r->Value = VALUE;
+
+    __set_PRIMASK(primask);
+#endif
+}
+
+/**
+ * ============================================================================
+ * HÀM: SCH_Trace_Read
+ * ============================================================================
+ * MÔ TẢ: Sao chép tối đa MAX bản ghi GẦN NHẤT, cũ nhất trước
+ *        (vd. để gửi qua UART khi có lỗi)
+ *
+ * VÍ DỤ:
+ *   static SCH_Trace_Record_t recs[SCH_TRACE_SIZE];
+ *   uint32_t n = SCH_Trace_Read(recs, SCH_TRACE_SIZE);
+ *
+ * TRẢ VỀ: Số bản ghi đã sao chép
+ * ============================================================================
+ */
+uint32_t SCH_Trace_Read(SCH_Trace_Record_t *RECORDS, uint32_t MAX) {
+    uint32_t end = SCH_trace_G.Count;
+    uint32_t n = (end < SCH_TRACE_SIZE) ? end : SCH_TRACE_SIZE;
+
+    if (n > MAX) n = MAX;
+
+    for (uint32_t i = 0; i < n; i++) {
+        RECORDS[i] = SCH_trace_G.Records[(end - n + i) & (SCH_TRACE_SIZE - 1u)];
+    }
+    return n;
+}
+
+#else
+
+void SCH_Trace_Init(void) {
+}
+
+#endif /* SCH_TRACE */
@@ -0,0 +1,532 @@
+/*
+ * ============================================================================
+ * COOPERATIVE SCHEDULER - BACKEND TIMING WHEEL PHÂN CẤP
+ * ============================================================================
+ * Mô tả: Backend thay thế cho mảng sắp xếp, chọn bằng
+ *        #define SCH_BACKEND SCH_BACKEND_TIMING_WHEEL (scheduler.h)
+ *
+ * ƯU ĐIỂM:
+ * - SCH_Add_Task()    O(1): tính ô (slot) của wheel rồi nối vào danh sách
+ *                     (SCH_ADMISSION = 1: cộng thêm bước kiểm tra nhận task,
+ *                     O(siêu chu kỳ x n) - áp dụng cho cả Reschedule)
+ * - SCH_Delete_Task() O(1): gỡ khỏi danh sách liên kết đôi
+ * - Hết hạn           O(1) mỗi task (mỗi task cascade tối đa LEVELS-1 lần)
+ * - SCH_Update()      O(1): ISR CHỈ đếm tick, wheel được quay trong Dispatch
+ * - Reschedule qua handle O(1): gỡ khỏi ô cũ, đặt vào ô mới
+ *   (không tính bước kiểm tra nhận task, xem trên)
+ *
+ * CẤU TRÚC (mặc định 4 cấp x 64 ô):
+ *   Cấp 0: mỗi ô = 1 tick            → task hết hạn trong < 64 tick
+ *   Cấp 1: mỗi ô = 64 tick           → task hết hạn trong < 64^2 tick
+ *   Cấp 2: mỗi ô = 64^2 tick         → ...
+ *   Cấp 3: mỗi ô = 64^3 tick         → tối đa 2^24 tick (~46 giờ)
+ *
+ *   Khi ô cấp 0 quay về 0, ô tương ứng của cấp 1 được "cascade"
+ *   (phân phối lại xuống cấp thấp hơn) - giống timer wheel của Linux.
+ *
+ * LƯU Ý:
+ * - Bảng slot và handle dùng chung với mảng sắp xếp (scheduler.c)
+ * - Trong backend này, SCH_TASK_DELAY(i) lưu TICK HẾT HẠN TUYỆT ĐỐI
+ * ============================================================================
+ */
+
+#include "scheduler.h"
+#include "scheduler_internal.h"
+
+#if SCH_BACKEND == SCH_BACKEND_TIMING_WHEEL
+
+/* ==================== CẤU HÌNH NỘI BỘ ==================== */
+
+#define WHEEL_SLOTS         (1u << SCH_WHEEL_BITS)      // Số ô mỗi cấp
+#define WHEEL_MASK          (WHEEL_SLOTS - 1u)
+// Danh sách task đã đến giờ: SCH_PRIORITY → 1 danh sách cho mỗi lớp
+#if SCH_PRIORITY
+#define WHEEL_READY_LISTS   SCH_CLASSES
+#define WHEEL_READY_OF(idx) (WHEEL_READY_LIST + SCH_Task_Class(SCH, idx))
+#else
+#define WHEEL_READY_LISTS   1u
+#define WHEEL_READY_OF(idx) WHEEL_READY_LIST
+#endif
+#define WHEEL_LISTS         SCH_WHEEL_LISTS     // SCH_WHEEL_LEVELS * WHEEL_SLOTS + WHEEL_READY_LISTS
+#define WHEEL_READY_LIST    (SCH_WHEEL_LEVELS * WHEEL_SLOTS) // READY đầu tiên (lớp cao nhất)
+
+// Khoảng thời gian tối đa wheel biểu diễn được (không cần cascade lại)
+#define WHEEL_SPAN          (1uL << (SCH_WHEEL_BITS * SCH_WHEEL_LEVELS))
+
+// Kiểu index: dùng chung với bảng slot (1 byte nếu đủ, để tiết kiệm RAM)
+typedef sch_index_t wheel_idx_t;
+#define WHEEL_NIL           SCH_NO_SLOT
+
+typedef sch_wheel_list_t wheel_list_t;
+#define WHEEL_NO_LIST       ((wheel_list_t)~0u)
+
+/* ==================== BIẾN NỘI BỘ ==================== */
+
+// Nằm trong SCH_Instance_t:
+// - SCH->wheel_head[list]: đầu danh sách liên kết đôi VÒNG cho mỗi ô
+//   (tail = prev[head])
+// - SCH->wheel_next / wheel_prev[slot]: liên kết của từng slot task,
+//   SCH->wheel_list[slot]: task đang nằm trong danh sách nào
+// - SCH->wheel_next_tick: tick tiếp theo mà wheel cần xử lý
+// - SCH->done_ticks: đếm tick - ISR chỉ tăng tick_now, Dispatch tăng done_ticks
+//   → Không cần tắt ngắt, pending = tick_now - done_ticks (an toàn khi tràn)
+
+/* ==================== HÀM PRIVATE (INTERNAL) ==================== */
+static void wheel_list_append(SCH_Instance_t *SCH, wheel_list_t list, wheel_idx_t idx);
+static void wheel_list_remove(SCH_Instance_t *SCH, wheel_idx_t idx);
+static void wheel_place(SCH_Instance_t *SCH, wheel_idx_t idx);
+static void wheel_cascade(SCH_Instance_t *SCH, uint32_t level);
+static void wheel_advance(SCH_Instance_t *SCH);
+static wheel_idx_t wheel_ready_first(SCH_Instance_t *SCH);
+
+/**
+ * ============================================================================
+ * HÀM: wheel_list_append / wheel_list_remove (PRIVATE)
+ * ============================================================================
+ * MÔ TẢ: Thêm vào cuối / gỡ khỏi danh sách liên kết đôi vòng - O(1)
+ * ============================================================================
+ */
+static void wheel_list_append(SCH_Instance_t *SCH, wheel_list_t list, wheel_idx_t idx) {
+    wheel_idx_t head = SCH->wheel_head[list];
+
+    if (head == WHEEL_NIL) {
+        // Danh sách rỗng → task tự trỏ vào chính nó
+        SCH->wheel_next[idx] = idx;
+        SCH->wheel_prev[idx] = idx;
+        SCH->wheel_head[list] = idx;
+    } else {
+        // Chèn vào trước head (tức là cuối danh sách vòng)
+        wheel_idx_t tail = SCH->wheel_prev[head];
+        SCH->wheel_next[tail] = idx;
+        SCH->wheel_prev[idx] = tail;
+        SCH->wheel_next[idx] = head;
+        SCH->wheel_prev[head] = idx;
+    }
+    SCH->wheel_list[idx] = list;
+}
+
+static void wheel_list_remove(SCH_Instance_t *SCH, wheel_idx_t idx) {
+    wheel_list_t list = SCH->wheel_list[idx];
+    if (list == WHEEL_NO_LIST) return;
+
+    if (SCH->wheel_next[idx] == idx) {
+        // Task duy nhất trong danh sách
+        SCH->wheel_head[list] = WHEEL_NIL;
+    } else {
+        SCH->wheel_next[SCH->wheel_prev[idx]] = SCH->wheel_next[idx];
+        SCH->wheel_prev[SCH->wheel_next[idx]] = SCH->wheel_prev[idx];
+        if (SCH->wheel_head[list] == idx) {
+            SCH->wheel_head[list] = SCH->wheel_next[idx];
+        }
+    }
+    SCH->wheel_list[idx] = WHEEL_NO_LIST;
+}
+
+/**
+ * ============================================================================
+ * HÀM: wheel_place (PRIVATE)
+ * ============================================================================
+ * MÔ TẢ: Đặt task vào đúng ô theo tick hết hạn (SCH_TASK_DELAY(idx))
+ *
+ * VÍ DỤ (64 ô/cấp, wheel_next_tick = 100):
+ *   Hết hạn 130  → còn 30 tick    → cấp 0, ô 130 & 63 = 2
+ *   Hết hạn 1000 → còn 900 tick   → cấp 1, ô (1000 >> 6) & 63 = 15
+ * ============================================================================
+ */
+static void wheel_place(SCH_Instance_t *SCH, wheel_idx_t idx) {
+    uint32_t expire = SCH_TASK_DELAY(idx);
+    uint32_t remain = expire - SCH->wheel_next_tick;
+    uint32_t level = 0;
+
+    // Quá xa → đặt vào ô xa nhất, sẽ được cascade lại khi tới
+    if (remain >= WHEEL_SPAN) {
+        expire = SCH->wheel_next_tick + (uint32_t)(WHEEL_SPAN - 1u);
+        remain = (uint32_t)(WHEEL_SPAN - 1u);
+    }
+
+    // Tìm cấp nhỏ nhất chứa được khoảng thời gian còn lại
+    while (level < SCH_WHEEL_LEVELS - 1u &&
+           remain >= (1uL << (SCH_WHEEL_BITS * (level + 1u)))) {
+        level++;
+    }
+
+    uint32_t slot = (expire >> (SCH_WHEEL_BITS * level)) & WHEEL_MASK;
+    wheel_list_append(SCH, (wheel_list_t)(level * WHEEL_SLOTS + slot), idx);
+}
+
+/**
+ * ============================================================================
+ * HÀM: wheel_cascade (PRIVATE)
+ * ============================================================================
+ * MÔ TẢ: Phân phối lại các task trong ô hiện tại của cấp `level`
+ *        xuống các cấp thấp hơn (chúng đã gần đến hạn hơn)
+ * ============================================================================
+ */
+static void wheel_cascade(SCH_Instance_t *SCH, uint32_t level) {
+    uint32_t slot = (SCH->wheel_next_tick >> (SCH_WHEEL_BITS * level)) & WHEEL_MASK;
+    wheel_list_t list = (wheel_list_t)(level * WHEEL_SLOTS + slot);
+
+    while (SCH->wheel_head[list] != WHEEL_NIL) {
+        wheel_idx_t idx = SCH->wheel_head[list];
+        wheel_list_remove(SCH, idx);
+        wheel_place(SCH, idx);
+    }
+}
+
+/**
+ * ============================================================================
+ * HÀM: wheel_advance (PRIVATE)
+ * ============================================================================
+ * MÔ TẢ: Xử lý 1 tick: cascade nếu cần, rồi chuyển các task hết hạn
+ *        trong ô cấp 0 sang danh sách READY (RunMe++)
+ * ============================================================================
+ */
+static void wheel_advance(SCH_Instance_t *SCH) {
+    // Cascade: ô cấp 0 quay về 0 → kéo ô cấp 1 xuống, và cứ thế
+    uint32_t level = 1;
+    while (level < SCH_WHEEL_LEVELS &&
+           ((SCH->wheel_next_tick >> (SCH_WHEEL_BITS * (level - 1u))) & WHEEL_MASK) == 0) {
+        wheel_cascade(SCH, level);
+        level++;
+    }
+
+    // Các task trong ô hiện tại của cấp 0 → đến giờ chạy
+    wheel_list_t list = (wheel_list_t)(SCH->wheel_next_tick & WHEEL_MASK);
+    while (SCH->wheel_head[list] != WHEEL_NIL) {
+        wheel_idx_t idx = SCH->wheel_head[list];
+        wheel_list_remove(SCH, idx);
+        if (SCH_TASK_DELAY(idx) == SCH->wheel_next_tick) {
+            if (SCH_TASK_RUNME(idx) < 0xFFu) {
+                SCH_TASK_RUNME(idx)++;
+            } else {
+                SCH_RunMe_Saturated(SCH, idx);
+            }
+            wheel_list_append(SCH, WHEEL_READY_OF(idx), idx);
+        } else {
+            // Task bị kẹp (delay > WHEEL_SPAN) → đặt lại
+            wheel_place(SCH, idx);
+        }
+    }
+
+    SCH->wheel_next_tick++;
+}
+
+/**
+ * ============================================================================
+ * HÀM: wheel_ready_first (PRIVATE)
+ * ============================================================================
+ * MÔ TẢ: Task READY chạy kế tiếp: đầu danh sách READY của lớp cao nhất
+ *        còn task (không có SCH_PRIORITY: chỉ có 1 danh sách) - O(lớp)
+ *
+ * TRẢ VỀ: idx, hoặc WHEEL_NIL nếu không có task READY
+ * ============================================================================
+ */
+static wheel_idx_t wheel_ready_first(SCH_Instance_t *SCH) {
+    for (uint32_t c = 0; c < WHEEL_READY_LISTS; c++) {
+        if (SCH->wheel_head[WHEEL_READY_LIST + c] != WHEEL_NIL) {
+            return SCH->wheel_head[WHEEL_READY_LIST + c];
+        }
+    }
+    return WHEEL_NIL;
+}
+
+#if SCH_PRIORITY
+/**
+ * ============================================================================
+ * HÀM: SCH_Class_Changed (INTERNAL)
+ * ============================================================================
+ * MÔ TẢ: Task đang READY → chuyển sang danh sách READY của lớp mới
+ * ============================================================================
+ */
+void SCH_Class_Changed(SCH_Instance_t *SCH, sch_index_t slot) {
+    wheel_list_t list = SCH->wheel_list[slot];
+
+    if (list != WHEEL_NO_LIST && list >= WHEEL_READY_LIST) {
+        wheel_list_remove(SCH, slot);
+        wheel_list_append(SCH, WHEEL_READY_OF(slot), slot);
+    }
+}
+#endif
+
+/* ==================== IMPLEMENTATION ==================== */
+
+/**
+ * ============================================================================
+ * HÀM: SCH_Init_In (TIMING WHEEL)
+ * ============================================================================
+ * MÔ TẢ: Xóa bảng slot và làm rỗng mọi ô của wheel
+ * ============================================================================
+ */
+void SCH_Init_In(SCH_Instance_t *SCH) {
+    SCH_Slots_Init(SCH);
+
+    for (uint32_t i = 0; i < WHEEL_LISTS; i++) {
+        SCH->wheel_head[i] = WHEEL_NIL;
+    }
+    for (uint32_t i = 0; i < SCH_MAX_TASKS; i++) {
+        SCH->wheel_list[i] = WHEEL_NO_LIST;
+    }
+
+    SCH->wheel_next_tick = 0;
+    SCH->done_ticks = SCH->tick_now;
+    SCH->error_code = 0;
+}
+
+/**
+ * ============================================================================
+ * HÀM: SCH_Init_Static_In (TIMING WHEEL)
+ * ============================================================================
+ * MÔ TẢ: Khởi tạo rồi đặt từng dòng của bảng const vào wheel - O(1) mỗi task
+ *        (wheel không cần thứ tự / MARKING tính sẵn của bảng)
+ * ============================================================================
+ */
+void SCH_Init_Static_In(SCH_Instance_t *SCH, const SCH_Task_Table_t *TABLE) {
+    SCH_Init_In(SCH);
+
+    SCH_Admit_Table_Begin(SCH);
+    for (uint32_t i = 0; i < TABLE->Count; i++) {
+        SCH_Add_Task_In(SCH, TABLE->Tasks[i].pTask, TABLE->Tasks[i].Delay, TABLE->Tasks[i].Period);
+    }
+    SCH_Admit_Table_End(SCH);
+}
+
+/**
+ * ============================================================================
+ * HÀM: SCH_Add_Task_In (TIMING WHEEL)
+ * ============================================================================
+ * MÔ TẢ: Lấy 1 slot trống, tính tick hết hạn, đặt vào wheel - O(1)
+ *        (+ kiểm tra nhận task nếu SCH_ADMISSION = 1)
+ *
+ * Giữ nguyên ngữ nghĩa của mảng sắp xếp:
+ *   DELAY = 0 hoặc 1 → chạy ở tick kế tiếp
+ *   DELAY = d        → chạy sau d tick
+ *
+ * TRẢ VỀ: Handle của task, SCH_INVALID_HANDLE nếu đầy hoặc quá tải
+ *         (ERROR_SCH_NOT_SCHEDULABLE)
+ * ============================================================================
+ */
+SCH_Handle_t SCH_Add_Task_In(SCH_Instance_t *SCH, void (*pFunction)(), uint32_t DELAY, uint32_t PERIOD) {
+
+    if (pFunction == 0x0000 || !SCH_Ticks_Check(SCH, DELAY, PERIOD) || !SCH_Admit(SCH, DELAY, PERIOD)) {
+        return SCH_INVALID_HANDLE;
+    }
+
+    wheel_idx_t idx = SCH_Slot_Alloc(SCH, pFunction, PERIOD);
+    if (idx == WHEEL_NIL) {
+        return SCH_INVALID_HANDLE;
+    }
+
+    if (DELAY == 0) DELAY = 1;
+    SCH_TASK_DELAY(idx) = SCH->wheel_next_tick + DELAY - 1u; // Tick hết hạn tuyệt đối
+    SCH_Set_Due(SCH, idx, SCH_TASK_DELAY(idx) + 1u);
+
+    wheel_place(SCH, idx);
+
+    return SCH_TASK_ID(idx);
+}
+
+/**
+ * ============================================================================
+ * HÀM: SCH_Delete_Task_In (TIMING WHEEL)
+ * ============================================================================
+ * MÔ TẢ: Gỡ task khỏi wheel (hoặc READY) và trả slot - O(1)
+ * ============================================================================
+ */
+uint8_t SCH_Delete_Task_In(SCH_Instance_t *SCH, const SCH_Handle_t TASK_HANDLE) {
+
+#if SCH_FAST_LANE
+    if (SCH_FAST_HANDLE(TASK_HANDLE)) {
+        return SCH_Fast_Delete(SCH, TASK_HANDLE);
+    }
+#endif
+#if SCH_PIPELINE
+    if (SCH_STAGE_HANDLE(TASK_HANDLE)) {
+        return SCH_Stage_Delete(SCH, TASK_HANDLE);
+    }
+#endif
+
+    wheel_idx_t idx = SCH_Handle_To_Slot(SCH, TASK_HANDLE);
+    if (idx == WHEEL_NIL) {
+        SCH->error_code = ERROR_SCH_CANNOT_DELETE_TASK;
+        return RETURN_ERROR;
+    }
+
+    wheel_list_remove(SCH, idx);
+    SCH_Slot_Kill(SCH, idx);
+    SCH_Slot_Release(SCH, idx);
+
+    return RETURN_NORMAL;
+}
+
+/**
+ * ============================================================================
+ * HÀM: SCH_Reschedule_Task_In (TIMING WHEEL)
+ * ============================================================================
+ * MÔ TẢ: Gỡ khỏi ô cũ, tính tick hết hạn mới, đặt vào ô mới - O(1)
+ *        (+ kiểm tra nhận task nếu SCH_ADMISSION = 1)
+ *        Handle không đổi
+ * ============================================================================
+ */
+uint8_t SCH_Reschedule_Task_In(SCH_Instance_t *SCH, const SCH_Handle_t TASK_HANDLE, uint32_t DELAY, uint32_t PERIOD) {
+
+#if SCH_FAST_LANE
+    if (SCH_FAST_HANDLE(TASK_HANDLE)) {
+        return SCH_Fast_Reschedule(SCH, TASK_HANDLE, DELAY, PERIOD);
+    }
+#endif
+
+    wheel_idx_t idx = SCH_Handle_To_Slot(SCH, TASK_HANDLE);
+    if (idx == WHEEL_NIL) {
+        SCH->error_code = ERROR_SCH_CANNOT_DELETE_TASK;
+        return RETURN_ERROR;
+    }
+    if (!SCH_Ticks_Check(SCH, DELAY, PERIOD) || !SCH_Admit_Reschedule(SCH, idx, DELAY, PERIOD)) {
+        return RETURN_ERROR;
+    }
+
+    if (DELAY == 0) DELAY = 1;
+
+    wheel_list_remove(SCH, idx);
+    SCH_TASK_DELAY(idx) = SCH->wheel_next_tick + DELAY - 1u;
+    SCH_TASK_PERIOD(idx) = PERIOD;
+    SCH_TASK_RUNME(idx) = 0;
+    SCH_Set_Due(SCH, idx, SCH_TASK_DELAY(idx) + 1u);
+    wheel_place(SCH, idx);
+
+    return RETURN_NORMAL;
+}
+
+/**
+ * ============================================================================
+ * HÀM: SCH_Update_In (TIMING WHEEL) - GỌI TRONG INTERRUPT TIMER
+ * ============================================================================
+ * ĐỘ PHỨC TẠP: O(1) - chỉ tăng bộ đếm tick
+ *
+ * Việc quay wheel (cascade, chuyển task sang READY) được làm trong
+ * SCH_Dispatch_Tasks() để ISR luôn ngắn và không phụ thuộc số task.
+ * ============================================================================
+ */
+void SCH_Update_In(SCH_Instance_t *SCH) {
+    SCH->tick_now++;
+    SCH_TICK_STAMP();
+    SCH_TRACE_RECORD(SCH_TRACE_TICK, SCH->tick_now, 0);
+}
+
+/**
+ * ============================================================================
+ * HÀM: SCH_Dispatch_Tasks_In (TIMING WHEEL)
+ * ============================================================================
+ * CÁCH HOẠT ĐỘNG:
+ *   (Trước tiên: thực hiện lệnh từ ngắt - SCH_Process_Commands,
+ *    rồi các task làn nhanh đã phát hành - SCH_Fast_Dispatch)
+ *   BƯỚC 1: Quay wheel cho mỗi tick ISR đã đếm → task hết hạn vào READY
+ *   BƯỚC 2: Chạy lần lượt các task READY (theo thứ tự hết hạn;
+ *           SCH_PRIORITY: lớp cao nhất trước, và wheel được quay tiếp
+ *           trước MỖI task → task lớp cao đến hạn trong lúc task khác
+ *           chạy được chọn ngay sau task đó)
+ *           - Kiểm tra trễ hạn trước khi chạy (SCH_Deadline_Check)
+ *           - One-shot: trả slot
+ *           - Periodic: đặt lại vào wheel ở lần phát hành kế tiếp
+ *             (SCH_Rearm_Due, giữ nguyên slot)
+ * ============================================================================
+ */
+void SCH_Dispatch_Tasks_In(SCH_Instance_t *SCH) {
+
+    SCH_TRACE_RECORD(SCH_TRACE_DISPATCH_BEGIN, SCH->tick_now, 0);
+
+    // Thực hiện các lệnh thêm/xóa task do ngắt gửi tới
+    SCH_Process_Commands(SCH);
+
+#if SCH_FAST_LANE
+    // Làn nhanh (SysTick) trước: các task 1ms không phải chờ làn 10ms
+    SCH_Fast_Dispatch(SCH);
+#endif
+
+    /* ========== BƯỚC 1: QUAY WHEEL ========== */
+    while (SCH->done_ticks != SCH->tick_now) {
+        wheel_advance(SCH);
+        SCH->done_ticks++;
+    }
+
+    /* ========== BƯỚC 2: CHẠY CÁC TASK READY ========== */
+    wheel_idx_t idx;
+    while ((idx = wheel_ready_first(SCH)) != WHEEL_NIL) {
+        wheel_list_remove(SCH, idx);
+        SCH_TASK_RUNME(idx)--;
+
+        if (SCH_TASK_FN(idx) != 0x0000 && SCH_Deadline_Check(SCH, idx)) {
+            SCH_Run_Task(SCH, idx);
+        }
+
+        // Task đã tự Delete (slot đã trả) hoặc tự Reschedule (đã ở trong wheel)
+        if (SCH_TASK_FN(idx) == 0x0000 || SCH->wheel_list[idx] != WHEEL_NO_LIST) {
+            continue;
+        }
+
+        if (SCH_TASK_PERIOD(idx) == 0) {
+            SCH_Slot_Kill(SCH, idx);
+            SCH_Slot_Release(SCH, idx);
+        } else if (SCH_Replay_Pending(SCH, idx)) {
+            // REPLAY: còn lần chạy bù → xếp lại cuối danh sách READY
+            SCH_TASK_RUNME(idx)++;
+            wheel_list_append(SCH, WHEEL_READY_OF(idx), idx);
+        } else {
+            // Tick wheel = tick đến hạn - 1 (giống SCH_Add_Task)
+            SCH_TASK_DELAY(idx) = SCH_Rearm_Due(SCH, idx) - 1u;
+            wheel_place(SCH, idx);
+        }
+
+#if SCH_PRIORITY
+        // Tick mới trong lúc task chạy → đưa task vừa đến hạn vào READY
+        while (SCH->done_ticks != SCH->tick_now) {
+            wheel_advance(SCH);
+            SCH->done_ticks++;
+        }
+#endif
+    }
+
+    // Báo cáo lỗi (trễ hạn, RunMe bão hòa, ...)
+    SCH_Report_Status_In(SCH);
+
+    SCH_TRACE_RECORD(SCH_TRACE_DISPATCH_END, SCH->tick_now, 0);
+}
+
+/**
+ * ============================================================================
+ * HÀM: SCH_Idle_Ticks / SCH_Skip_Ticks (INTERNAL - TICKLESS IDLE)
+ * ============================================================================
+ * MÔ TẢ:
+ *   - Idle_Ticks: quét các ô cấp 0 từ tick hiện tại tới hết vòng
+ *                 → ô khác rỗng đầu tiên = deadline kế tiếp
+ *                 Không có → thức ở tick cuối vòng (tick cascade) để kéo
+ *                 các task ở cấp cao xuống, rồi ngủ tiếp
+ *                 → mỗi lần ngủ tối đa WHEEL_SLOTS + 1 tick
+ *   - Skip_Ticks: chỉ cộng vào SCH->tick_now, Dispatch sẽ quay wheel qua
+ *                 các tick đó (toàn ô rỗng nên rất nhanh)
+ * ============================================================================
+ */
+uint32_t SCH_Idle_Ticks(SCH_Instance_t *SCH) {
+    if (SCH->tick_now != SCH->done_ticks || wheel_ready_first(SCH) != WHEEL_NIL) {
+        return 0;
+    }
+
+    uint32_t pos = SCH->wheel_next_tick & WHEEL_MASK;
+    if (pos == 0) {
+        return 1;       // Tick kế tiếp có cascade
+    }
+
+    uint32_t ticks = 1;
+    while (pos + ticks - 1u <= WHEEL_MASK) {
+        if (SCH->wheel_head[pos + ticks - 1u] != WHEEL_NIL) {
+            return ticks;
+        }
+        ticks++;
+    }
+    return ticks;       // Tick đầu vòng mới (cascade)
+}
+
+void SCH_Skip_Ticks(SCH_Instance_t *SCH, uint32_t TICKS) {
+    SCH->tick_now += TICKS;
+}
+
+#endif /* SCH_BACKEND == SCH_BACKEND_TIMING_WHEEL */
@@ -13,6 +13,14 @@ C_SRCS += \
 ../Core/Src/led_display.c \
 ../Core/Src/main.c \
 ../Core/Src/scheduler.c \
+../Core/Src/scheduler_cmd.c \
+../Core/Src/scheduler_cyclic.c \
+../Core/Src/scheduler_default.c \
+../Core/Src/scheduler_fast.c \
+../Core/Src/scheduler_pipe.c \
+../Core/Src/scheduler_port.c \
+../Core/Src/scheduler_trace.c \
+../Core/Src/scheduler_wheel.c \
 ../Core/Src/software_timer.c \
 ../Core/Src/stm32f1xx_hal_msp.c \
 ../Core/Src/stm32f1xx_it.c \
@@ -29,6 +37,14 @@ OBJS += \
 ./Core/Src/led_display.o \
 ./Core/Src/main.o \
 ./Core/Src/scheduler.o \
+./Core/Src/scheduler_cmd.o \
+./Core/Src/scheduler_cyclic.o \
+./Core/Src/scheduler_default.o \
+./Core/Src/scheduler_fast.o \
+./Core/Src/scheduler_pipe.o \
+./Core/Src/scheduler_port.o \
+./Core/Src/scheduler_trace.o \
+./Core/Src/scheduler_wheel.o \
 ./Core/Src/software_timer.o \
 ./Core/Src/stm32f1xx_hal_msp.o \
 ./Core/Src/stm32f1xx_it.o \
@@ -45,6 +61,14 @@ C_DEPS += \
 ./Core/Src/led_display.d \
 ./Core/Src/main.d \
 ./Core/Src/scheduler.d \
+./Core/Src/scheduler_cmd.d \
+./Core/Src/scheduler_cyclic.d \
+./Core/Src/scheduler_default.d \
+./Core/Src/scheduler_fast.d \
+./Core/Src/scheduler_pipe.d \
+./Core/Src/scheduler_port.d \
+./Core/Src/scheduler_trace.d \
+./Core/Src/scheduler_wheel.d \
 ./Core/Src/software_timer.d \
 ./Core/Src/stm32f1xx_hal_msp.d \
 ./Core/Src/stm32f1xx_it.d \
@@ -0,0 +1,104 @@
+/*
+ * ============================================================================
+ * ADMISSION CHECK - KIỂM SOÁT NHẬN TASK KHI THÊM / RESCHEDULE (HOST / LINUX)
+ * ============================================================================
+ * Mô tả: Chạy scheduler thật (Core/Src) với SCH_ADMISSION, kiểm tra đường
+ *        SCH_Reschedule_Task: one-shot luôn được nhận lúc thêm, nhưng đổi
+ *        thành định kỳ vẫn phải qua kiểm tra như SCH_Add_Task
+ *
+ * BUILD & CHẠY (xem Makefile):
+ *   make admit                      → mảng sắp xếp, wheel và cyclic
+ *
+ * TẬP TASK (B = ngân sách 1 tick của SCH_Get_Admission):
+ *   Fsm     P = 2 tick, Delay 1,  WCET B/4
+ *   Log_A   one-shot,  Delay 3,   WCET B - B/8  (Fsm + Log_A > B)
+ *   Log_B   one-shot,  Delay 9,   WCET B - B/8
+ *
+ * CÁC BƯỚC:
+ *   1. Thêm Log_A, Log_B           → nhận (one-shot)
+ *   2. Reschedule(Log_A, 1, 4)     → từ chối, ERROR_SCH_NOT_SCHEDULABLE
+ *                                    (chạy cùng tick với Fsm)
+ *   3. Reschedule(Log_B, 2, 4)     → nhận (tick chẵn, Fsm chạy tick lẻ)
+ *   4. Reschedule(Log_B, 1, 4)     → từ chối, Log_B giữ Delay 2 / P = 4
+ *   5. Chạy 12 tick: Log_A chạy 1 lần (vẫn là one-shot), Log_B chạy ở
+ *      tick 2, 6, 10, tải tick nặng nhất không vượt ngân sách
+ *
+ * TRẢ VỀ: 0 nếu mọi bước đúng, 1 nếu không, 2 nếu không thêm được task
+ *
+ * LƯU Ý: SCH_ADMIT_PROFILED = 0 (mặc định) → WCET là giá trị khai báo,
+ *        không bị Max_Cycles đo trên máy host thay đổi dù profiler bật
+ * ============================================================================
+ */
+
+#include <stdio.h>
+#include "scheduler.h"
+
+/* ==================== CẤU HÌNH ==================== */
+
+#if SCH_BACKEND == SCH_BACKEND_TIMING_WHEEL
+#define BACKEND_NAME        "wheel"
+#elif SCH_BACKEND == SCH_BACKEND_CYCLIC
+#define BACKEND_NAME        "cyclic"
+#else
+#define BACKEND_NAME        "sorted"
+#endif
+
+#define ADMIT_TICKS         12u
+
+/* ==================== BIẾN NỘI BỘ ==================== */
+
+static uint32_t runs_fsm, runs_a, runs_b;
+static uint32_t failures;
+
+/* ==================== HÀM PRIVATE ==================== */
+
+static void Sim_Fsm(void)   { runs_fsm++; }
+static void Sim_Log_A(void) { runs_a++; }
+static void Sim_Log_B(void) { runs_b++; }
+
+static void Check(int OK, const char *WHAT) {
+    if (!OK) {
+        fprintf(stderr, "sch_admit (%s): %s\n", BACKEND_NAME, WHAT);
+        failures++;
+    }
+}
+
+/* ==================== MAIN ==================== */
+
+int main(void) {
+    SCH_Admission_t ad;
+
+    SCH_Init();
+    SCH_Get_Admission(&ad);
+    uint32_t budget = ad.Tick_Budget;
+
+    SCH_Handle_t fsm = SCH_Add_Task_Wcet(Sim_Fsm, 1, 2, budget / 4u);
+    SCH_Handle_t log_a = SCH_Add_Task_Wcet(Sim_Log_A, 3, 0, budget - budget / 8u);
+    SCH_Handle_t log_b = SCH_Add_Task_Wcet(Sim_Log_B, 9, 0, budget - budget / 8u);
+    if (fsm == SCH_INVALID_HANDLE || log_a == SCH_INVALID_HANDLE || log_b == SCH_INVALID_HANDLE) {
+        fprintf(stderr, "sch_admit (%s): cannot add task (error %u)\n", BACKEND_NAME, Error_code_G);
+        return 2;
+    }
+
+    Error_code_G = 0;
+    Check(SCH_Reschedule_Task(log_a, 1, 4) == RETURN_ERROR, "one-shot -> periodic on a full tick was admitted");
+    Check(Error_code_G == ERROR_SCH_NOT_SCHEDULABLE, "rejected reschedule did not set ERROR_SCH_NOT_SCHEDULABLE");
+
+    Error_code_G = 0;
+    Check(SCH_Reschedule_Task(log_b, 2, 4) == RETURN_NORMAL, "one-shot -> periodic on a free tick was rejected");
+    Check(SCH_Reschedule_Task(log_b, 1, 4) == RETURN_ERROR, "periodic moved onto a full tick was admitted");
+
+    for (uint32_t t = 0; t < ADMIT_TICKS; t++) {
+        SCH_Update();
+        SCH_Dispatch_Tasks();
+    }
+
+    Check(runs_fsm == ADMIT_TICKS / 2u, "Fsm run count");
+    Check(runs_a == 1, "rejected one-shot did not run exactly once");
+    Check(runs_b == 3, "Log_B did not keep Delay 2 / Period 4");
+    Check(SCH_Get_Current_Size() == 2, "rejected one-shot is still in the task list");
+    Check(SCH_Get_Admission(&ad) == RETURN_NORMAL && ad.Worst_Tick <= ad.Tick_Budget, "task set over budget");
+
+    printf("sch_admit (%s): %s\n", BACKEND_NAME, failures ? "FAIL" : "ok");
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,272 @@
+/*
+ * ============================================================================
+ * SCHEDULER BENCHMARK (HOST / LINUX)
+ * ============================================================================
+ * Mô tả: Đo thời gian SCH_Add_Task, SCH_Delete_Task, SCH_Update và
+ *        SCH_Dispatch_Tasks của scheduler thật (Core/Src) trên máy tính,
+ *        với 3 .. 10000 task và 2 kiểu phân bố chu kỳ
+ *
+ * BUILD & CHẠY (xem Makefile):
+ *   make bench          → mảng sắp xếp (Delay tương đối / tuyệt đối),
+ *                         timing wheel và cyclic, kết quả CSV ra stdout
+ *   make layout         → mảng sắp xếp, bảng compact và bảng sTask cũ
+ *   ./sch_bench_sorted --quick
+ *
+ * KẾT QUẢ (CSV, 1 dòng / phép đo):
+ *   backend,dist,tasks,op,ns_per_op,ops_per_s,samples
+ *   sorted,harmonic,100,add,73.2,13667712,273400
+ *
+ *   op = add / delete / update / dispatch: ns cho 1 lần gọi hàm
+ *   op = dispatch_per_run: ns của Dispatch chia cho số task đã chạy
+ *        (chi phí scheduler cho mỗi lần chạy task, không tính thân task)
+ *
+ * PHÂN BỐ CHU KỲ (dist):
+ *   harmonic: chu kỳ ∈ {1, 2, 5, 10, 20, 50, 100} tick (giống ứng dụng)
+ *   uniform:  chu kỳ ngẫu nhiên 1..1000 tick
+ *   Delay ban đầu ngẫu nhiên trong [0, chu kỳ), cùng seed cho mọi lần chạy
+ *
+ * LƯU Ý:
+ * - Build với SCH_PROFILE = 0: profiler đọc đồng hồ 2 lần mỗi task,
+ *   sẽ làm sai kết quả Dispatch
+ * - Mỗi phép đo chạy ít nhất BENCH_MIN_NS (--quick: /10), tối đa 5 lần
+ *   thế tính cả phần chuẩn bị; thời gian đọc đồng hồ được đo trước và
+ *   trừ ra khỏi Update / Dispatch
+ *
+ * TRẢ VỀ: 0, 2 nếu tham số sai hoặc SCH_Add_Task từ chối 1 task (kết quả
+ *         đo khi đó không đúng số task, in Error_code_G ra stderr)
+ * ============================================================================
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "scheduler.h"
+
+/* ==================== CẤU HÌNH ==================== */
+
+#if SCH_BACKEND == SCH_BACKEND_TIMING_WHEEL
+#define BACKEND_NAME        "wheel"
+#elif SCH_BACKEND == SCH_BACKEND_CYCLIC
+#define BACKEND_NAME        "cyclic"
+#elif SCH_TIMEBASE == SCH_TIMEBASE_ABSOLUTE
+#define BACKEND_NAME        "sorted_abs"        // Delay = tick đến hạn
+#elif !SCH_COMPACT
+#define BACKEND_NAME        "sorted_stask"      // Bảng sTask + MARKING
+#else
+#define BACKEND_NAME        "sorted"
+#endif
+
+#define BENCH_MIN_NS        200000000uLL    // 0.2s mỗi phép đo
+
+static const uint32_t bench_sizes[] = { 3, 10, 30, 100, 300, 1000, 3000, 10000 };
+
+static const uint32_t harmonic_periods[] = { 1, 2, 5, 10, 20, 50, 100 };
+
+/* ==================== BIẾN NỘI BỘ ==================== */
+
+static uint64_t min_ns = BENCH_MIN_NS;
+static uint64_t clock_overhead_ns = 0;
+static uint64_t wall_start_ns = 0;
+
+static uint32_t task_period[SCH_MAX_TASKS];
+static uint32_t task_delay[SCH_MAX_TASKS];
+static uint32_t delete_order[SCH_MAX_TASKS];
+static SCH_Handle_t handles[SCH_MAX_TASKS];
+
+static volatile uint32_t task_runs = 0;
+static uint32_t rng_state = 1;
+
+/* ==================== HÀM PRIVATE ==================== */
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000uLL + (uint64_t)ts.tv_nsec;
+}
+
+// xorshift32: cùng chuỗi số trên mọi máy → kết quả so sánh được
+static uint32_t rng(void) {
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 17;
+    rng_state ^= rng_state << 5;
+    return rng_state;
+}
+
+static void bench_task(void) {
+    task_runs++;
+}
+
+/**
+ * Tạo chu kỳ / delay của N task và thứ tự xóa ngẫu nhiên (Fisher-Yates)
+ */
+static void bench_make_tasks(uint32_t n, const char *dist) {
+    rng_state = 2463534242u + n;
+
+    for (uint32_t i = 0; i < n; i++) {
+        if (strcmp(dist, "harmonic") == 0) {
+            task_period[i] = harmonic_periods[rng() % (sizeof(harmonic_periods) / sizeof(harmonic_periods[0]))];
+        } else {
+            task_period[i] = 1u + rng() % 1000u;
+        }
+        task_delay[i] = rng() % task_period[i];
+        delete_order[i] = i;
+    }
+    for (uint32_t i = n - 1u; i > 0; i--) {
+        uint32_t j = rng() % (i + 1u);
+        uint32_t t = delete_order[i];
+        delete_order[i] = delete_order[j];
+        delete_order[j] = t;
+    }
+}
+
+/**
+ * Mọi handle của N task vừa thêm hợp lệ? Không → dừng chương trình: phép
+ * đo với ít task hơn (hoặc xóa handle không hợp lệ) sẽ cho số sai
+ */
+static void bench_check_adds(uint32_t n) {
+    for (uint32_t i = 0; i < n; i++) {
+        if (handles[i] == SCH_INVALID_HANDLE) {
+            fprintf(stderr, "sch_bench (%s): cannot add task %u of %u (error %u)\n",
+                    BACKEND_NAME, i, n, Error_code_G);
+            exit(2);
+        }
+    }
+}
+
+static void bench_fill(uint32_t n) {
+    SCH_Init();
+    for (uint32_t i = 0; i < n; i++) {
+        handles[i] = SCH_Add_Task(bench_task, task_delay[i], task_period[i]);
+    }
+    bench_check_adds(n);
+}
+
+/**
+ * Đo tiếp? Đủ BENCH_MIN_NS thời gian đo, hoặc đã có mẫu mà phần chuẩn bị
+ * không được đo (SCH_Init, thêm task trước khi xóa) chiếm quá 5x thời gian đó
+ */
+static int bench_more(uint64_t measured_ns, uint64_t ops) {
+    if (ops == 0) {
+        wall_start_ns = now_ns();
+        return 1;
+    }
+    return measured_ns < min_ns && now_ns() - wall_start_ns < 5u * min_ns;
+}
+
+static void bench_print(const char *dist, uint32_t n, const char *op, uint64_t ns, uint64_t ops) {
+    double ns_per_op = (ops > 0) ? (double)ns / (double)ops : 0.0;
+    double ops_per_s = (ns_per_op > 0.0) ? 1e9 / ns_per_op : 0.0;
+
+    printf("%s,%s,%u,%s,%.1f,%.0f,%llu\n", BACKEND_NAME, dist, n, op,
+           ns_per_op, ops_per_s, (unsigned long long)ops);
+    fflush(stdout);
+}
+
+/**
+ * Thời gian trung bình của 1 lần now_ns() (trừ khỏi phép đo từng lần gọi)
+ */
+static void bench_calibrate(void) {
+    const uint32_t reps = 1000000u;
+    uint64_t start = now_ns();
+
+    for (uint32_t i = 0; i < reps; i++) {
+        (void)now_ns();
+    }
+    clock_overhead_ns = (now_ns() - start) / reps;
+}
+
+/* ==================== CÁC PHÉP ĐO ==================== */
+
+// SCH_Add_Task: thêm N task vào scheduler rỗng, lặp lại
+static void bench_add(const char *dist, uint32_t n) {
+    uint64_t total = 0, ops = 0;
+
+    while (bench_more(total, ops)) {
+        SCH_Init();
+        uint64_t start = now_ns();
+        for (uint32_t i = 0; i < n; i++) {
+            handles[i] = SCH_Add_Task(bench_task, task_delay[i], task_period[i]);
+        }
+        total += now_ns() - start;
+        ops += n;
+        bench_check_adds(n);
+    }
+    bench_print(dist, n, "add", total, ops);
+}
+
+// SCH_Delete_Task: xóa N task theo thứ tự ngẫu nhiên, lặp lại
+static void bench_delete(const char *dist, uint32_t n) {
+    uint64_t total = 0, ops = 0;
+
+    while (bench_more(total, ops)) {
+        bench_fill(n);
+        uint64_t start = now_ns();
+        for (uint32_t i = 0; i < n; i++) {
+            SCH_Delete_Task(handles[delete_order[i]]);
+        }
+        total += now_ns() - start;
+        ops += n;
+    }
+    bench_print(dist, n, "delete", total, ops);
+}
+
+// SCH_Update (đường đi trong ISR) và SCH_Dispatch_Tasks, từng tick
+static void bench_tick(const char *dist, uint32_t n) {
+    uint64_t update_ns = 0, dispatch_ns = 0, ticks = 0;
+
+    bench_fill(n);
+    task_runs = 0;
+
+    while (bench_more(update_ns + dispatch_ns, ticks)) {
+        uint64_t t0 = now_ns();
+        SCH_Update();
+        uint64_t t1 = now_ns();
+        SCH_Dispatch_Tasks();
+        uint64_t t2 = now_ns();
+
+        update_ns += (t1 - t0 > clock_overhead_ns) ? (t1 - t0 - clock_overhead_ns) : 0;
+        dispatch_ns += (t2 - t1 > clock_overhead_ns) ? (t2 - t1 - clock_overhead_ns) : 0;
+        ticks++;
+    }
+
+    bench_print(dist, n, "update", update_ns, ticks);
+    bench_print(dist, n, "dispatch", dispatch_ns, ticks);
+    bench_print(dist, n, "dispatch_per_run", dispatch_ns, task_runs);
+}
+
+/* ==================== MAIN ==================== */
+
+int main(int argc, char **argv) {
+    static const char *dists[] = { "harmonic", "uniform" };
+    int header = 1;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--quick") == 0) {
+            min_ns = BENCH_MIN_NS / 10u;
+        } else if (strcmp(argv[i], "--no-header") == 0) {
+            header = 0;
+        } else {
+            fprintf(stderr, "usage: %s [--quick] [--no-header]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    bench_calibrate();
+    if (header) {
+        printf("backend,dist,tasks,op,ns_per_op,ops_per_s,samples\n");
+    }
+
+    for (uint32_t d = 0; d < sizeof(dists) / sizeof(dists[0]); d++) {
+        for (uint32_t s = 0; s < sizeof(bench_sizes) / sizeof(bench_sizes[0]); s++) {
+            uint32_t n = bench_sizes[s];
+            if (n > SCH_MAX_TASKS) break;
+
+            bench_make_tasks(n, dists[d]);
+            bench_add(dists[d], n);
+            bench_delete(dists[d], n);
+            bench_tick(dists[d], n);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,203 @@
+/*
+ * ============================================================================
+ * FLEET TEST - NHIỀU SCHEDULER TRONG 1 TIẾN TRÌNH (HOST / LINUX)
+ * ============================================================================
+ * Mô tả: Chạy hàng nghìn SCH_Instance_t độc lập (mỗi instance = 1 nút giao
+ *        giả lập) bằng scheduler thật (Core/Src), rồi kiểm tra mỗi task
+ *        của mỗi instance chạy đúng số lần theo chu kỳ của chính nó
+ *        → instance này không làm lệch instance khác
+ *
+ * BUILD & CHẠY (xem Makefile):
+ *   make fleet                          → 1000 instance x 10000 tick trên
+ *                                         mảng sắp xếp, wheel và cyclic
+ *   ./sch_fleet_wheel --instances 5000 --ticks 2000
+ *
+ * TẬP TASK CỦA INSTANCE i:
+ *   Button_Scan     P = 1 tick
+ *   Update_Display  P = 5 tick,            Delay = i % 5
+ *   Second          P = 10 / 20 / 50 / 100 tick (theo i), Delay = i % P
+ *   Blink           one-shot,              Delay = 1 + i % 200
+ *   → mỗi instance có pha / chu kỳ riêng, lỗi chia sẻ trạng thái giữa
+ *     các instance sẽ làm sai số lần chạy
+ *   Chu kỳ hài hoà → chạy được cả với backend cyclic (siêu chu kỳ 100)
+ *
+ * KIỂM TRA (như sch_soak): số lần phát hành = số lần chạy + chu kỳ đã lỡ
+ *   (SCH_Get_Task_Misses_In), so với số lần phát hành theo tick của instance
+ *
+ * KẾT QUẢ (CSV, 1 dòng):
+ *   backend,instances,ticks,bytes_per_instance,ns_per_instance_tick,mismatches
+ *
+ * TRẢ VỀ: 0 nếu mọi task của mọi instance chạy đúng số lần, 1 nếu không
+ *
+ * LƯU Ý:
+ * - Task là void (*)(void), không có tham số → task biết mình thuộc
+ *   instance nào qua fleet_cur (đặt trước mỗi lần Dispatch)
+ * - Handle chỉ có nghĩa trong instance đã cấp nó: 2 instance có thể
+ *   cấp cùng 1 giá trị handle
+ * ============================================================================
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "scheduler.h"
+
+/* ==================== CẤU HÌNH ==================== */
+
+#if SCH_BACKEND == SCH_BACKEND_TIMING_WHEEL
+#define BACKEND_NAME        "wheel"
+#elif SCH_BACKEND == SCH_BACKEND_CYCLIC
+#define BACKEND_NAME        "cyclic"
+#else
+#define BACKEND_NAME        "sorted"
+#endif
+
+#define FLEET_TASKS         4u      // Button_Scan, Update_Display, Second, Blink
+
+/* ==================== BIẾN NỘI BỘ ==================== */
+
+static const uint32_t second_periods[] = { 10, 20, 50, 100 };
+
+typedef struct {
+    SCH_Handle_t Handle[FLEET_TASKS];
+    uint32_t Delay[FLEET_TASKS];
+    uint32_t Period[FLEET_TASKS];
+    uint32_t Runs[FLEET_TASKS];
+} Fleet_Node_t;
+
+static SCH_Instance_t *fleet;       // calloc: instance phải bằng 0 trước SCH_Init_In
+static Fleet_Node_t *nodes;
+static uint32_t fleet_cur;          // Instance đang Dispatch
+
+/* ==================== HÀM PRIVATE ==================== */
+
+static void Sim_Button_Scan(void)    { nodes[fleet_cur].Runs[0]++; }
+static void Sim_Update_Display(void) { nodes[fleet_cur].Runs[1]++; }
+static void Sim_Second(void)         { nodes[fleet_cur].Runs[2]++; }
+static void Sim_Blink(void)          { nodes[fleet_cur].Runs[3]++; }
+
+static void (*const fleet_fn[FLEET_TASKS])(void) = {
+    Sim_Button_Scan, Sim_Update_Display, Sim_Second, Sim_Blink,
+};
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000uLL + (uint64_t)ts.tv_nsec;
+}
+
+/*
+ * Số lần chạy dự kiến sau TICKS tick (giống sch_soak: Delay 0 chạy ở
+ * tick 1 đầu tiên)
+ */
+static uint32_t Expected_Runs(uint32_t DELAY, uint32_t PERIOD, uint32_t TICKS) {
+    uint32_t first = (DELAY > 0) ? DELAY : 1u;
+    if (TICKS < first) {
+        return 0;
+    }
+    if (PERIOD == 0) {
+        return 1;
+    }
+    return (TICKS - first) / PERIOD + 1u;
+}
+
+/* ==================== MAIN ==================== */
+
+int main(int argc, char **argv) {
+    uint32_t count = 1000;
+    uint32_t ticks = 10000;
+    int header = 1;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--no-header") == 0) {
+            header = 0;
+        } else if (strcmp(argv[i], "--instances") == 0 && i + 1 < argc) {
+            count = (uint32_t)strtoul(argv[++i], NULL, 0);
+        } else if (strcmp(argv[i], "--ticks") == 0 && i + 1 < argc) {
+            ticks = (uint32_t)strtoul(argv[++i], NULL, 0);
+        } else {
+            fprintf(stderr, "usage: %s [--instances N] [--ticks T] [--no-header]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (count == 0 || ticks == 0) {
+        fprintf(stderr, "sch_fleet: --instances and --ticks must be > 0\n");
+        return 2;
+    }
+
+    fleet = calloc(count, sizeof(*fleet));
+    nodes = calloc(count, sizeof(*nodes));
+    if (fleet == NULL || nodes == NULL) {
+        fprintf(stderr, "sch_fleet: out of memory (%u instances)\n", count);
+        return 2;
+    }
+
+    for (uint32_t i = 0; i < count; i++) {
+        Fleet_Node_t *n = &nodes[i];
+        n->Period[0] = 1;
+        n->Period[1] = 5;
+        n->Period[2] = second_periods[i % 4u];
+        n->Period[3] = 0;
+        n->Delay[0] = 0;
+        n->Delay[1] = i % 5u;
+        n->Delay[2] = i % n->Period[2];
+        n->Delay[3] = 1u + i % 200u;
+
+        SCH_Init_In(&fleet[i]);
+        for (uint32_t k = 0; k < FLEET_TASKS; k++) {
+            n->Handle[k] = SCH_Add_Task_In(&fleet[i], fleet_fn[k], n->Delay[k], n->Period[k]);
+        }
+    }
+
+    // Mọi instance dùng chung 1 "TIM2": mỗi tick Update rồi Dispatch lần lượt
+    uint64_t t0 = now_ns();
+    for (uint32_t t = 0; t < ticks; t++) {
+        for (fleet_cur = 0; fleet_cur < count; fleet_cur++) {
+            SCH_Update_In(&fleet[fleet_cur]);
+            SCH_Dispatch_Tasks_In(&fleet[fleet_cur]);
+        }
+    }
+    uint64_t elapsed = now_ns() - t0;
+
+    uint32_t mismatches = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        Fleet_Node_t *n = &nodes[i];
+        uint32_t now = SCH_Get_Tick_In(&fleet[i]);
+        for (uint32_t k = 0; k < FLEET_TASKS; k++) {
+            uint32_t expected = Expected_Runs(n->Delay[k], n->Period[k], now);
+            uint32_t releases = n->Runs[k];
+            SCH_Task_Misses_t m;
+            if (n->Period[k] > 0 &&
+                SCH_Get_Task_Misses_In(&fleet[i], n->Handle[k], &m) == RETURN_NORMAL) {
+                releases += m.Missed_Periods;
+            }
+            if (releases != expected) {
+                if (mismatches < 10) {
+                    fprintf(stderr, "instance %u task %u: %u releases, expected %u\n",
+                            i, k, releases, expected);
+                }
+                mismatches++;
+            }
+        }
+        // One-shot đã chạy xong (nếu đã tới hạn) và được xoá
+        uint32_t live = FLEET_TASKS - (n->Runs[3] > 0 ? 1u : 0u);
+        if (SCH_Get_Current_Size_In(&fleet[i]) != live) {
+            if (mismatches < 10) {
+                fprintf(stderr, "instance %u: %u tasks, expected %u\n",
+                        i, SCH_Get_Current_Size_In(&fleet[i]), live);
+            }
+            mismatches++;
+        }
+    }
+
+    if (header) {
+        printf("backend,instances,ticks,bytes_per_instance,ns_per_instance_tick,mismatches\n");
+    }
+    printf("%s,%u,%u,%zu,%.1f,%u\n", BACKEND_NAME, count, ticks, sizeof(SCH_Instance_t),
+           (double)elapsed / ((double)count * ticks), mismatches);
+
+    free(fleet);
+    free(nodes);
+    return mismatches ? 1 : 0;
+}
@@ -0,0 +1,165 @@
+/*
+ * ============================================================================
+ * SOAK TEST - ĐỘ TRÔI PHA CỦA TASK PERIODIC (HOST / LINUX)
+ * ============================================================================
+ * Mô tả: Chạy scheduler thật (Core/Src) qua nhiều ngày giả lập với tập task
+ *        giống ứng dụng, Dispatch thỉnh thoảng bị chặn (ngắt dài, ghi
+ *        flash, ...) → kiểm tra task 1 giây vẫn khớp đồng hồ thật
+ *
+ * BUILD & CHẠY (xem Makefile):
+ *   make soak                       → 7 ngày trên mảng sắp xếp, wheel và
+ *                                     cyclic, rồi cách re-arm cũ để so sánh
+ *   ./sch_soak_sorted --days 30 --seed 7
+ *
+ * TẬP TASK:
+ *   Button_Scan     P = 1 tick
+ *   Traffic_FSM     P = 1 tick
+ *   Update_Display  P = 5 tick
+ *   Second          P = 100 tick (1 s, như bộ đếm TIMER_CYCLE)
+ *
+ * NHIỄU: mỗi tick có xác suất 1/400 Dispatch bị chặn 1..60 tick, và
+ *        1/100000 bị chặn 1..3 giây (lỡ cả chu kỳ của task 1 giây)
+ *
+ * KẾT QUẢ (1 dòng / task):
+ *   releases = số lần phát hành đã xử lý (lần chạy + chu kỳ đã lỡ)
+ *   expected = số lần phát hành theo đồng hồ thật (tick / Period)
+ *   drift    = (expected - releases) x Period, tính bằng tick
+ *   phase_error = Phase_Error của SCH_Get_Task_Misses (cùng đại lượng,
+ *                 không làm tròn theo Period)
+ *
+ * TRẢ VỀ: 0 nếu không task nào trôi (SCH_REARM_FROM_RELEASE), 1 nếu có
+ *         (với SCH_REARM_FROM_RUN chỉ in kết quả, trôi là điều dự kiến),
+ *         2 nếu không thêm được task hoặc không đọc được thống kê của task
+ * ============================================================================
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "scheduler.h"
+
+/* ==================== CẤU HÌNH ==================== */
+
+#define SOAK_TASKS          4u
+#define TICKS_PER_DAY       (24u * 3600u * 1000u / TIMER_TICK_MS)
+
+/* ==================== BIẾN NỘI BỘ ==================== */
+
+typedef struct {
+    const char *Name;
+    void (*Fn)(void);
+    uint32_t Delay;
+    uint32_t Period;
+    SCH_Handle_t Handle;
+    uint32_t Runs;
+} Soak_Task_t;
+
+static void Sim_Button_Scan(void);
+static void Sim_Traffic_FSM(void);
+static void Sim_Update_Display(void);
+static void Sim_Second(void);
+
+static Soak_Task_t tasks[SOAK_TASKS] = {
+    { "Button_Scan",    Sim_Button_Scan,    0, 1,   0, 0 },
+    { "Traffic_FSM",    Sim_Traffic_FSM,    0, 1,   0, 0 },
+    { "Update_Display", Sim_Update_Display, 2, 5,   0, 0 },
+    { "Second",         Sim_Second,         0, 100, 0, 0 },
+};
+
+static uint32_t rng_state = 1;
+
+/* ==================== HÀM PRIVATE ==================== */
+
+static void Sim_Button_Scan(void)    { tasks[0].Runs++; }
+static void Sim_Traffic_FSM(void)    { tasks[1].Runs++; }
+static void Sim_Update_Display(void) { tasks[2].Runs++; }
+static void Sim_Second(void)         { tasks[3].Runs++; }
+
+static uint32_t rng(void) {
+    rng_state = rng_state * 1664525u + 1013904223u;
+    return rng_state >> 8;
+}
+
+/* ==================== MAIN ==================== */
+
+int main(int argc, char **argv) {
+    uint32_t days = 7;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--days") == 0 && i + 1 < argc) {
+            days = (uint32_t)strtoul(argv[++i], NULL, 0);
+        } else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            rng_state = (uint32_t)strtoul(argv[++i], NULL, 0);
+        } else {
+            fprintf(stderr, "usage: %s [--days N] [--seed S]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    uint64_t total = (uint64_t)days * TICKS_PER_DAY;
+    if (total == 0 || total > 0x7FFFFFFFu) {
+        fprintf(stderr, "sch_soak: --days must be 1..%u\n", 0x7FFFFFFFu / TICKS_PER_DAY);
+        return 2;
+    }
+    uint32_t ticks = (uint32_t)total;
+
+    SCH_Init();
+    for (uint32_t i = 0; i < SOAK_TASKS; i++) {
+        tasks[i].Handle = SCH_Add_Task(tasks[i].Fn, tasks[i].Delay, tasks[i].Period);
+        if (tasks[i].Handle == SCH_INVALID_HANDLE) {
+            fprintf(stderr, "sch_soak: cannot add %s (error %u)\n", tasks[i].Name, Error_code_G);
+            return 2;
+        }
+    }
+
+    // Tick giả lập: ngắt luôn đến đúng giờ, chỉ Dispatch bị chặn
+    uint32_t blocked = 0;
+    uint32_t stalls = 0;
+    for (uint32_t t = 0; t < ticks; t++) {
+        SCH_Update();
+        if (blocked > 0) {
+            blocked--;
+            continue;
+        }
+        if (rng() % 100000u == 0) {
+            blocked = (1u + rng() % 3u) * (1000u / TIMER_TICK_MS);
+            stalls++;
+        } else if (rng() % 400u == 0) {
+            blocked = 1u + rng() % 60u;
+            stalls++;
+        }
+        SCH_Dispatch_Tasks();
+    }
+    SCH_Dispatch_Tasks();       // Xử lý nốt các lần phát hành tới tick cuối
+
+    printf("%s, rearm from %s, %u days (%u ticks), %u stalls\n",
+           (SCH_BACKEND == SCH_BACKEND_TIMING_WHEEL) ? "timing wheel" :
+           (SCH_BACKEND == SCH_BACKEND_CYCLIC) ? "cyclic" : "sorted array",
+           (SCH_REARM == SCH_REARM_FROM_RELEASE) ? "release" : "run",
+           days, ticks, stalls);
+    printf("task,period,runs,late,missed,max_late,releases,expected,drift,phase_error\n");
+
+    int drifted = 0;
+    for (uint32_t i = 0; i < SOAK_TASKS; i++) {
+        Soak_Task_t *k = &tasks[i];
+        SCH_Task_Misses_t m = { 0 };
+        if (SCH_Get_Task_Misses(k->Handle, &m) != RETURN_NORMAL) {
+            fprintf(stderr, "sch_soak: %s has no miss counters\n", k->Name);
+            return 2;
+        }
+
+        uint32_t first = (k->Delay > 0) ? k->Delay : 1u;
+        uint32_t expected = (SCH_Get_Tick() - first) / k->Period + 1u;
+        uint32_t releases = k->Runs + m.Missed_Periods;
+        int64_t drift = ((int64_t)expected - releases) * k->Period;
+
+        printf("%s,%u,%u,%u,%u,%u,%u,%u,%lld,%u\n", k->Name, k->Period, k->Runs,
+               m.Late_Starts, m.Missed_Periods, m.Max_Lateness, releases, expected,
+               (long long)drift, m.Phase_Error);
+        if (drift != 0 || m.Phase_Error != 0) {
+            drifted = 1;
+        }
+    }
+
+    return (SCH_REARM == SCH_REARM_FROM_RELEASE) ? drifted : 0;
+}
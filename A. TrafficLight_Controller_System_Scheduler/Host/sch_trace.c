@@ -0,0 +1,317 @@
+/*
+ * ============================================================================
+ * SCHEDULER TRACE → CHROME TRACE JSON (HOST / LINUX)
+ * ============================================================================
+ * Mô tả: Chuyển vòng đệm trace của scheduler (SCH_trace_G, SCH_TRACE = 1)
+ *        thành JSON dạng Chrome trace, xem từng tick trên timeline bằng
+ *        chrome://tracing hoặc ui.perfetto.dev
+ *
+ * BUILD & CHẠY (xem Makefile):
+ *   make sch_trace
+ *
+ *   1. Bản dump từ board (dừng bằng debugger):
+ *        (gdb) dump binary value trace.bin SCH_trace_G
+ *        ./sch_trace trace.bin > trace.json
+ *
+ *   2. Giả lập trên máy tính (scheduler thật, 3 task giống ứng dụng,
+ *      tick 10ms thật, ngắt TIM2 giả lập):
+ *        ./sch_trace --sim 300 > trace.json
+ *
+ *   --names Button,FSM,Display : tên task theo slot (slot 0, 1, ...)
+ *        Mặc định "slot N". Với SCH_TASK_TABLE, dòng i = slot i.
+ *
+ * TIMELINE:
+ *   Luồng "ISR":      các ngắt (SCH_TRACE_ISR_ENTER/EXIT), mỗi tick là 1 mốc
+ *   Luồng "dispatch": SCH_Dispatch_Tasks, các task chạy lồng bên trong
+ *                     (args: RunMe lúc chạy)
+ *   Lỗi:              mốc toàn cục "error N" khi Error_code_G thay đổi
+ *
+ * LƯU Ý:
+ * - Bản dump là little endian (Cortex-M3 và x86 giống nhau)
+ * - Vòng đệm đã quay vòng → các sự kiện "kết thúc" đầu tiên có thể không
+ *   có "bắt đầu" tương ứng, chúng được bỏ qua
+ * ============================================================================
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "scheduler.h"
+
+/* ==================== CẤU HÌNH ==================== */
+
+#define TRACE_HEADER_BYTES  16u
+#define TRACE_RECORD_BYTES  8u
+#define MAX_NAMES           32u
+
+#define TID_ISR             1
+#define TID_DISPATCH        2
+
+/* ==================== BIẾN NỘI BỘ ==================== */
+
+static const char *slot_names[MAX_NAMES];
+static uint32_t slot_name_count = 0;
+
+static volatile uint32_t sink;
+
+/* ==================== HÀM PRIVATE ==================== */
+
+static uint32_t get_u32(const uint8_t *p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static uint16_t get_u16(const uint8_t *p) {
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+static void print_slot_name(uint32_t slot) {
+    if (slot & SCH_FAST_HANDLE_BIT) {
+        printf("fast %u", slot & ~SCH_FAST_HANDLE_BIT);     // Làn nhanh (SCH_FAST_LANE)
+    } else if (slot < slot_name_count) {
+        printf("%s", slot_names[slot]);
+    } else {
+        printf("slot %u", slot);
+    }
+}
+
+/**
+ * In 1 sự kiện Chrome trace (ph = B / E / i), ts tính bằng us
+ */
+static void emit(int *first, const char *ph, double ts, int tid) {
+    printf("%s\n{\"ph\":\"%s\",\"ts\":%.3f,\"pid\":1,\"tid\":%d", *first ? "" : ",", ph, ts, tid);
+    *first = 0;
+}
+
+/**
+ * Chuyển 1 bản dump (header + bản ghi) thành JSON trên stdout
+ * TRẢ VỀ: 0 nếu hợp lệ
+ */
+static int convert(const uint8_t *buf, size_t len) {
+    if (len < TRACE_HEADER_BYTES || get_u32(buf) != SCH_TRACE_MAGIC) {
+        fprintf(stderr, "sch_trace: not a scheduler trace (bad magic)\n");
+        return 1;
+    }
+
+    uint32_t clock_hz = get_u32(buf + 4);
+    uint32_t count = get_u32(buf + 8);
+    uint32_t size = get_u16(buf + 12);
+    uint32_t tick_ms = get_u16(buf + 14);
+
+    if (clock_hz == 0 || size == 0 || (size & (size - 1u)) != 0 ||
+        len < TRACE_HEADER_BYTES + (size_t)size * TRACE_RECORD_BYTES) {
+        fprintf(stderr, "sch_trace: bad header (clock %u Hz, %u records, %zu bytes)\n",
+                clock_hz, size, len);
+        return 1;
+    }
+
+    uint32_t n = (count < size) ? count : size;
+    uint32_t depth[3] = { 0, 0, 0 };
+    uint64_t time = 0;
+    uint32_t prev = 0;
+    int first = 1;
+
+    printf("{\"displayTimeUnit\":\"ns\",\"otherData\":{\"clock_hz\":%u,\"tick_ms\":%u,"
+           "\"records\":%u,\"lost\":%u},\"traceEvents\":[",
+           clock_hz, tick_ms, n, count - n);
+
+    emit(&first, "M", 0.0, TID_ISR);
+    printf(",\"name\":\"thread_name\",\"args\":{\"name\":\"ISR\"}}");
+    emit(&first, "M", 0.0, TID_DISPATCH);
+    printf(",\"name\":\"thread_name\",\"args\":{\"name\":\"dispatch\"}}");
+
+    for (uint32_t i = 0; i < n; i++) {
+        const uint8_t *r = buf + TRACE_HEADER_BYTES + (size_t)((count - n + i) & (size - 1u)) * TRACE_RECORD_BYTES;
+        uint32_t stamp = get_u32(r);
+        uint32_t data = get_u16(r + 4);
+        uint32_t event = r[6];
+        uint32_t value = r[7];
+
+        // Bộ đếm 32 bit tràn → cộng dồn hiệu (bản ghi theo thứ tự thời gian)
+        if (i > 0) time += (uint32_t)(stamp - prev);
+        prev = stamp;
+        double ts = (double)time * 1e6 / (double)clock_hz;
+
+        switch (event) {
+        case SCH_TRACE_TICK:
+            emit(&first, "i", ts, TID_ISR);
+            printf(",\"s\":\"t\",\"name\":\"tick %u\"}", data);
+            break;
+
+        case SCH_TRACE_ISR_BEGIN:
+        case SCH_TRACE_DISPATCH_BEGIN:
+        case SCH_TRACE_TASK_BEGIN: {
+            int tid = (event == SCH_TRACE_ISR_BEGIN) ? TID_ISR : TID_DISPATCH;
+            depth[tid]++;
+            emit(&first, "B", ts, tid);
+            if (event == SCH_TRACE_ISR_BEGIN) {
+                printf(",\"name\":\"IRQ %u\"}", data);
+            } else if (event == SCH_TRACE_DISPATCH_BEGIN) {
+                printf(",\"name\":\"dispatch\"}");
+            } else {
+                printf(",\"name\":\"");
+                print_slot_name(data);
+                printf("\",\"args\":{\"slot\":%u,\"RunMe\":%u}}", data, value);
+            }
+            break;
+        }
+
+        case SCH_TRACE_ISR_END:
+        case SCH_TRACE_DISPATCH_END:
+        case SCH_TRACE_TASK_END: {
+            int tid = (event == SCH_TRACE_ISR_END) ? TID_ISR : TID_DISPATCH;
+            if (depth[tid] == 0) break;         // "Bắt đầu" đã bị ghi đè
+            depth[tid]--;
+            emit(&first, "E", ts, tid);
+            printf("}");
+            break;
+        }
+
+        case SCH_TRACE_ERROR:
+            emit(&first, "i", ts, TID_DISPATCH);
+            printf(",\"s\":\"g\",\"name\":\"error %u\",\"args\":{\"Error_code_G\":%u}}", value, value);
+            break;
+
+        case SCH_TRACE_SHED:
+            emit(&first, "i", ts, TID_DISPATCH);
+            printf(",\"s\":\"g\",\"name\":\"shed level %u\",\"args\":{\"level\":%u}}", value, value);
+            break;
+
+        default:
+            // Đánh dấu của ứng dụng (SCH_Trace_Event, Event >= 16)
+            emit(&first, "i", ts, TID_DISPATCH);
+            printf(",\"s\":\"t\",\"name\":\"event %u\",\"args\":{\"data\":%u,\"value\":%u}}",
+                   event, data, value);
+            break;
+        }
+    }
+
+    printf("\n]}\n");
+    return 0;
+}
+
+static int convert_file(const char *path) {
+    FILE *f = fopen(path, "rb");
+    if (f == NULL) {
+        perror(path);
+        return 1;
+    }
+
+    uint8_t *buf = NULL;
+    size_t len = 0, cap = 0, got;
+    do {
+        if (len == cap) {
+            cap = cap ? cap * 2u : 65536u;
+            buf = realloc(buf, cap);
+            if (buf == NULL) {
+                fclose(f);
+                fprintf(stderr, "sch_trace: out of memory\n");
+                return 1;
+            }
+        }
+        got = fread(buf + len, 1, cap - len, f);
+        len += got;
+    } while (got > 0);
+    fclose(f);
+
+    int rc = convert(buf, len);
+    free(buf);
+    return rc;
+}
+
+/* ==================== GIẢ LẬP ==================== */
+
+static int64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+static void spin_us(uint32_t us) {
+    int64_t end = now_ns() + (int64_t)us * 1000;
+    while (now_ns() < end) {
+        sink++;
+    }
+}
+
+// Thời gian chạy gần giống task của ứng dụng
+static void Sim_Button_Scan(void)   { spin_us(20); }
+static void Sim_Traffic_FSM(void)   { spin_us(40); }
+static void Sim_Update_Display(void) { spin_us(300); }
+
+/**
+ * Chạy scheduler thật TICKS tick, mỗi tick 10ms thật: "ngắt" TIM2 gọi
+ * SCH_Update (có ISR_ENTER/EXIT), rồi main loop gọi SCH_Dispatch_Tasks
+ */
+static int simulate(uint32_t ticks) {
+    struct timespec next;
+
+    SCH_Init();
+    SCH_Add_Task(Sim_Button_Scan, 0, 1);
+    SCH_Add_Task(Sim_Traffic_FSM, 0, 1);
+    SCH_Add_Task(Sim_Update_Display, 0, 5);
+    if (slot_name_count == 0) {
+        static const char *names[] = { "Button_Scan", "Traffic_FSM", "Update_Display" };
+        memcpy(slot_names, names, sizeof(names));
+        slot_name_count = 3;
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &next);
+    for (uint32_t t = 0; t < ticks; t++) {
+        next.tv_nsec += TIMER_TICK_MS * 1000000L;
+        if (next.tv_nsec >= 1000000000L) {
+            next.tv_nsec -= 1000000000L;
+            next.tv_sec++;
+        }
+        clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &next, NULL);
+
+        SCH_TRACE_ISR_ENTER(28);            // TIM2_IRQn
+        SCH_Update();
+        SCH_TRACE_ISR_EXIT(28);
+        SCH_Dispatch_Tasks();
+    }
+
+    uint8_t *buf = malloc(sizeof(SCH_trace_G));
+    if (buf == NULL) return 1;
+    memcpy(buf, &SCH_trace_G, sizeof(SCH_trace_G));     // Giống dump từ debugger
+    int rc = convert(buf, sizeof(SCH_trace_G));
+    free(buf);
+    return rc;
+}
+
+/* ==================== MAIN ==================== */
+
+static void usage(const char *prog) {
+    fprintf(stderr, "usage: %s [--names A,B,..] (TRACE.bin | --sim TICKS) > trace.json\n", prog);
+}
+
+int main(int argc, char **argv) {
+    const char *path = NULL;
+    uint32_t sim_ticks = 0;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--sim") == 0 && i + 1 < argc) {
+            sim_ticks = (uint32_t)strtoul(argv[++i], NULL, 0);
+        } else if (strcmp(argv[i], "--names") == 0 && i + 1 < argc) {
+            char *name = strtok(argv[++i], ",");
+            while (name != NULL && slot_name_count < MAX_NAMES) {
+                slot_names[slot_name_count++] = name;
+                name = strtok(NULL, ",");
+            }
+        } else if (argv[i][0] != '-' && path == NULL) {
+            path = argv[i];
+        } else {
+            usage(argv[0]);
+            return 2;
+        }
+    }
+
+    if (sim_ticks > 0) {
+        return simulate(sim_ticks);
+    }
+    if (path == NULL) {
+        usage(argv[0]);
+        return 2;
+    }
+    return convert_file(path);
+}
@@ -0,0 +1,123 @@
+/*
+ * ============================================================================
+ * CPU UTILIZATION (HOST / LINUX)
+ * ============================================================================
+ * Mô tả: Chạy scheduler thật (Core/Src) trên máy tính với tập task giống
+ *        ứng dụng và in tải CPU (SCH_Get_Utilization) mỗi giây giả lập
+ *        - cùng phép đo như trên board, đơn vị thời gian là ns
+ *
+ * BUILD & CHẠY (xem Makefile):
+ *   make util                       → 90 giây giả lập, CSV ra stdout
+ *   ./sch_util --seconds 120 --extra-us 2000
+ *
+ * TẬP TASK (thời gian chạy giả lập bằng vòng chờ bận):
+ *   Button_Scan     P = 1 tick   20us
+ *   Traffic_FSM     P = 1 tick   40us
+ *   Update_Display  P = 5 tick  300us
+ *   Extra           P = 10 tick  --extra-us (mặc định 2000us), thêm vào
+ *                   ở giây thứ 30 → xem các cửa sổ 1s / 10s / 60s phản ứng
+ *
+ * KẾT QUẢ (CSV, 1 dòng / giây, tải tính bằng %):
+ *   second,load_1s,load_10s,load_60s,peak_tick
+ *   30,1.20,1.20,1.20,3.60
+ *
+ * TRẢ VỀ: 0, 2 nếu tham số sai hoặc không thêm được task (in tên task và
+ *         Error_code_G ra stderr)
+ *
+ * LƯU Ý:
+ * - Thời gian giả lập chỉ trôi theo tick (SCH_Update), không chờ 10ms thật:
+ *   thời gian thực của 1 tick là TIMER_TICK_MS theo định nghĩa, giống
+ *   cách SCH_Get_Utilization tính trên board
+ * - Đồng hồ của host là thời gian thực: task bị hệ điều hành tạm dừng
+ *   giữa chừng bị tính dài hơn → peak_tick trên host có thể vọt lên
+ *   (tới 100 %) dù tải trung bình đúng
+ * - Máy tính nhanh hơn STM32 nhiều: muốn ước lượng cho board, đặt thời
+ *   gian task bằng số đo SCH_Get_Task_Profile trên board
+ * ============================================================================
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "scheduler.h"
+
+/* ==================== BIẾN NỘI BỘ ==================== */
+
+static volatile uint32_t sink;
+static uint32_t extra_us = 2000;
+
+/* ==================== HÀM PRIVATE ==================== */
+
+static int64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+static void spin_us(uint32_t us) {
+    int64_t end = now_ns() + (int64_t)us * 1000;
+    while (now_ns() < end) {
+        sink++;
+    }
+}
+
+static void Sim_Button_Scan(void)   { spin_us(20); }
+static void Sim_Traffic_FSM(void)   { spin_us(40); }
+static void Sim_Update_Display(void) { spin_us(300); }
+static void Sim_Extra(void)         { spin_us(extra_us); }
+
+// Thêm task (Delay 0), báo lỗi nếu scheduler từ chối
+static int util_add(void (*TASK)(void), const char *NAME, uint32_t PERIOD) {
+    if (SCH_Add_Task(TASK, 0, PERIOD) == SCH_INVALID_HANDLE) {
+        fprintf(stderr, "sch_util: cannot add %s (error %u)\n", NAME, Error_code_G);
+        return 0;
+    }
+    return 1;
+}
+
+static void print_load(uint32_t second) {
+    SCH_Utilization_t u;
+    SCH_Get_Utilization(&u);
+    printf("%u,%.2f,%.2f,%.2f,%.2f\n", second, u.Load_1s / 100.0, u.Load_10s / 100.0,
+           u.Load_60s / 100.0, u.Peak_Tick / 100.0);
+    fflush(stdout);
+}
+
+/* ==================== MAIN ==================== */
+
+int main(int argc, char **argv) {
+    uint32_t seconds = 90;
+    uint32_t ticks_per_second = 1000u / TIMER_TICK_MS;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--seconds") == 0 && i + 1 < argc) {
+            seconds = (uint32_t)strtoul(argv[++i], NULL, 0);
+        } else if (strcmp(argv[i], "--extra-us") == 0 && i + 1 < argc) {
+            extra_us = (uint32_t)strtoul(argv[++i], NULL, 0);
+        } else {
+            fprintf(stderr, "usage: %s [--seconds N] [--extra-us US]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    SCH_Init();
+    if (!util_add(Sim_Button_Scan, "Button_Scan", 1) ||
+        !util_add(Sim_Traffic_FSM, "Traffic_FSM", 1) ||
+        !util_add(Sim_Update_Display, "Update_Display", 5)) {
+        return 2;
+    }
+
+    printf("second,load_1s,load_10s,load_60s,peak_tick\n");
+    for (uint32_t s = 1; s <= seconds; s++) {
+        if (s == 31 && !util_add(Sim_Extra, "Extra", 10)) {
+            return 2;
+        }
+        for (uint32_t t = 0; t < ticks_per_second; t++) {
+            SCH_Update();
+            SCH_Dispatch_Tasks();
+        }
+        print_load(s);
+    }
+    return 0;
+}
@@ -0,0 +1,18 @@
+/*
+ * stm32f1xx_hal.h (host stub)
+ * Core/Inc/main.h includes the HAL; on Linux this stub stands in for it,
+ * providing only what the scheduler sources use with SCH_HOST_SIM.
+ * (main.h itself is kept: scheduler.h includes it by a quoted path, which
+ * always resolves to Core/Inc first.)
+ */
+#ifndef __STM32F1xx_HAL_H
+#define __STM32F1xx_HAL_H
+
+#include <stdint.h>
+
+// CMSIS attribute used by SCH_Error_Hook
+#ifndef __weak
+#define __weak __attribute__((weak))
+#endif
+
+#endif /* __STM32F1xx_HAL_H */
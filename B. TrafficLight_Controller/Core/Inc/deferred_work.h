@@ -0,0 +1,105 @@
+/*
+ * deferred_work.h
+ * Deferred interrupt work queue ("bottom halves")
+ *
+ * An interrupt handler only records WHAT has to be done by posting a small
+ * work item (function + argument + priority) into a preallocated pool.
+ * The main loop drains the pool in thread context, highest priority first,
+ * FIFO inside one priority. The ISR stays short, so other interrupts are
+ * not delayed by FSM logic and GPIO writes.
+ */
+
+#ifndef INC_DEFERRED_WORK_H_
+#define INC_DEFERRED_WORK_H_
+
+#include "main.h"
+
+/* ==================================================================
+ * CONFIGURATION
+ * ================================================================== */
+
+// 1 = TIM2 callback only runs timerRun(), counts the tick and posts one
+//     work item (button scan + one FSM step per pending tick), drained by
+//     the main loop (default)
+// 0 = legacy: button scan and the whole FSM run inside the TIM2 interrupt
+//     (build once each way and compare deferred_stats.isr_max_cycles)
+#ifndef USE_DEFERRED_WORK
+#define USE_DEFERRED_WORK 1
+#endif
+
+// Number of work items in the pool (shared by all priorities).
+// The TIM2 tick keeps at most 1 item queued (late ticks are counted, not
+// queued), the rest is free for other interrupts.
+#ifndef DEFERRED_POOL_SIZE
+#define DEFERRED_POOL_SIZE 16
+#endif
+
+// Work priorities (lower value = drained first)
+enum DEFERRED_PRIORITY
+{
+    DEFERRED_PRIO_HIGH = 0,   // Input sampling, anything time-critical
+    DEFERRED_PRIO_NORMAL = 1, // State machine steps
+    DEFERRED_PRIO_LOW = 2,    // Display refresh, housekeeping
+    DEFERRED_PRIO_COUNT = 3
+};
+
+/* ==================================================================
+ * STATISTICS (read with the debugger, e.g. Live Expressions)
+ * ================================================================== */
+
+typedef struct
+{
+    uint32_t isr_count;           // Measured interrupts
+    uint32_t isr_last_cycles;     // CPU cycles of the last measured ISR
+    uint32_t isr_max_cycles;      // Worst ISR seen since deferred_init()
+    uint32_t posted;              // Work items accepted by deferred_post()
+    uint32_t executed;            // Work items run by deferred_run()
+    uint32_t dropped;             // deferred_post() calls refused (pool full)
+    uint32_t max_pending;         // Highest number of items queued at once
+    uint32_t max_latency_cycles;  // Worst post-to-start delay of an item
+} deferred_stats_t;
+
+extern deferred_stats_t deferred_stats;
+
+/* ==================================================================
+ * FUNCTION PROTOTYPES
+ * ================================================================== */
+
+/**
+ * @brief Empty the pool, reset statistics and start the DWT cycle counter
+ * @note Call once in main() before starting any interrupt that posts work
+ */
+void deferred_init(void);
+
+/**
+ * @brief Queue a work item to run later in thread context
+ * @param work: Function to run
+ * @param arg: Argument passed to work (may be NULL)
+ * @param priority: DEFERRED_PRIO_HIGH / NORMAL / LOW
+ * @retval 1 if queued, 0 if the pool is full or the arguments are invalid
+ * @note Safe to call from any interrupt and from the main loop
+ */
+int deferred_post(void (*work)(void *arg), void *arg, int priority);
+
+/**
+ * @brief Run all queued work items, highest priority first
+ * @retval Number of items executed
+ * @note Call from the main loop only (never from an ISR).
+ *       Items posted while draining are executed in the same call.
+ */
+int deferred_run(void);
+
+/**
+ * @brief Number of work items currently queued
+ */
+int deferred_pending(void);
+
+/**
+ * @brief Mark the start / end of an interrupt handler to measure its time
+ * @note Place deferred_isr_enter() first and deferred_isr_exit() last in the
+ *       IRQ handler (USER CODE sections of stm32f1xx_it.c)
+ */
+void deferred_isr_enter(void);
+void deferred_isr_exit(void);
+
+#endif /* INC_DEFERRED_WORK_H_ */
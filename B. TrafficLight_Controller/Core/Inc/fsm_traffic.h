@@ -24,9 +24,11 @@
 void traffic_init(void);
 
 /**
- * @brief Main FSM function - called in timer interrupt (every 10ms)
+ * @brief Main FSM function - called once per timer tick (every 10ms)
  * @details Process logic based on current mode and update displays
- * @note Frequency: 100Hz (100 times/second)
+ * @note Frequency: 100Hz (100 times/second). Posted by the TIM2 interrupt
+ *       and run from the main loop when USE_DEFERRED_WORK = 1 (one call
+ *       per tick, late ticks are caught up in order)
  */
 void traffic_run(void);
 
@@ -9,7 +9,9 @@
  * 3. LONG PRESS: Detects a press held longer than 1 second.
  *
  * TIMING:
- * - getKeyInput() is called every 10ms in the timer interrupt.
+ * - getKeyInput() is called once per 10ms timer tick (posted by the
+ *   TIM2 interrupt, run from the main loop - see deferred_work.h);
+ *   after a main loop stall, once for all the late ticks.
  * - Debounce time  = 3 × 10ms = 30ms
  * - Long press     = 100 × 10ms = 1000ms (1 second)
  * ================================================================== */
@@ -118,7 +120,9 @@ void subKeyProcess(int index)
  * MAIN BUTTON PROCESSING FUNCTION
  * ==================================================================
  *
- * getKeyInput() should be called every 10ms in the timer interrupt.
+ * getKeyInput() should be called once per 10ms timer tick (tick_work in
+ * main.c; once for all late ticks after a main loop stall, so the three
+ * debounce reads are always real samples).
  * Steps:
  * 1. Debounce input by checking three consecutive stable reads.
  * 2. Detect short press when state changes to PRESSED.
@@ -0,0 +1,221 @@
+/*
+ * deferred_work.c
+ * Deferred interrupt work queue ("bottom halves")
+ *
+ * POOL LAYOUT:
+ * - work_pool[]: DEFERRED_POOL_SIZE preallocated items, no malloc
+ * - free_head:   singly linked list of unused items
+ * - queue_head/queue_tail[priority]: one FIFO per priority
+ *
+ * All list updates are done with interrupts masked (PRIMASK saved and
+ * restored), so deferred_post() works from any ISR, including an ISR that
+ * interrupts deferred_run(). The work function itself always runs with
+ * interrupts enabled.
+ *
+ * TIMING: DWT->CYCCNT (1 count = 1 CPU cycle, 8MHz HSI → 125ns)
+ */
+
+#include "deferred_work.h"
+
+#define NO_ITEM 0xFF // End of list marker (pool index)
+
+#if DEFERRED_POOL_SIZE > 255
+#error "DEFERRED_POOL_SIZE must fit in a uint8_t index"
+#endif
+
+typedef struct
+{
+    void (*work)(void *arg); // Function to run
+    void *arg;               // Its argument
+    uint32_t posted_at;      // DWT->CYCCNT when posted (latency statistics)
+    uint8_t next;            // Next item in the free list or priority FIFO
+} deferred_item_t;
+
+/* ==================================================================
+ * GLOBAL VARIABLES
+ * ================================================================== */
+
+deferred_stats_t deferred_stats;
+
+static deferred_item_t work_pool[DEFERRED_POOL_SIZE];
+static uint8_t free_head;
+static uint8_t queue_head[DEFERRED_PRIO_COUNT];
+static uint8_t queue_tail[DEFERRED_PRIO_COUNT];
+static int pending_count;
+
+static uint32_t isr_start; // DWT->CYCCNT at deferred_isr_enter()
+
+/* ==================================================================
+ * INITIALIZATION
+ * ================================================================== */
+
+void deferred_init(void)
+{
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+
+    // Chain every item into the free list
+    for (int i = 0; i < DEFERRED_POOL_SIZE; i++)
+    {
+        work_pool[i].next = (i + 1 < DEFERRED_POOL_SIZE) ? (uint8_t)(i + 1) : NO_ITEM;
+    }
+    free_head = 0;
+
+    for (int p = 0; p < DEFERRED_PRIO_COUNT; p++)
+    {
+        queue_head[p] = NO_ITEM;
+        queue_tail[p] = NO_ITEM;
+    }
+    pending_count = 0;
+
+    deferred_stats = (deferred_stats_t){0};
+
+    // Enable the cycle counter (off after reset unless a debugger is attached)
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+    __set_PRIMASK(primask);
+}
+
+/* ==================================================================
+ * POST (ISR OR MAIN LOOP)
+ * ================================================================== */
+
+/**
+ * deferred_post() - Take a free item and append it to its priority FIFO
+ *
+ * Cost: a few dozen cycles with interrupts masked, independent of the
+ * number of queued items.
+ */
+int deferred_post(void (*work)(void *arg), void *arg, int priority)
+{
+    if (work == NULL || priority < 0 || priority >= DEFERRED_PRIO_COUNT)
+    {
+        return 0;
+    }
+
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+
+    uint8_t idx = free_head;
+    if (idx == NO_ITEM)
+    {
+        deferred_stats.dropped++;
+        __set_PRIMASK(primask);
+        return 0;
+    }
+    free_head = work_pool[idx].next;
+
+    work_pool[idx].work = work;
+    work_pool[idx].arg = arg;
+    work_pool[idx].posted_at = DWT->CYCCNT;
+    work_pool[idx].next = NO_ITEM;
+
+    // Append to the tail: items of one priority keep their posting order
+    if (queue_tail[priority] == NO_ITEM)
+    {
+        queue_head[priority] = idx;
+    }
+    else
+    {
+        work_pool[queue_tail[priority]].next = idx;
+    }
+    queue_tail[priority] = idx;
+
+    pending_count++;
+    deferred_stats.posted++;
+    if ((uint32_t)pending_count > deferred_stats.max_pending)
+    {
+        deferred_stats.max_pending = pending_count;
+    }
+
+    __set_PRIMASK(primask);
+    return 1;
+}
+
+/* ==================================================================
+ * DRAIN (MAIN LOOP ONLY)
+ * ================================================================== */
+
+/**
+ * deferred_run() - Execute queued items until the pool is empty
+ *
+ * The highest non-empty priority is searched again before every item, so a
+ * HIGH item posted by an ISR while a LOW item runs is executed next.
+ */
+int deferred_run(void)
+{
+    int executed = 0;
+
+    while (1)
+    {
+        uint32_t primask = __get_PRIMASK();
+        __disable_irq();
+
+        int p = 0;
+        while (p < DEFERRED_PRIO_COUNT && queue_head[p] == NO_ITEM)
+        {
+            p++;
+        }
+        if (p == DEFERRED_PRIO_COUNT)
+        {
+            __set_PRIMASK(primask);
+            break;
+        }
+
+        // Unlink the head item and copy it out, then free the slot at once:
+        // the work function may post again (even into the same slot)
+        uint8_t idx = queue_head[p];
+        deferred_item_t item = work_pool[idx];
+
+        queue_head[p] = item.next;
+        if (queue_head[p] == NO_ITEM)
+        {
+            queue_tail[p] = NO_ITEM;
+        }
+        work_pool[idx].next = free_head;
+        free_head = idx;
+        pending_count--;
+
+        uint32_t latency = DWT->CYCCNT - item.posted_at;
+        if (latency > deferred_stats.max_latency_cycles)
+        {
+            deferred_stats.max_latency_cycles = latency;
+        }
+        deferred_stats.executed++;
+
+        __set_PRIMASK(primask);
+
+        item.work(item.arg);
+        executed++;
+    }
+
+    return executed;
+}
+
+int deferred_pending(void)
+{
+    return pending_count;
+}
+
+/* ==================================================================
+ * ISR TIME MEASUREMENT
+ * ================================================================== */
+
+void deferred_isr_enter(void)
+{
+    isr_start = DWT->CYCCNT;
+}
+
+void deferred_isr_exit(void)
+{
+    uint32_t cycles = DWT->CYCCNT - isr_start;
+
+    deferred_stats.isr_count++;
+    deferred_stats.isr_last_cycles = cycles;
+    if (cycles > deferred_stats.isr_max_cycles)
+    {
+        deferred_stats.isr_max_cycles = cycles;
+    }
+}
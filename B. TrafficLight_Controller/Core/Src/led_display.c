@@ -198,7 +198,7 @@ void displayLED_GREEN(int IS_ON, int index)
  *                  2 = GREEN (Mode 4)
  *
  * Mechanism:
- * - Called every 10ms from timer interrupt
+ * - Called every 10ms from traffic_run() (one FSM step per timer tick)
  * - After 50 calls (500ms) → toggle LED state
  * - Cycle: 500ms ON + 500ms OFF = 1 second (1Hz)
  * - Only the LED being adjusted blinks, others are OFF
@@ -43,6 +43,7 @@
 #include "software_timer.h"    // Thư viện timer phần mềm (đếm thời gian)
 #include "button.h"            // Thư viện xử lý nút nhấn
 #include "fsm_traffic.h"       // Thư viện FSM (Finite State Machine) điều khiển đèn giao thông
+#include "deferred_work.h"     // Hàng đợi công việc hoãn từ ngắt (bottom halves)
 /* USER CODE END Includes */
 
 /* Private typedef -----------------------------------------------------------*/
@@ -71,6 +72,45 @@ static void MX_TIM2_Init(void);      // Hàm khởi tạo Timer 2
 /* USER CODE BEGIN PFP */
 /* USER CODE END PFP */
 
+#if USE_DEFERRED_WORK
+// Số tick TIM2 chưa được xử lý (ngắt tăng, tick_work lấy hết)
+static volatile uint32_t ticks_pending = 0;
+// tick_work đang nằm trong hàng đợi → ngắt không gửi thêm
+static volatile uint8_t tick_posted = 0;
+
+/**
+  * @brief  Công việc được hoãn từ ngắt TIM2 (chạy trong vòng lặp chính)
+  * @param  arg: Không dùng
+  * @retval None
+  *
+  * Giải thích:
+  * - Lấy hết số tick đang chờ (tắt ngắt trong lúc đọc + xóa)
+  * - Quét nút 1 lần: các lần đọc GPIO phải cách nhau thật sự 1 tick, đọc
+  *   bù N lần liền nhau sau khi vòng lặp chính bị chặn chỉ là N lần đọc
+  *   giống hệt → chống dội 3 lần đọc mất tác dụng
+  * - Chạy FSM đúng 1 bước cho mỗi tick (traffic_run đếm số lần gọi để
+  *   ra giây) → không mất tick, đèn không bị trôi
+  */
+static void tick_work(void *arg)
+{
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    uint32_t ticks = ticks_pending;
+    ticks_pending = 0;
+    tick_posted = 0;
+    __set_PRIMASK(primask);
+
+    if (ticks == 0) {
+        return;
+    }
+
+    getKeyInput();
+    while (ticks-- > 0) {
+        traffic_run();
+    }
+}
+#endif
+
 /**
   * @brief  Timer interrupt callback - Hàm ngắt Timer
   * @param  htim: Timer handle (con trỏ tới timer đang xử lý)
@@ -80,6 +120,10 @@ static void MX_TIM2_Init(void);      // Hàm khởi tạo Timer 2
   * - Hàm này được gọi TỰ ĐỘNG mỗi khi Timer 2 tràn (overflow)
   * - Thời gian gọi phụ thuộc vào cấu hình Timer (thường là 10ms)
   * - Đây là "tim đập" của hệ thống - mọi xử lý theo thời gian đều dựa vào đây
+  * - USE_DEFERRED_WORK = 1: trong ngắt chỉ đếm timer, đếm tick đang chờ
+  *   và gửi tick_work vào hàng đợi (deferred_post) nếu nó chưa nằm sẵn
+  *   trong đó; phần nặng chạy ở vòng lặp chính (deferred_run)
+  *   → ngắt ngắn, không chặn các ngắt khác
   */
 void HAL_TIM_PeriodElapsedCallback(TIM_HandleTypeDef *htim)
 {
@@ -91,6 +135,16 @@ void HAL_TIM_PeriodElapsedCallback(TIM_HandleTypeDef *htim)
         //    - Kiểm tra timer nào hết thời gian
         timerRun();
 
+#if USE_DEFERRED_WORK
+        // 2. Đếm tick, gửi tick_work (quét nút + bước FSM) nếu chưa gửi
+        //    - Hàng đợi giữ tối đa 1 tick_work, tick bị trễ nằm ở
+        //      ticks_pending → vòng lặp chính bị chặn không làm mất tick
+        //    - Pool đầy → gửi lại ở tick sau (deferred_stats.dropped)
+        ticks_pending++;
+        if (!tick_posted && deferred_post(tick_work, NULL, DEFERRED_PRIO_HIGH)) {
+            tick_posted = 1;
+        }
+#else
         // 2. Đọc trạng thái các nút nhấn
         //    - Quét trạng thái nút (nhấn/thả)
         //    - Xử lý chống dội phím (debounce)
@@ -102,6 +156,7 @@ void HAL_TIM_PeriodElapsedCallback(TIM_HandleTypeDef *htim)
         //    - Cập nhật LED 7 đoạn
         //    - Xử lý các mode (normal, adjust red, adjust yellow, adjust green)
         traffic_run();
+#endif
     }
 }
 
@@ -138,6 +193,8 @@ int main(void)
 
   // Khởi tạo hệ thống đèn giao thông
   traffic_init();
+  // Khởi tạo hàng đợi công việc hoãn (phải trước khi bật ngắt)
+  deferred_init();
   // Bật Timer interrupt
   HAL_TIM_Base_Start_IT(&htim2);
 
@@ -150,7 +207,10 @@ int main(void)
     /* USER CODE END WHILE */
 
     /* USER CODE BEGIN 3 */
-
+#if USE_DEFERRED_WORK
+    // Chạy các công việc ngắt đã gửi: quét nút, rồi 1 bước FSM mỗi tick
+    deferred_run();
+#endif
   }
   /* USER CODE END 3 */
 }
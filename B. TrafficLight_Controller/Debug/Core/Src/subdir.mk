@@ -7,6 +7,7 @@
 C_SRCS += \
 ../Core/Src/7segment_display.c \
 ../Core/Src/button.c \
+../Core/Src/deferred_work.c \
 ../Core/Src/fsm_traffic.c \
 ../Core/Src/global.c \
 ../Core/Src/led_display.c \
@@ -22,6 +23,7 @@ C_SRCS += \
 OBJS += \
 ./Core/Src/7segment_display.o \
 ./Core/Src/button.o \
+./Core/Src/deferred_work.o \
 ./Core/Src/fsm_traffic.o \
 ./Core/Src/global.o \
 ./Core/Src/led_display.o \
@@ -37,6 +39,7 @@ OBJS += \
 C_DEPS += \
 ./Core/Src/7segment_display.d \
 ./Core/Src/button.d \
+./Core/Src/deferred_work.d \
 ./Core/Src/fsm_traffic.d \
 ./Core/Src/global.d \
 ./Core/Src/led_display.d \